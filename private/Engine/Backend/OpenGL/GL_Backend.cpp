@@ -1,4 +1,6 @@
 #include <cstdio>
+#include <cstring>
+#include <mutex>
 
 #include <Engine/GLHeader.hpp>
 
@@ -12,22 +14,103 @@
 
 namespace engine::backend::ogl {
     static runtime::Logger g_LoggerGLBackend("GLBackend");
-    
+
+#ifdef GL_WITH_LOADER
+    // glad's function pointers are process-wide. backends on other threads share them, so only the first
+    // one loads them and only the last one unloads them.
+    static std::mutex g_LoaderMutex;
+    static int g_LoaderReferences = 0;
+    static int g_LoaderVersion = 0;
+
+    static int GL_AcquireLoader() {
+        std::lock_guard lock(g_LoaderMutex);
+
+        if (g_LoaderReferences == 0) {
+            g_LoaderVersion = gladLoaderLoadGL();
+
+            if (g_LoaderVersion == 0) {
+                return 0;
+            }
+        }
+
+        g_LoaderReferences++;
+        return g_LoaderVersion;
+    }
+
+    static void GL_ReleaseLoader() {
+        std::lock_guard lock(g_LoaderMutex);
+
+        if (g_LoaderReferences > 0 && --g_LoaderReferences == 0) {
+            gladLoaderUnloadGL();
+            g_LoaderVersion = 0;
+        }
+    }
+#endif
+
     bool GLBackend::Initialize() {
+        m_StateCache.Invalidate();
+
 #ifdef GL_WITH_LOADER
-        auto version = gladLoaderLoadGL();
+        auto version = GL_AcquireLoader();
         g_LoggerGLBackend.Log(runtime::LOG_LEVEL_INFO, "Initialized backend instance of OpenGL %d.%d", GLAD_VERSION_MAJOR(version),
                GLAD_VERSION_MINOR(version));
 
-        return version != 0;
-#else
-        return true;
+        if (version == 0) {
+            return false;
+        }
+
+        m_LoaderAcquired = true;
 #endif
+
+        m_Capabilities.Detect();
+        SetShaderCompilerThreads(0xFFFFFFFF);
+
+        m_ProgramBinaryCache.Initialize();
+
+        return true;
     }
 
     void GLBackend::Shutdown() {
+        // completions of dropped jobs release what the workers created, so this goes first
+        m_WorkerPool.Destroy();
+
+        // handed-over objects are destroyed here, while the subsystems they cancel their work with still exist
+        m_DeletionQueue.Destroy();
+
+        if (m_Profiler) {
+            m_Profiler->Destroy();
+            m_Profiler.reset();
+        }
+
+        if (m_Readback) {
+            m_Readback->Destroy();
+            m_Readback.reset();
+        }
+
+        m_SamplerCache.Destroy();
+
+        if (m_TextureStreamer) {
+            m_TextureStreamer->Destroy();
+            m_TextureStreamer.reset();
+        }
+
+        if (m_VertexStream) {
+            m_VertexStream->Destroy();
+            m_VertexStream.reset();
+        }
+
+        if (m_UniformStream) {
+            m_UniformStream->Destroy();
+            m_UniformStream.reset();
+        }
+
+        m_ResourcePool.Destroy();
+
 #ifdef GL_WITH_LOADER
-        gladLoaderUnloadGL();
+        if (m_LoaderAcquired) {
+            GL_ReleaseLoader();
+            m_LoaderAcquired = false;
+        }
 #endif
     }
 
@@ -40,53 +123,230 @@ namespace engine::backend::ogl {
     }
 
     void GLBackend::SetViewport(core::math::Vector2 pos, core::math::Vector2 size) {
-        glViewport(static_cast<GLint>(pos.x),
-                   static_cast<GLint>(pos.y),
-                   static_cast<GLsizei>(size.x),
-                   static_cast<GLsizei>(size.y));
+        m_StateCache.SetViewport(static_cast<GLint>(pos.x),
+                                 static_cast<GLint>(pos.y),
+                                 static_cast<GLsizei>(size.x),
+                                 static_cast<GLsizei>(size.y));
     }
 
     void GLBackend::SetScissor(core::math::Vector2 start, core::math::Vector2 size) {
-        GLint viewport[4]; // x, y, width, height
-        glGetIntegerv(GL_VIEWPORT, viewport);
+        // in OpenGL Y axis is inverted, so we need the current viewport to apply stuff.
+        // the cache only asks GL for it while it does not know the viewport
+        auto viewportHeight = m_StateCache.GetViewport()[3];
 
-        // in OpenGL Y axis is inverted, so we need to read the current viewport to apply stuff
-        glScissor(static_cast<GLint>(start.x),
-                  viewport[3] - static_cast<GLint>(start.y + size.y),
-                  static_cast<GLsizei>(size.x),
-                  static_cast<GLsizei>(size.y));
+        m_StateCache.SetScissor(static_cast<GLint>(start.x),
+                                viewportHeight - static_cast<GLint>(start.y + size.y),
+                                static_cast<GLsizei>(size.x),
+                                static_cast<GLsizei>(size.y));
     }
 
     void GLBackend::Clear(core::runtime::graphics::Color color) {
-        glClearColor(color.r, color.g, color.b, color.a);
+        m_StateCache.SetClearColor(color.r, color.g, color.b, color.a);
         glClear(GL_COLOR_BUFFER_BIT);
     }
 
+    void GLBackend::SetShaderCompilerThreads(unsigned int count) {
+        if (!m_Capabilities.parallelShaderCompile) {
+            return;
+        }
+
+        if (m_Capabilities.HasExtension("GL_KHR_parallel_shader_compile")) {
+            glMaxShaderCompilerThreadsKHR(count);
+        } else {
+            glMaxShaderCompilerThreadsARB(count);
+        }
+    }
+
+    void GLBackend::ExecuteCommandLists(std::span<const GLCommandList *const> lists) {
+        for (auto list: lists) {
+            list->Execute(*this);
+        }
+    }
+
+    void GLBackend::EndFrame() {
+        if (m_TextureStreamer) {
+            m_TextureStreamer->Update();
+        }
+
+        if (m_Readback) {
+            m_Readback->Poll();
+        }
+
+        m_WorkerPool.Poll();
+        m_DeletionQueue.Flush();
+        m_ResourcePool.Update();
+
+        if (m_Profiler) {
+            m_Profiler->EndFrame(m_FrameIndex, m_FrameStats);
+        }
+
+        m_LastFrameStats = m_FrameStats;
+        m_FrameStats = {};
+        m_FrameIndex++;
+    }
+
+    GLStreamBuffer &GLBackend::GetVertexStream() {
+        if (!m_VertexStream) {
+            // 4 MiB per frame covers UI and debug geometry comfortably; larger uploads use regular buffers
+            m_VertexStream = std::make_unique<GLStreamBuffer>(this, GL_ARRAY_BUFFER, 4 * 1024 * 1024);
+            m_VertexStream->Create();
+        }
+
+        return *m_VertexStream;
+    }
+
+    GLStreamBuffer &GLBackend::GetUniformStream() {
+        if (!m_UniformStream) {
+            // camera / light blocks plus a few thousand 256-byte per-object blocks per frame
+            m_UniformStream = std::make_unique<GLStreamBuffer>(this, GL_UNIFORM_BUFFER, 2 * 1024 * 1024);
+            m_UniformStream->Create();
+        }
+
+        return *m_UniformStream;
+    }
+
+    GLStreamAllocation GLBackend::AllocateUniforms(size_t size) {
+        if (m_Capabilities.maxUniformBlockSize > 0 && size > static_cast<size_t>(m_Capabilities.maxUniformBlockSize)) {
+            g_LoggerGLBackend.Log(runtime::LOG_LEVEL_ERROR, "Uniform block of %zu bytes exceeds the limit of %d bytes!",
+                                  size, m_Capabilities.maxUniformBlockSize);
+            return {};
+        }
+
+        return GetUniformStream().Allocate(size, static_cast<size_t>(m_Capabilities.uniformBufferOffsetAlignment));
+    }
+
+    void GLBackend::BindUniformRange(unsigned int binding, const GLStreamAllocation &allocation) {
+        if (!allocation.IsValid()) {
+            return;
+        }
+
+        auto &stream = GetUniformStream();
+        stream.Commit(allocation);
+        m_StateCache.BindUniformBufferRange(binding, stream.GetHandle(), allocation.offset, allocation.size);
+    }
+
+    bool GLBackend::BindUniformData(unsigned int binding, const void *data, size_t size) {
+        auto allocation = AllocateUniforms(size);
+
+        if (!allocation.IsValid()) {
+            return false;
+        }
+
+        std::memcpy(allocation.data, data, size);
+        BindUniformRange(binding, allocation);
+        return true;
+    }
+
+    unsigned int GLBackend::GetUniformBlockBinding(std::string_view name) {
+        std::lock_guard lock(m_UniformBlockMutex);
+
+        auto it = m_UniformBlockBindings.find(name);
+
+        if (it != m_UniformBlockBindings.end()) {
+            return static_cast<unsigned int>(it->second);
+        }
+
+        auto binding = static_cast<int>(GetFirstNamedUniformBlockBinding() + m_UniformBlockBindings.size());
+
+        // every GL 3.1 / GLES 3.0 context has at least 24 bindings
+        auto limit = m_Capabilities.maxUniformBufferBindings > 0 ? m_Capabilities.maxUniformBufferBindings : 24;
+
+        if (binding >= limit) {
+            g_LoggerGLBackend.Log(runtime::LOG_LEVEL_WARNING, "Ran out of uniform buffer bindings; block '%.*s' shares binding %d.",
+                                  static_cast<int>(name.size()), name.data(), limit - 1);
+            binding = limit - 1;
+        }
+
+        m_UniformBlockBindings.emplace(std::string(name), binding);
+        return static_cast<unsigned int>(binding);
+    }
+
+    bool GLBackend::FindUniformBlockBinding(std::string_view name, unsigned int &binding) {
+        std::lock_guard lock(m_UniformBlockMutex);
+
+        auto it = m_UniformBlockBindings.find(name);
+
+        if (it == m_UniformBlockBindings.end()) {
+            return false;
+        }
+
+        binding = static_cast<unsigned int>(it->second);
+        return true;
+    }
+
+    unsigned int GLBackend::GetFirstNamedUniformBlockBinding() const {
+        // the upper half, so blocks bound by name never collide with explicit bindings counted from 0
+        auto limit = m_Capabilities.maxUniformBufferBindings > 0 ? m_Capabilities.maxUniformBufferBindings : 24;
+        return static_cast<unsigned int>(limit / 2);
+    }
+
+    GLReadback &GLBackend::GetReadback() {
+        if (!m_Readback) {
+            m_Readback = std::make_unique<GLReadback>(this);
+        }
+
+        return *m_Readback;
+    }
+
+    GLTextureStreamer &GLBackend::GetTextureStreamer() {
+        if (!m_TextureStreamer) {
+            // a couple of workers is enough to keep decoding ahead of the per-frame upload budget
+            m_TextureStreamer = std::make_unique<GLTextureStreamer>(this);
+            m_TextureStreamer->Create();
+        }
+
+        return *m_TextureStreamer;
+    }
+
+    GLProfiler &GLBackend::GetProfiler() {
+        if (!m_Profiler) {
+            m_Profiler = std::make_unique<GLProfiler>(this);
+        }
+
+        return *m_Profiler;
+    }
+
     std::unique_ptr<core::runtime::graphics::IVertexBuffer> GLBackend::CreateVertexBuffer() {
-        return std::make_unique<ogl::GLVertexBuffer>();
+        return std::make_unique<ogl::GLVertexBuffer>(this);
     }
 
     std::unique_ptr<core::runtime::graphics::IShader> GLBackend::CreateShader() {
-        return std::make_unique<ogl::GLShader>();
+        return std::make_unique<ogl::GLShader>(this);
     }
 
     std::unique_ptr<core::runtime::graphics::IShaderProgram> GLBackend::CreateShaderProgram() {
-        return std::make_unique<ogl::GLShaderProgram>();
+        return std::make_unique<ogl::GLShaderProgram>(this);
     }
 
     std::unique_ptr<core::runtime::graphics::ITexture> GLBackend::CreateTexture() {
-        return std::make_unique<ogl::GLTexture>();
+        return std::make_unique<ogl::GLTexture>(this);
+    }
+
+    std::unique_ptr<GLBatchRenderer> GLBackend::CreateBatchRenderer(size_t verticesPerArena) {
+        return std::make_unique<GLBatchRenderer>(this, verticesPerArena);
+    }
+
+    std::unique_ptr<GLSpriteBatcher> GLBackend::CreateSpriteBatcher(int layersPerArray) {
+        return std::make_unique<GLSpriteBatcher>(this, layersPerArray);
+    }
+
+    std::unique_ptr<GLTextureAtlas> GLBackend::CreateTextureAtlas(int pageSize) {
+        return std::make_unique<GLTextureAtlas>(this, pageSize);
+    }
+
+    std::unique_ptr<GLRenderQueue> GLBackend::CreateRenderQueue() {
+        return std::make_unique<GLRenderQueue>(this);
     }
 
     void GLBackend::EnableFeatures(core::runtime::graphics::BackendFeature featuresMask) {
         if (featuresMask & core::runtime::graphics::BACKEND_FEATURE_SCISSOR_TEST) {
-            glEnable(GL_SCISSOR_TEST);
+            m_StateCache.SetCapability(GL_SCISSOR_TEST, true);
         }
 
         if (featuresMask & core::runtime::graphics::BACKEND_FEATURE_ALPHA_BLENDING) {
-            glEnable(GL_BLEND);
-            glBlendEquation(GL_FUNC_ADD);
-            glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+            m_StateCache.SetCapability(GL_BLEND, true);
+            m_StateCache.SetBlendEquation(GL_FUNC_ADD);
+            m_StateCache.SetBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
         }
 
         m_ActiveFeatures |= featuresMask;
@@ -94,11 +354,11 @@ namespace engine::backend::ogl {
 
     void GLBackend::DisableFeatures(core::runtime::graphics::BackendFeature featuresMask) {
         if (featuresMask & core::runtime::graphics::BACKEND_FEATURE_SCISSOR_TEST) {
-            glDisable(GL_SCISSOR_TEST);
+            m_StateCache.SetCapability(GL_SCISSOR_TEST, false);
         }
 
         if (featuresMask & core::runtime::graphics::BACKEND_FEATURE_ALPHA_BLENDING) {
-            glDisable(GL_BLEND);
+            m_StateCache.SetCapability(GL_BLEND, false);
         }
 
         m_ActiveFeatures &= ~featuresMask;
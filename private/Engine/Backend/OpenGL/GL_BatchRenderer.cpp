@@ -0,0 +1,244 @@
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+#include <Engine/GLHeader.hpp>
+
+#include <Engine/Backend/OpenGL/GL_Backend.hpp>
+#include <Engine/Backend/OpenGL/GL_BatchRenderer.hpp>
+#include <Engine/Backend/OpenGL/GL_EnumMapping.hpp>
+#include <Engine/Backend/OpenGL/GL_VertexLayout.hpp>
+
+#include <Engine/Runtime/Logger.hpp>
+
+namespace engine::backend::ogl {
+    static runtime::Logger g_LoggerGLBatchRenderer("GLBatchRenderer");
+
+    static constexpr core::runtime::graphics::PrimitiveType GL_BatchPrimitiveTypes[] = {
+            core::runtime::graphics::PrimitiveType::PRIMITIVE_TYPE_TRIANGLES,
+            core::runtime::graphics::PrimitiveType::PRIMITIVE_TYPE_LINES,
+            core::runtime::graphics::PrimitiveType::PRIMITIVE_TYPE_POINTS
+    };
+
+    static size_t GL_GetBatchQueueIndex(core::runtime::graphics::PrimitiveType type) {
+        switch (type) {
+            case core::runtime::graphics::PrimitiveType::PRIMITIVE_TYPE_LINES:
+                return 1;
+            case core::runtime::graphics::PrimitiveType::PRIMITIVE_TYPE_POINTS:
+                return 2;
+            default:
+                return 0;
+        }
+    }
+
+    GLBatchRenderer::GLBatchRenderer(GLBackend *backend, size_t verticesPerArena)
+            : m_Backend(backend), m_VerticesPerArena(verticesPerArena) {}
+
+    GLBatchRenderer::~GLBatchRenderer() {
+        if (!m_Arenas.empty()) {
+            g_LoggerGLBatchRenderer.Log(runtime::LOG_LEVEL_WARNING, "Batch renderer was not destroyed before being released!");
+        }
+    }
+
+    void GLBatchRenderer::Destroy() {
+        auto &deletionQueue = m_Backend->GetDeletionQueue();
+
+        // draws flushed this frame still read from the arenas
+        for (auto &arena: m_Arenas) {
+            deletionQueue.ReleaseBuffer(arena->vbo);
+            deletionQueue.ReleaseVertexArray(arena->vao);
+        }
+
+        m_Arenas.clear();
+        m_Meshes.clear();
+        m_FreeMeshSlots.clear();
+
+        if (m_IndirectStream) {
+            m_IndirectStream->Destroy();
+            m_IndirectStream.reset();
+        }
+    }
+
+    GLBatchRenderer::Arena *GLBatchRenderer::CreateArena() {
+        auto arena = std::make_unique<Arena>();
+        auto &stateCache = m_Backend->GetStateCache();
+
+        glGenVertexArrays(1, &arena->vao);
+        glGenBuffers(1, &arena->vbo);
+
+        stateCache.BindVertexArray(arena->vao);
+        stateCache.BindBuffer(GL_ARRAY_BUFFER, arena->vbo);
+
+        glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(m_VerticesPerArena * sizeof(core::runtime::graphics::Vertex)),
+                     nullptr, GL_STATIC_DRAW);
+        GL_ConfigureVertexLayout(GLVertexLayout::Standard());
+
+        arena->allocator.Reset(m_VerticesPerArena);
+
+        g_LoggerGLBatchRenderer.Log(runtime::LOG_LEVEL_DEBUG, "Created vertex arena #%zu (%zu vertices).",
+                                    m_Arenas.size(), m_VerticesPerArena);
+
+        m_Arenas.emplace_back(std::move(arena));
+        return m_Arenas.back().get();
+    }
+
+    GLMeshHandle GLBatchRenderer::AddMesh(std::span<const core::runtime::graphics::Vertex> vertices,
+                                          core::runtime::graphics::PrimitiveType type) {
+        if (vertices.empty() || vertices.size() > m_VerticesPerArena) {
+            g_LoggerGLBatchRenderer.Log(runtime::LOG_LEVEL_ERROR, "Mesh of %zu vertices does not fit in an arena!",
+                                        vertices.size());
+            return {};
+        }
+
+        uint32_t arenaIndex = 0;
+        size_t first = GLRangeAllocator::INVALID_OFFSET;
+
+        for (; arenaIndex < m_Arenas.size(); arenaIndex++) {
+            first = m_Arenas[arenaIndex]->allocator.Allocate(vertices.size());
+
+            if (first != GLRangeAllocator::INVALID_OFFSET) {
+                break;
+            }
+        }
+
+        if (first == GLRangeAllocator::INVALID_OFFSET) {
+            arenaIndex = static_cast<uint32_t>(m_Arenas.size());
+            first = CreateArena()->allocator.Allocate(vertices.size());
+        }
+
+        auto &stateCache = m_Backend->GetStateCache();
+        stateCache.BindBuffer(GL_ARRAY_BUFFER, m_Arenas[arenaIndex]->vbo);
+        glBufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(first * sizeof(core::runtime::graphics::Vertex)),
+                        static_cast<GLsizeiptr>(vertices.size_bytes()), vertices.data());
+        m_Backend->GetCurrentFrameStats().bufferUploadBytes += vertices.size_bytes();
+
+        Mesh mesh{arenaIndex, static_cast<uint32_t>(first), static_cast<uint32_t>(vertices.size()), type, true};
+
+        if (!m_FreeMeshSlots.empty()) {
+            auto slot = m_FreeMeshSlots.back();
+            m_FreeMeshSlots.pop_back();
+
+            // the slot keeps the generation RemoveMesh bumped, which retires the handles given out for it before
+            mesh.generation = m_Meshes[slot].generation;
+            m_Meshes[slot] = mesh;
+            return {slot, mesh.generation};
+        }
+
+        m_Meshes.emplace_back(mesh);
+        return {static_cast<uint32_t>(m_Meshes.size() - 1), mesh.generation};
+    }
+
+    void GLBatchRenderer::RemoveMesh(GLMeshHandle handle) {
+        auto mesh = FindMesh(handle);
+
+        if (!mesh) {
+            return;
+        }
+
+        auto &arena = *m_Arenas[mesh->arena];
+
+        // the range goes back to the allocator right away; a queued draw would render whatever AddMesh puts
+        // there before the next Flush. live meshes never share a range, so first identifies the mesh's draws
+        auto &queue = arena.queues[GL_GetBatchQueueIndex(mesh->type)];
+        std::erase_if(queue, [mesh](const GLDrawArraysIndirectCommand &command) {
+            return command.first == mesh->first;
+        });
+
+        arena.allocator.Free(mesh->first, mesh->count);
+        mesh->alive = false;
+        mesh->generation++;
+
+        m_FreeMeshSlots.emplace_back(handle.index);
+    }
+
+    void GLBatchRenderer::Queue(GLMeshHandle handle) {
+        auto mesh = FindMesh(handle);
+
+        if (!mesh) {
+            return;
+        }
+
+        m_Arenas[mesh->arena]->queues[GL_GetBatchQueueIndex(mesh->type)].push_back({mesh->count, 1, mesh->first, 0});
+    }
+
+    GLBatchRenderer::Mesh *GLBatchRenderer::FindMesh(GLMeshHandle handle) {
+        if (!handle.IsValid() || handle.index >= m_Meshes.size()) {
+            return nullptr;
+        }
+
+        auto &mesh = m_Meshes[handle.index];
+
+        if (!mesh.alive || mesh.generation != handle.generation) {
+            return nullptr;
+        }
+
+        return &mesh;
+    }
+
+    size_t GLBatchRenderer::GetQueuedDrawCount() const {
+        size_t count = 0;
+
+        for (auto &arena: m_Arenas) {
+            for (auto &queue: arena->queues) {
+                count += queue.size();
+            }
+        }
+
+        return count;
+    }
+
+    void GLBatchRenderer::Flush() {
+        auto &stateCache = m_Backend->GetStateCache();
+        auto &stats = m_Backend->GetCurrentFrameStats();
+        auto multiDraw = m_Backend->GetCapabilities().multiDrawIndirect;
+
+        if (multiDraw && !m_IndirectStream) {
+            m_IndirectStream = std::make_unique<GLStreamBuffer>(m_Backend, GL_DRAW_INDIRECT_BUFFER, 256 * 1024);
+            m_IndirectStream->Create();
+        }
+
+        for (auto &arena: m_Arenas) {
+            for (size_t queueIndex = 0; queueIndex < std::size(arena->queues); queueIndex++) {
+                auto &queue = arena->queues[queueIndex];
+
+                if (queue.empty()) {
+                    continue;
+                }
+
+                stateCache.BindVertexArray(arena->vao);
+                auto mode = GL_MapPrimitiveType(GL_BatchPrimitiveTypes[queueIndex]);
+
+                GLStreamAllocation commands;
+
+                if (multiDraw) {
+                    commands = m_IndirectStream->Allocate(queue.size() * sizeof(GLDrawArraysIndirectCommand),
+                                                          sizeof(GLDrawArraysIndirectCommand));
+                }
+
+                if (commands.IsValid()) {
+                    std::memcpy(commands.data, queue.data(), commands.size);
+                    m_IndirectStream->Commit(commands);
+
+                    stateCache.BindBuffer(GL_DRAW_INDIRECT_BUFFER, m_IndirectStream->GetHandle());
+                    glMultiDrawArraysIndirect(mode, reinterpret_cast<const void *>(commands.offset),
+                                              static_cast<GLsizei>(queue.size()), 0);
+
+                    uint64_t vertexCount = 0;
+
+                    for (auto &command: queue) {
+                        vertexCount += command.count;
+                    }
+
+                    stats.CountDraw(vertexCount);
+                } else {
+                    for (auto &command: queue) {
+                        glDrawArrays(mode, static_cast<GLint>(command.first), static_cast<GLsizei>(command.count));
+                        stats.CountDraw(command.count);
+                    }
+                }
+
+                queue.clear();
+            }
+        }
+    }
+}
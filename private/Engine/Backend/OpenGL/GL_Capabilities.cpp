@@ -0,0 +1,158 @@
+#include <cstdio>
+#include <cstring>
+
+#include <Engine/GLHeader.hpp>
+
+#include <Engine/Backend/OpenGL/GL_Capabilities.hpp>
+#include <Engine/Backend/OpenGL/GL_TextureFormat.hpp>
+
+#include <Engine/Runtime/Logger.hpp>
+
+#ifndef GL_MAX_TEXTURE_MAX_ANISOTROPY
+#define GL_MAX_TEXTURE_MAX_ANISOTROPY 0x84FF
+#endif
+
+namespace engine::backend::ogl {
+    static runtime::Logger g_LoggerGLCapabilities("GLCapabilities");
+
+    void GLCapabilities::Detect() {
+        m_Extensions.clear();
+
+        auto version = reinterpret_cast<const char *>(glGetString(GL_VERSION));
+
+        if (!version) {
+            g_LoggerGLCapabilities.Log(runtime::LOG_LEVEL_ERROR, "Failed to query the GL version; is a context current?");
+            return;
+        }
+
+        // "OpenGL ES 3.2 Mesa ..." or "4.6.0 NVIDIA ..."
+        static constexpr const char *esPrefix = "OpenGL ES ";
+        isES = std::strncmp(version, esPrefix, std::strlen(esPrefix)) == 0;
+
+        if (std::sscanf(isES ? version + std::strlen(esPrefix) : version, "%d.%d", &majorVersion, &minorVersion) != 2) {
+            majorVersion = minorVersion = 0;
+        }
+
+        if (majorVersion >= 3) {
+            GLint extensionCount = 0;
+            glGetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+
+            for (GLint i = 0; i < extensionCount; i++) {
+                if (auto name = reinterpret_cast<const char *>(glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i)))) {
+                    m_Extensions.emplace(name);
+                }
+            }
+        } else if (auto extensions = reinterpret_cast<const char *>(glGetString(GL_EXTENSIONS))) {
+            std::string_view list(extensions);
+
+            while (!list.empty()) {
+                auto end = list.find(' ');
+                auto name = list.substr(0, end);
+
+                if (!name.empty()) {
+                    m_Extensions.emplace(name);
+                }
+
+                list.remove_prefix(end == std::string_view::npos ? list.size() : end + 1);
+            }
+        }
+
+        parallelShaderCompile = HasExtension("GL_KHR_parallel_shader_compile") ||
+                                HasExtension("GL_ARB_parallel_shader_compile");
+
+        // GLES only has the EXT entry point, which the desktop loader does not provide
+        bufferStorage = IsAtLeast(4, 4, false) || (!isES && HasExtension("GL_ARB_buffer_storage"));
+
+        syncObjects = IsAtLeast(3, 2, false) || IsAtLeast(3, 0, true) || (!isES && HasExtension("GL_ARB_sync"));
+
+        drawElementsBaseVertex = IsAtLeast(3, 2, false) || IsAtLeast(3, 2, true) ||
+                                 (!isES && HasExtension("GL_ARB_draw_elements_base_vertex"));
+
+        baseInstance = IsAtLeast(4, 2, false) || (!isES && HasExtension("GL_ARB_base_instance"));
+
+        multiDrawIndirect = IsAtLeast(4, 3, false) || (!isES && HasExtension("GL_ARB_multi_draw_indirect"));
+
+        textureStorage = IsAtLeast(4, 2, false) || IsAtLeast(3, 0, true) ||
+                         (!isES && HasExtension("GL_ARB_texture_storage"));
+
+        copyImage = IsAtLeast(4, 3, false) || (!isES && HasExtension("GL_ARB_copy_image"));
+
+        samplerObjects = IsAtLeast(3, 3, false) || IsAtLeast(3, 0, true) ||
+                         (!isES && HasExtension("GL_ARB_sampler_objects"));
+
+        disjointTimerQuery = isES && HasExtension("GL_EXT_disjoint_timer_query");
+        timerQuery = IsAtLeast(3, 3, false) || (!isES && HasExtension("GL_ARB_timer_query")) || disjointTimerQuery;
+
+#ifdef GL_WITH_LOADER
+        // glad loads entry points by context version, so an ES 3.x context does not get the GL 3.3 query functions
+        if (isES && (!glad_glQueryCounter || !glad_glGetQueryObjectui64v)) {
+            timerQuery = false;
+        }
+#endif
+
+        timestampQuery = false;
+
+        if (timerQuery) {
+            GLint counterBits = 0;
+            glGetQueryiv(GL_TIMESTAMP, GL_QUERY_COUNTER_BITS, &counterBits);
+            timestampQuery = counterBits > 0;
+        }
+
+        uniformBufferOffsetAlignment = 256;
+        maxUniformBufferBindings = 0;
+        maxUniformBlockSize = 0;
+
+        // uniform buffers are core since GL 3.1 / GLES 3.0
+        if (IsAtLeast(3, 1, false) || IsAtLeast(3, 0, true)) {
+            glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &uniformBufferOffsetAlignment);
+            glGetIntegerv(GL_MAX_UNIFORM_BUFFER_BINDINGS, &maxUniformBufferBindings);
+            glGetIntegerv(GL_MAX_UNIFORM_BLOCK_SIZE, &maxUniformBlockSize);
+            uniformBufferOffsetAlignment = uniformBufferOffsetAlignment < 1 ? 256 : uniformBufferOffsetAlignment;
+        }
+
+        maxAnisotropy = 1.f;
+
+        if (IsAtLeast(4, 6, false) || HasExtension("GL_ARB_texture_filter_anisotropic") ||
+            HasExtension("GL_EXT_texture_filter_anisotropic")) {
+            glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY, &maxAnisotropy);
+            maxAnisotropy = maxAnisotropy < 1.f ? 1.f : maxAnisotropy;
+        }
+
+        compressionS3TC = HasExtension("GL_EXT_texture_compression_s3tc");
+
+        compressionRGTC = IsAtLeast(3, 0, false) || HasExtension("GL_ARB_texture_compression_rgtc") ||
+                          HasExtension("GL_EXT_texture_compression_rgtc");
+
+        compressionBPTC = IsAtLeast(4, 2, false) || HasExtension("GL_ARB_texture_compression_bptc") ||
+                          HasExtension("GL_EXT_texture_compression_bptc");
+
+        // desktop drivers expose ETC2 through ES3 compatibility but often decompress it on the CPU
+        compressionETC2 = IsAtLeast(3, 0, true) || IsAtLeast(4, 3, false) || HasExtension("GL_ARB_ES3_compatibility");
+
+        compressionASTC = IsAtLeast(3, 2, true) || HasExtension("GL_KHR_texture_compression_astc_ldr");
+
+        g_LoggerGLCapabilities.Log(runtime::LOG_LEVEL_INFO, "Detected %s %d.%d with %zu extensions.",
+                                   isES ? "OpenGL ES" : "OpenGL", majorVersion, minorVersion, m_Extensions.size());
+    }
+
+    bool GLCapabilities::SupportsCompressedFormat(unsigned int internalFormat) const {
+        switch (GL_GetCompressedFormatInfo(internalFormat).family) {
+            case GLCompressionFamily::COMPRESSION_S3TC:
+                return compressionS3TC;
+            case GLCompressionFamily::COMPRESSION_RGTC:
+                return compressionRGTC;
+            case GLCompressionFamily::COMPRESSION_BPTC:
+                return compressionBPTC;
+            case GLCompressionFamily::COMPRESSION_ETC2:
+                return compressionETC2;
+            case GLCompressionFamily::COMPRESSION_ASTC:
+                return compressionASTC;
+            default:
+                return false;
+        }
+    }
+
+    bool GLCapabilities::HasExtension(std::string_view name) const {
+        return m_Extensions.contains(std::string(name));
+    }
+}
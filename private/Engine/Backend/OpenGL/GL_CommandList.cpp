@@ -0,0 +1,346 @@
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+#include <Engine/Backend/OpenGL/GL_Backend.hpp>
+#include <Engine/Backend/OpenGL/GL_CommandList.hpp>
+#include <Engine/Backend/OpenGL/GL_ShaderProgram.hpp>
+#include <Engine/Backend/OpenGL/GL_VertexBuffer.hpp>
+
+#include <Engine/Runtime/Logger.hpp>
+
+namespace engine::backend::ogl {
+    static runtime::Logger g_LoggerGLCommandList("GLCommandList");
+
+    // every command starts on this boundary, so payloads holding pointers, size_t or glm types are aligned
+    static constexpr size_t GL_COMMAND_ALIGNMENT = alignof(std::max_align_t);
+
+    struct GLCommandHeader {
+        GLCommandType type;
+        // header included, padded to GL_COMMAND_ALIGNMENT
+        uint32_t size;
+    };
+
+    static constexpr size_t GL_COMMAND_HEADER_SIZE =
+            (sizeof(GLCommandHeader) + GL_COMMAND_ALIGNMENT - 1) & ~(GL_COMMAND_ALIGNMENT - 1);
+
+    struct GLCommandProgram {
+        GLShaderProgram *program;
+    };
+
+    struct GLCommandTexture {
+        core::runtime::graphics::ITexture *texture;
+        int samplerSlot;
+    };
+
+    template<typename T>
+    struct GLCommandUniform {
+        GLShaderProgram *program;
+        GLUniformHandle handle;
+        T value;
+    };
+
+    struct GLCommandRect {
+        core::math::Vector2 position;
+        core::math::Vector2 size;
+    };
+
+    struct GLCommandFeatures {
+        core::runtime::graphics::BackendFeature features;
+    };
+
+    struct GLCommandClear {
+        core::runtime::graphics::Color color;
+    };
+
+    struct GLCommandDraw {
+        GLVertexBuffer *buffer;
+    };
+
+    struct GLCommandDrawIndexedRange {
+        GLVertexBuffer *buffer;
+        size_t firstIndex;
+        size_t indexCount;
+        int baseVertex;
+    };
+
+    // followed by count elements of vertex or instance data
+    struct GLCommandBufferData {
+        GLVertexBuffer *buffer;
+        size_t first;
+        size_t count;
+    };
+
+    struct GLCommandScope {
+        const char *name;
+    };
+
+    template<typename T>
+    static const T &GL_CommandPayload(const unsigned char *command) {
+        return *std::launder(reinterpret_cast<const T *>(command + GL_COMMAND_HEADER_SIZE));
+    }
+
+    GLCommandList::GLCommandList(size_t blockSize) : m_BlockSize(std::max<size_t>(blockSize, 1024)) {}
+
+    void GLCommandList::Reset() {
+        for (auto &block: m_Blocks) {
+            block.used = 0;
+        }
+
+        m_CurrentBlock = 0;
+        m_CommandCount = 0;
+    }
+
+    void GLCommandList::Release() {
+        m_Blocks.clear();
+        m_CurrentBlock = 0;
+        m_CommandCount = 0;
+    }
+
+    size_t GLCommandList::GetSize() const {
+        size_t size = 0;
+
+        for (auto &block: m_Blocks) {
+            size += block.used;
+        }
+
+        return size;
+    }
+
+    void *GLCommandList::Allocate(GLCommandType type, size_t payloadSize) {
+        auto size = (GL_COMMAND_HEADER_SIZE + payloadSize + GL_COMMAND_ALIGNMENT - 1) & ~(GL_COMMAND_ALIGNMENT - 1);
+
+        if (m_Blocks.empty() || m_Blocks[m_CurrentBlock].used + size > m_Blocks[m_CurrentBlock].capacity) {
+            if (!m_Blocks.empty() && m_Blocks[m_CurrentBlock].used > 0) {
+                m_CurrentBlock++;
+            }
+
+            // blocks left over from earlier recordings are reused; oversized commands get a block of their own
+            if (m_CurrentBlock >= m_Blocks.size() || m_Blocks[m_CurrentBlock].capacity < size) {
+                auto capacity = std::max(m_BlockSize, size);
+                auto position = m_Blocks.begin() + static_cast<std::ptrdiff_t>(std::min(m_CurrentBlock, m_Blocks.size()));
+                m_Blocks.insert(position, Block{std::make_unique<unsigned char[]>(capacity), capacity, 0});
+            }
+        }
+
+        auto &block = m_Blocks[m_CurrentBlock];
+        auto *command = block.data.get() + block.used;
+        block.used += size;
+        m_CommandCount++;
+
+        new(command) GLCommandHeader{type, static_cast<uint32_t>(size)};
+        return command + GL_COMMAND_HEADER_SIZE;
+    }
+
+    template<typename T>
+    T *GLCommandList::Record(GLCommandType type, const T &payload, size_t extraSize) {
+        static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>,
+                      "command payloads are copied as bytes and never destroyed");
+        static_assert(alignof(T) <= GL_COMMAND_ALIGNMENT);
+
+        return new(Allocate(type, sizeof(T) + extraSize)) T(payload);
+    }
+
+    void GLCommandList::BindProgram(GLShaderProgram *program) {
+        Record(GLCommandType::COMMAND_BIND_PROGRAM, GLCommandProgram{program});
+    }
+
+    void GLCommandList::BindTexture(core::runtime::graphics::ITexture *texture, int samplerSlot) {
+        Record(GLCommandType::COMMAND_BIND_TEXTURE, GLCommandTexture{texture, samplerSlot});
+    }
+
+    void GLCommandList::SetUniform(GLShaderProgram *program, GLUniformHandle handle, int val) {
+        Record(GLCommandType::COMMAND_SET_UNIFORM_INT, GLCommandUniform<int>{program, handle, val});
+    }
+
+    void GLCommandList::SetUniform(GLShaderProgram *program, GLUniformHandle handle, float val) {
+        Record(GLCommandType::COMMAND_SET_UNIFORM_FLOAT, GLCommandUniform<float>{program, handle, val});
+    }
+
+    void GLCommandList::SetUniform(GLShaderProgram *program, GLUniformHandle handle, const glm::vec2 &val) {
+        Record(GLCommandType::COMMAND_SET_UNIFORM_VEC2, GLCommandUniform<glm::vec2>{program, handle, val});
+    }
+
+    void GLCommandList::SetUniform(GLShaderProgram *program, GLUniformHandle handle, const glm::vec3 &val) {
+        Record(GLCommandType::COMMAND_SET_UNIFORM_VEC3, GLCommandUniform<glm::vec3>{program, handle, val});
+    }
+
+    void GLCommandList::SetUniform(GLShaderProgram *program, GLUniformHandle handle, const glm::vec4 &val) {
+        Record(GLCommandType::COMMAND_SET_UNIFORM_VEC4, GLCommandUniform<glm::vec4>{program, handle, val});
+    }
+
+    void GLCommandList::SetUniform(GLShaderProgram *program, GLUniformHandle handle, const glm::mat3 &val) {
+        Record(GLCommandType::COMMAND_SET_UNIFORM_MAT3, GLCommandUniform<glm::mat3>{program, handle, val});
+    }
+
+    void GLCommandList::SetUniform(GLShaderProgram *program, GLUniformHandle handle, const glm::mat4 &val) {
+        Record(GLCommandType::COMMAND_SET_UNIFORM_MAT4, GLCommandUniform<glm::mat4>{program, handle, val});
+    }
+
+    void GLCommandList::SetViewport(core::math::Vector2 pos, core::math::Vector2 size) {
+        Record(GLCommandType::COMMAND_SET_VIEWPORT, GLCommandRect{pos, size});
+    }
+
+    void GLCommandList::SetScissor(core::math::Vector2 start, core::math::Vector2 size) {
+        Record(GLCommandType::COMMAND_SET_SCISSOR, GLCommandRect{start, size});
+    }
+
+    void GLCommandList::EnableFeatures(core::runtime::graphics::BackendFeature featuresMask) {
+        Record(GLCommandType::COMMAND_ENABLE_FEATURES, GLCommandFeatures{featuresMask});
+    }
+
+    void GLCommandList::DisableFeatures(core::runtime::graphics::BackendFeature featuresMask) {
+        Record(GLCommandType::COMMAND_DISABLE_FEATURES, GLCommandFeatures{featuresMask});
+    }
+
+    void GLCommandList::Clear(core::runtime::graphics::Color color) {
+        Record(GLCommandType::COMMAND_CLEAR, GLCommandClear{color});
+    }
+
+    void GLCommandList::Draw(GLVertexBuffer *buffer) {
+        Record(GLCommandType::COMMAND_DRAW, GLCommandDraw{buffer});
+    }
+
+    void GLCommandList::DrawIndexedRange(GLVertexBuffer *buffer, size_t firstIndex, size_t indexCount, int baseVertex) {
+        Record(GLCommandType::COMMAND_DRAW_INDEXED_RANGE,
+               GLCommandDrawIndexedRange{buffer, firstIndex, indexCount, baseVertex});
+    }
+
+    void GLCommandList::DrawInstanced(GLVertexBuffer *buffer) {
+        Record(GLCommandType::COMMAND_DRAW_INSTANCED, GLCommandDraw{buffer});
+    }
+
+    void GLCommandList::UpdateVertices(GLVertexBuffer *buffer, size_t firstVertex,
+                                       std::span<const core::runtime::graphics::Vertex> vertices) {
+        auto *command = Record(GLCommandType::COMMAND_UPDATE_VERTICES,
+                               GLCommandBufferData{buffer, firstVertex, vertices.size()}, vertices.size_bytes());
+        std::memcpy(command + 1, vertices.data(), vertices.size_bytes());
+    }
+
+    void GLCommandList::UploadInstances(GLVertexBuffer *buffer, std::span<const GLInstanceData> instances) {
+        static_assert(sizeof(GLCommandBufferData) % alignof(GLInstanceData) == 0);
+
+        auto *command = Record(GLCommandType::COMMAND_UPLOAD_INSTANCES,
+                               GLCommandBufferData{buffer, 0, instances.size()}, instances.size_bytes());
+        std::memcpy(command + 1, instances.data(), instances.size_bytes());
+    }
+
+    void GLCommandList::BeginScope(const char *name) {
+        Record(GLCommandType::COMMAND_BEGIN_SCOPE, GLCommandScope{name});
+    }
+
+    void GLCommandList::EndScope() {
+        Allocate(GLCommandType::COMMAND_END_SCOPE, 0);
+    }
+
+    void GLCommandList::Execute(GLBackend &backend) const {
+        for (size_t i = 0; i < m_Blocks.size() && i <= m_CurrentBlock; i++) {
+            auto &block = m_Blocks[i];
+
+            for (size_t offset = 0; offset < block.used;) {
+                auto *command = block.data.get() + offset;
+                auto &header = *std::launder(reinterpret_cast<const GLCommandHeader *>(command));
+                offset += header.size;
+
+                switch (header.type) {
+                    case GLCommandType::COMMAND_BIND_PROGRAM:
+                        GL_CommandPayload<GLCommandProgram>(command).program->Bind();
+                        break;
+                    case GLCommandType::COMMAND_BIND_TEXTURE: {
+                        auto &payload = GL_CommandPayload<GLCommandTexture>(command);
+                        payload.texture->Bind(payload.samplerSlot);
+                        break;
+                    }
+                    case GLCommandType::COMMAND_SET_UNIFORM_INT: {
+                        auto &payload = GL_CommandPayload<GLCommandUniform<int>>(command);
+                        payload.program->SetUniform(payload.handle, payload.value);
+                        break;
+                    }
+                    case GLCommandType::COMMAND_SET_UNIFORM_FLOAT: {
+                        auto &payload = GL_CommandPayload<GLCommandUniform<float>>(command);
+                        payload.program->SetUniform(payload.handle, payload.value);
+                        break;
+                    }
+                    case GLCommandType::COMMAND_SET_UNIFORM_VEC2: {
+                        auto &payload = GL_CommandPayload<GLCommandUniform<glm::vec2>>(command);
+                        payload.program->SetUniform(payload.handle, payload.value);
+                        break;
+                    }
+                    case GLCommandType::COMMAND_SET_UNIFORM_VEC3: {
+                        auto &payload = GL_CommandPayload<GLCommandUniform<glm::vec3>>(command);
+                        payload.program->SetUniform(payload.handle, payload.value);
+                        break;
+                    }
+                    case GLCommandType::COMMAND_SET_UNIFORM_VEC4: {
+                        auto &payload = GL_CommandPayload<GLCommandUniform<glm::vec4>>(command);
+                        payload.program->SetUniform(payload.handle, payload.value);
+                        break;
+                    }
+                    case GLCommandType::COMMAND_SET_UNIFORM_MAT3: {
+                        auto &payload = GL_CommandPayload<GLCommandUniform<glm::mat3>>(command);
+                        payload.program->SetUniform(payload.handle, payload.value);
+                        break;
+                    }
+                    case GLCommandType::COMMAND_SET_UNIFORM_MAT4: {
+                        auto &payload = GL_CommandPayload<GLCommandUniform<glm::mat4>>(command);
+                        payload.program->SetUniform(payload.handle, payload.value);
+                        break;
+                    }
+                    case GLCommandType::COMMAND_SET_VIEWPORT: {
+                        auto &payload = GL_CommandPayload<GLCommandRect>(command);
+                        backend.SetViewport(payload.position, payload.size);
+                        break;
+                    }
+                    case GLCommandType::COMMAND_SET_SCISSOR: {
+                        auto &payload = GL_CommandPayload<GLCommandRect>(command);
+                        backend.SetScissor(payload.position, payload.size);
+                        break;
+                    }
+                    case GLCommandType::COMMAND_ENABLE_FEATURES:
+                        backend.EnableFeatures(GL_CommandPayload<GLCommandFeatures>(command).features);
+                        break;
+                    case GLCommandType::COMMAND_DISABLE_FEATURES:
+                        backend.DisableFeatures(GL_CommandPayload<GLCommandFeatures>(command).features);
+                        break;
+                    case GLCommandType::COMMAND_CLEAR:
+                        backend.Clear(GL_CommandPayload<GLCommandClear>(command).color);
+                        break;
+                    case GLCommandType::COMMAND_DRAW:
+                        GL_CommandPayload<GLCommandDraw>(command).buffer->Draw();
+                        break;
+                    case GLCommandType::COMMAND_DRAW_INDEXED_RANGE: {
+                        auto &payload = GL_CommandPayload<GLCommandDrawIndexedRange>(command);
+                        payload.buffer->DrawIndexedRange(payload.firstIndex, payload.indexCount, payload.baseVertex);
+                        break;
+                    }
+                    case GLCommandType::COMMAND_DRAW_INSTANCED:
+                        GL_CommandPayload<GLCommandDraw>(command).buffer->DrawInstanced();
+                        break;
+                    case GLCommandType::COMMAND_UPDATE_VERTICES: {
+                        auto &payload = GL_CommandPayload<GLCommandBufferData>(command);
+                        auto *vertices = reinterpret_cast<const core::runtime::graphics::Vertex *>(&payload + 1);
+                        payload.buffer->UpdateRange(payload.first, {vertices, payload.count});
+                        break;
+                    }
+                    case GLCommandType::COMMAND_UPLOAD_INSTANCES: {
+                        auto &payload = GL_CommandPayload<GLCommandBufferData>(command);
+                        auto *instances = reinterpret_cast<const GLInstanceData *>(&payload + 1);
+                        payload.buffer->UploadInstances(std::span<const GLInstanceData>(instances, payload.count));
+                        break;
+                    }
+                    case GLCommandType::COMMAND_BEGIN_SCOPE:
+                        backend.GetProfiler().BeginScope(GL_CommandPayload<GLCommandScope>(command).name);
+                        break;
+                    case GLCommandType::COMMAND_END_SCOPE:
+                        backend.GetProfiler().EndScope();
+                        break;
+                    default:
+                        g_LoggerGLCommandList.Log(runtime::LOG_LEVEL_ERROR, "Unknown command %u in command list!",
+                                                  static_cast<unsigned int>(header.type));
+                        return;
+                }
+            }
+        }
+    }
+}
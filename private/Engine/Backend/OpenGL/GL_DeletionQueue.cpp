@@ -0,0 +1,228 @@
+#include <Engine/GLHeader.hpp>
+
+#include <Engine/Backend/OpenGL/GL_Backend.hpp>
+#include <Engine/Backend/OpenGL/GL_DeletionQueue.hpp>
+
+#include <Engine/Runtime/Logger.hpp>
+
+namespace engine::backend::ogl {
+    static runtime::Logger g_LoggerGLDeletionQueue("GLDeletionQueue");
+
+    GLDeletionQueue::~GLDeletionQueue() {
+        if (GetPendingCount() > 0 || !m_VertexBuffers.empty() || !m_Textures.empty() || !m_Programs.empty()) {
+            g_LoggerGLDeletionQueue.Log(runtime::LOG_LEVEL_WARNING, "Deletion queue was not destroyed before being released!");
+        }
+    }
+
+    void GLDeletionQueue::Destroy() {
+        std::vector<std::unique_ptr<core::runtime::graphics::IVertexBuffer>> vertexBuffers;
+        std::vector<std::unique_ptr<core::runtime::graphics::ITexture>> textures;
+        std::vector<std::unique_ptr<core::runtime::graphics::IShaderProgram>> programs;
+        std::vector<GLReleasedObject> released;
+
+        {
+            std::lock_guard lock(m_Mutex);
+            vertexBuffers.swap(m_VertexBuffers);
+            textures.swap(m_Textures);
+            programs.swap(m_Programs);
+        }
+
+        // their handles land in m_Released
+        for (auto &buffer: vertexBuffers) {
+            buffer->Destroy();
+        }
+
+        for (auto &texture: textures) {
+            texture->Destroy();
+        }
+
+        for (auto &program: programs) {
+            program->Destroy();
+        }
+
+        {
+            std::lock_guard lock(m_Mutex);
+            released.swap(m_Released);
+        }
+
+        // the driver defers deleting objects that are still in use, so nothing has to wait here
+        for (auto &batch: m_Batches) {
+            RetireBatch(batch, false);
+        }
+
+        m_Batches.clear();
+
+        for (auto &object: released) {
+            Retire(object, false);
+        }
+    }
+
+    void GLDeletionQueue::Release(const GLReleasedObject &object) {
+        if (object.handle == 0) {
+            return;
+        }
+
+        std::lock_guard lock(m_Mutex);
+        m_Released.push_back(object);
+    }
+
+    void GLDeletionQueue::ReleaseBuffer(unsigned int buffer, size_t capacity, unsigned int usage) {
+        GLReleasedObject object{GLReleaseType::RELEASE_BUFFER, buffer};
+        object.format = usage;
+        object.size = capacity;
+        Release(object);
+    }
+
+    void GLDeletionQueue::ReleaseTexture(unsigned int texture, unsigned int internalFormat, int width, int height,
+                                         int levels) {
+        GLReleasedObject object{GLReleaseType::RELEASE_TEXTURE, texture};
+        object.format = internalFormat;
+        object.width = width;
+        object.height = height;
+        object.levels = levels;
+        Release(object);
+    }
+
+    void GLDeletionQueue::ReleaseVertexArray(unsigned int vertexArray) {
+        Release(GLReleasedObject{GLReleaseType::RELEASE_VERTEX_ARRAY, vertexArray});
+    }
+
+    void GLDeletionQueue::ReleaseProgram(unsigned int program) {
+        Release(GLReleasedObject{GLReleaseType::RELEASE_PROGRAM, program});
+    }
+
+    void GLDeletionQueue::Release(std::unique_ptr<core::runtime::graphics::IVertexBuffer> buffer) {
+        if (buffer) {
+            std::lock_guard lock(m_Mutex);
+            m_VertexBuffers.emplace_back(std::move(buffer));
+        }
+    }
+
+    void GLDeletionQueue::Release(std::unique_ptr<core::runtime::graphics::ITexture> texture) {
+        if (texture) {
+            std::lock_guard lock(m_Mutex);
+            m_Textures.emplace_back(std::move(texture));
+        }
+    }
+
+    void GLDeletionQueue::Release(std::unique_ptr<core::runtime::graphics::IShaderProgram> program) {
+        if (program) {
+            std::lock_guard lock(m_Mutex);
+            m_Programs.emplace_back(std::move(program));
+        }
+    }
+
+    void GLDeletionQueue::Flush() {
+        std::vector<std::unique_ptr<core::runtime::graphics::IVertexBuffer>> vertexBuffers;
+        std::vector<std::unique_ptr<core::runtime::graphics::ITexture>> textures;
+        std::vector<std::unique_ptr<core::runtime::graphics::IShaderProgram>> programs;
+
+        {
+            std::lock_guard lock(m_Mutex);
+            vertexBuffers.swap(m_VertexBuffers);
+            textures.swap(m_Textures);
+            programs.swap(m_Programs);
+        }
+
+        // Destroy() releases the handles through this queue, so the lock must not be held here
+        for (auto &buffer: vertexBuffers) {
+            buffer->Destroy();
+        }
+
+        for (auto &texture: textures) {
+            texture->Destroy();
+        }
+
+        for (auto &program: programs) {
+            program->Destroy();
+        }
+
+        Batch batch{nullptr, m_Backend->GetFrameIndex(), {}};
+
+        {
+            std::lock_guard lock(m_Mutex);
+            batch.objects.swap(m_Released);
+        }
+
+        if (!batch.objects.empty()) {
+            // covers every command that could have used the objects, since they were released before it.
+            // without fences the batch waits FALLBACK_LATENCY frames instead
+            if (m_Backend->GetCapabilities().syncObjects) {
+                batch.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            }
+
+            m_Batches.emplace_back(std::move(batch));
+        }
+
+        // fences signal in submission order, so the first pending batch bounds the ones after it
+        while (!m_Batches.empty() && IsSignaled(m_Batches.front())) {
+            RetireBatch(m_Batches.front(), true);
+            m_Batches.pop_front();
+        }
+    }
+
+    size_t GLDeletionQueue::GetPendingCount() const {
+        size_t count = 0;
+
+        for (auto &batch: m_Batches) {
+            count += batch.objects.size();
+        }
+
+        std::lock_guard lock(m_Mutex);
+        return count + m_Released.size();
+    }
+
+    bool GLDeletionQueue::IsSignaled(const Batch &batch) const {
+        if (!batch.fence) {
+            return m_Backend->GetFrameIndex() >= batch.frame + FALLBACK_LATENCY;
+        }
+
+        auto result = glClientWaitSync(static_cast<GLsync>(batch.fence), GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+        return result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED;
+    }
+
+    void GLDeletionQueue::Retire(const GLReleasedObject &object, bool recycle) {
+        auto &stateCache = m_Backend->GetStateCache();
+        auto &pool = m_Backend->GetResourcePool();
+
+        switch (object.type) {
+            case GLReleaseType::RELEASE_BUFFER:
+                if (recycle && object.size > 0) {
+                    pool.RecycleBuffer(object.handle, object.size, object.format);
+                } else {
+                    glDeleteBuffers(1, &object.handle);
+                    stateCache.OnBufferDeleted(object.handle);
+                }
+                break;
+            case GLReleaseType::RELEASE_TEXTURE:
+                if (recycle && object.format != 0) {
+                    pool.RecycleTexture(object.handle, object.format, object.width, object.height, object.levels);
+                } else {
+                    glDeleteTextures(1, &object.handle);
+                    stateCache.OnTextureDeleted(object.handle);
+                }
+                break;
+            case GLReleaseType::RELEASE_VERTEX_ARRAY:
+                glDeleteVertexArrays(1, &object.handle);
+                stateCache.OnVertexArrayDeleted(object.handle);
+                break;
+            case GLReleaseType::RELEASE_PROGRAM:
+                glDeleteProgram(object.handle);
+                stateCache.OnProgramDeleted(object.handle);
+                break;
+        }
+    }
+
+    void GLDeletionQueue::RetireBatch(Batch &batch, bool recycle) {
+        if (batch.fence) {
+            glDeleteSync(static_cast<GLsync>(batch.fence));
+            batch.fence = nullptr;
+        }
+
+        for (auto &object: batch.objects) {
+            Retire(object, recycle);
+        }
+
+        batch.objects.clear();
+    }
+}
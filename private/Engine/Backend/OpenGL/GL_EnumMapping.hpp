@@ -0,0 +1,13 @@
+#pragma once
+
+#include <Engine/Core/Runtime/Graphics/IVertexBuffer.hpp>
+
+namespace engine::backend::ogl {
+    // engine enums to their GL values; defined in GL_VertexBuffer.cpp
+
+    // glBufferData usage of a buffer usage hint
+    unsigned int GL_MapUsageType(core::runtime::graphics::BufferUsageHint usage);
+
+    // draw mode of a primitive type
+    unsigned int GL_MapPrimitiveType(core::runtime::graphics::PrimitiveType prim);
+}
@@ -0,0 +1,113 @@
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <Engine/Backend/OpenGL/GL_MappedFile.hpp>
+
+namespace engine::backend::ogl {
+    GLMappedFile::~GLMappedFile() {
+        Close();
+    }
+
+#ifdef _WIN32
+    bool GLMappedFile::Open(const std::filesystem::path &path) {
+        Close();
+
+        auto file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+        if (file == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+
+        LARGE_INTEGER size;
+
+        if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+            CloseHandle(file);
+            return false;
+        }
+
+        auto mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+        if (!mapping) {
+            CloseHandle(file);
+            return false;
+        }
+
+        auto data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+        if (!data) {
+            CloseHandle(mapping);
+            CloseHandle(file);
+            return false;
+        }
+
+        m_File = file;
+        m_Mapping = mapping;
+        m_Data = static_cast<const unsigned char *>(data);
+        m_Size = static_cast<size_t>(size.QuadPart);
+        return true;
+    }
+
+    void GLMappedFile::Close() {
+        if (m_Data) {
+            UnmapViewOfFile(m_Data);
+            CloseHandle(m_Mapping);
+            CloseHandle(m_File);
+        }
+
+        m_Data = nullptr;
+        m_Size = 0;
+        m_File = nullptr;
+        m_Mapping = nullptr;
+    }
+#else
+    bool GLMappedFile::Open(const std::filesystem::path &path) {
+        Close();
+
+        auto fd = open(path.c_str(), O_RDONLY);
+
+        if (fd < 0) {
+            return false;
+        }
+
+        struct stat info{};
+
+        if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+            close(fd);
+            return false;
+        }
+
+        auto data = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+
+        // the mapping keeps its own reference to the file
+        close(fd);
+
+        if (data == MAP_FAILED) {
+            return false;
+        }
+
+        // mip levels are read front to back exactly once
+        madvise(data, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+
+        m_Data = static_cast<const unsigned char *>(data);
+        m_Size = static_cast<size_t>(info.st_size);
+        return true;
+    }
+
+    void GLMappedFile::Close() {
+        if (m_Data) {
+            munmap(const_cast<unsigned char *>(m_Data), m_Size);
+        }
+
+        m_Data = nullptr;
+        m_Size = 0;
+    }
+#endif
+}
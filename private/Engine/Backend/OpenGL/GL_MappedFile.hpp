@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+namespace engine::backend::ogl {
+    // read-only memory mapping of a whole file; unmapped on destruction
+    struct GLMappedFile {
+        GLMappedFile() = default;
+
+        ~GLMappedFile();
+
+        GLMappedFile(const GLMappedFile &) = delete;
+
+        GLMappedFile &operator=(const GLMappedFile &) = delete;
+
+        bool Open(const std::filesystem::path &path);
+
+        void Close();
+
+        std::span<const unsigned char> GetData() const {
+            return {m_Data, m_Size};
+        }
+
+        bool IsOpen() const {
+            return m_Data != nullptr;
+        }
+
+    protected:
+        const unsigned char *m_Data = nullptr;
+        size_t m_Size = 0;
+#ifdef _WIN32
+        void *m_File = nullptr;
+        void *m_Mapping = nullptr;
+#endif
+    };
+}
@@ -0,0 +1,373 @@
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <fstream>
+
+#include <Engine/GLHeader.hpp>
+
+#include <Engine/Backend/OpenGL/GL_Backend.hpp>
+#include <Engine/Backend/OpenGL/GL_Profiler.hpp>
+
+#include <Engine/Runtime/Logger.hpp>
+
+#ifndef GL_GPU_DISJOINT_EXT
+#define GL_GPU_DISJOINT_EXT 0x8FBB
+#endif
+
+namespace engine::backend::ogl {
+    static runtime::Logger g_LoggerGLProfiler("GLProfiler");
+
+    // the GPU and CPU clocks drift apart slowly; re-measuring every few seconds keeps traces aligned
+    static constexpr uint64_t GL_PROFILER_CALIBRATION_INTERVAL = 600;
+
+    static uint64_t GL_ProfilerNow() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    static void GL_AppendJsonString(std::string &out, const char *value) {
+        out += '"';
+
+        for (auto c = value; *c; c++) {
+            switch (*c) {
+                case '"':
+                    out += "\\\"";
+                    break;
+                case '\\':
+                    out += "\\\\";
+                    break;
+                default:
+                    if (static_cast<unsigned char>(*c) < 0x20) {
+                        char escaped[8];
+                        std::snprintf(escaped, sizeof(escaped), "\\u%04x", *c);
+                        out += escaped;
+                    } else {
+                        out += *c;
+                    }
+            }
+        }
+
+        out += '"';
+    }
+
+    static void GL_AppendTraceEvent(std::string &out, const char *name, int thread, uint64_t beginNs, uint64_t endNs,
+                                    uint64_t originNs, uint64_t frameIndex) {
+        char buffer[160];
+
+        out += out.back() == '[' ? "\n" : ",\n";
+        out += "{\"name\":";
+        GL_AppendJsonString(out, name);
+
+        // trace timestamps are microseconds; fractions keep sub-microsecond GPU scopes visible
+        std::snprintf(buffer, sizeof(buffer),
+                      ",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"frame\":%" PRIu64 "}}",
+                      thread, static_cast<double>(beginNs - originNs) / 1000.0,
+                      static_cast<double>(endNs - beginNs) / 1000.0, frameIndex);
+        out += buffer;
+    }
+
+    GLProfiler::GLProfiler(GLBackend *backend, size_t historySize)
+            : m_Backend(backend), m_HistorySize(historySize > 0 ? historySize : 1) {
+        m_Current.frame.cpuBeginNs = GL_ProfilerNow();
+    }
+
+    GLProfiler::~GLProfiler() {
+        if (!m_AllQueries.empty()) {
+            g_LoggerGLProfiler.Log(runtime::LOG_LEVEL_WARNING, "Profiler was not destroyed before being released!");
+        }
+    }
+
+    void GLProfiler::Destroy() {
+        if (!m_AllQueries.empty()) {
+            glDeleteQueries(static_cast<GLsizei>(m_AllQueries.size()), m_AllQueries.data());
+        }
+
+        m_AllQueries.clear();
+        m_FreeQueries.clear();
+        m_InFlight.clear();
+        m_Current.queries.clear();
+        m_Current.lastQuery = 0;
+        m_ElapsedScope = -1;
+    }
+
+    void GLProfiler::SetEnabled(bool enabled) {
+        m_Enabled = enabled;
+    }
+
+    unsigned int GLProfiler::AcquireQuery() {
+        if (m_FreeQueries.empty()) {
+            // names are cheap; generating them in blocks keeps glGenQueries out of the common path
+            GLuint queries[32];
+            glGenQueries(static_cast<GLsizei>(std::size(queries)), queries);
+
+            m_AllQueries.insert(m_AllQueries.end(), std::begin(queries), std::end(queries));
+            m_FreeQueries.insert(m_FreeQueries.end(), std::begin(queries), std::end(queries));
+        }
+
+        auto query = m_FreeQueries.back();
+        m_FreeQueries.pop_back();
+        return query;
+    }
+
+    void GLProfiler::ReleaseQueries(PendingFrame &pending) {
+        for (auto &queries: pending.queries) {
+            if (!queries.elapsed) {
+                m_FreeQueries.push_back(queries.begin);
+            }
+
+            m_FreeQueries.push_back(queries.end);
+        }
+
+        pending.queries.clear();
+    }
+
+    void GLProfiler::BeginScope(const char *name) {
+        if (!m_Enabled) {
+            // keeps BeginScope / EndScope balanced when profiling is toggled inside a scope
+            m_OpenSamples.push_back(-1);
+            m_OpenQueries.push_back(-1);
+            return;
+        }
+
+        auto &caps = m_Backend->GetCapabilities();
+        auto &frame = m_Current.frame;
+
+        auto sample = static_cast<int>(frame.samples.size());
+        frame.samples.push_back({name, static_cast<int>(m_OpenSamples.size())});
+
+        int queries = -1;
+
+        if (caps.timestampQuery) {
+            queries = static_cast<int>(m_Current.queries.size());
+            m_Current.queries.push_back({sample, AcquireQuery(), AcquireQuery(), false});
+            glQueryCounter(m_Current.queries.back().begin, GL_TIMESTAMP);
+        } else if (caps.timerQuery && m_ElapsedScope < 0) {
+            queries = static_cast<int>(m_Current.queries.size());
+            m_Current.queries.push_back({sample, 0, AcquireQuery(), true});
+            glBeginQuery(GL_TIME_ELAPSED, m_Current.queries.back().end);
+            m_ElapsedScope = sample;
+        }
+
+        m_OpenSamples.push_back(sample);
+        m_OpenQueries.push_back(queries);
+
+        // taken last, so the CPU time does not include issuing the query
+        frame.samples[sample].cpuBeginNs = GL_ProfilerNow();
+    }
+
+    void GLProfiler::EndScope() {
+        if (m_OpenSamples.empty()) {
+            g_LoggerGLProfiler.Log(runtime::LOG_LEVEL_ERROR, "EndScope without a matching BeginScope!");
+            return;
+        }
+
+        auto now = GL_ProfilerNow();
+        auto sample = m_OpenSamples.back();
+        auto queries = m_OpenQueries.back();
+
+        m_OpenSamples.pop_back();
+        m_OpenQueries.pop_back();
+
+        if (sample < 0) {
+            return;
+        }
+
+        m_Current.frame.samples[sample].cpuEndNs = now;
+
+        if (queries < 0) {
+            return;
+        }
+
+        auto &pending = m_Current.queries[queries];
+
+        if (pending.elapsed) {
+            glEndQuery(GL_TIME_ELAPSED);
+            m_ElapsedScope = -1;
+        } else {
+            glQueryCounter(pending.end, GL_TIMESTAMP);
+        }
+
+        m_Current.lastQuery = pending.end;
+    }
+
+    void GLProfiler::EndFrame(uint64_t frameIndex, const GLFrameStats &stats) {
+        if (!m_OpenSamples.empty()) {
+            g_LoggerGLProfiler.Log(runtime::LOG_LEVEL_WARNING, "%zu profiler scopes were still open at the end of the frame.",
+                                   m_OpenSamples.size());
+
+            while (!m_OpenSamples.empty()) {
+                EndScope();
+            }
+        }
+
+        auto now = GL_ProfilerNow();
+        auto &caps = m_Backend->GetCapabilities();
+
+        if (caps.timestampQuery && (!m_Calibrated || ++m_FramesSinceCalibration >= GL_PROFILER_CALIBRATION_INTERVAL)) {
+            Calibrate();
+        }
+
+        m_Current.frame.frameIndex = frameIndex;
+        m_Current.frame.cpuEndNs = now;
+        m_Current.frame.stats = stats;
+
+        PendingFrame next;
+        next.frame.cpuBeginNs = now;
+        std::swap(next, m_Current);
+
+        // frames without queries still go through the queue, so the history stays in frame order
+        m_InFlight.push_back(std::move(next));
+
+        // reading the flag clears it. any frame in flight may overlap the disjoint operation, so all lose their
+        // GPU times
+        if (caps.disjointTimerQuery) {
+            GLint disjoint = 0;
+            glGetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint);
+
+            if (disjoint) {
+                for (auto &pending: m_InFlight) {
+                    pending.frame.gpuValid = false;
+                }
+            }
+        }
+
+        while (!m_InFlight.empty()) {
+            auto &oldest = m_InFlight.front();
+
+            if (!Resolve(oldest)) {
+                if (m_InFlight.size() <= MAX_FRAMES_IN_FLIGHT) {
+                    break;
+                }
+
+                // the GPU is too far behind; give up on the oldest frame instead of waiting for it
+                oldest.frame.gpuValid = false;
+            }
+
+            ReleaseQueries(oldest);
+            PushHistory(std::move(oldest.frame));
+            m_InFlight.pop_front();
+        }
+    }
+
+    bool GLProfiler::Resolve(PendingFrame &pending) {
+        if (pending.queries.empty()) {
+            return true;
+        }
+
+        // queries complete in submission order, so the last issued one being available covers the whole frame
+        GLuint available = GL_FALSE;
+        glGetQueryObjectuiv(pending.lastQuery, GL_QUERY_RESULT_AVAILABLE, &available);
+
+        if (!available) {
+            return false;
+        }
+
+        if (!pending.frame.gpuValid) {
+            return true;
+        }
+
+        for (auto &queries: pending.queries) {
+            auto &sample = pending.frame.samples[queries.sample];
+            GLuint64 end = 0;
+            glGetQueryObjectui64v(queries.end, GL_QUERY_RESULT, &end);
+
+            if (queries.elapsed) {
+                sample.gpuBeginNs = sample.cpuBeginNs;
+                sample.gpuEndNs = sample.cpuBeginNs + end;
+            } else {
+                GLuint64 begin = 0;
+                glGetQueryObjectui64v(queries.begin, GL_QUERY_RESULT, &begin);
+
+                sample.gpuBeginNs = static_cast<uint64_t>(static_cast<int64_t>(begin) + m_GpuClockOffset);
+                sample.gpuEndNs = static_cast<uint64_t>(static_cast<int64_t>(end) + m_GpuClockOffset);
+            }
+
+            sample.hasGpuTime = true;
+        }
+
+        return true;
+    }
+
+    void GLProfiler::Calibrate() {
+        // the current GPU time is returned without waiting for queued commands
+        GLint64 gpuTime = 0;
+        glGetInteger64v(GL_TIMESTAMP, &gpuTime);
+
+        m_GpuClockOffset = static_cast<int64_t>(GL_ProfilerNow()) - static_cast<int64_t>(gpuTime);
+        m_FramesSinceCalibration = 0;
+        m_Calibrated = true;
+    }
+
+    void GLProfiler::PushHistory(GLProfileFrame &&frame) {
+        m_History.push_back(std::move(frame));
+
+        while (m_History.size() > m_HistorySize) {
+            m_History.pop_front();
+        }
+    }
+
+    std::string GLProfiler::ToChromeTrace() const {
+        std::string out = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+        if (m_History.empty()) {
+            return out + "]}\n";
+        }
+
+        out += "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"CPU\"}}";
+        out += ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":2,\"args\":{\"name\":\"GPU\"}}";
+
+        auto origin = m_History.front().cpuBeginNs;
+        char buffer[512];
+
+        for (auto &frame: m_History) {
+            char name[32];
+            std::snprintf(name, sizeof(name), "Frame %" PRIu64, frame.frameIndex);
+            GL_AppendTraceEvent(out, name, 1, frame.cpuBeginNs, frame.cpuEndNs, origin, frame.frameIndex);
+
+            for (auto &sample: frame.samples) {
+                GL_AppendTraceEvent(out, sample.name, 1, sample.cpuBeginNs, sample.cpuEndNs, origin, frame.frameIndex);
+
+                // spans from before the first frame, or skewed by recalibration, would get negative times
+                if (frame.gpuValid && sample.hasGpuTime && sample.gpuBeginNs >= origin &&
+                    sample.gpuEndNs >= sample.gpuBeginNs) {
+                    GL_AppendTraceEvent(out, sample.name, 2, sample.gpuBeginNs, sample.gpuEndNs, origin,
+                                        frame.frameIndex);
+                }
+            }
+
+            auto &stats = frame.stats;
+            std::snprintf(buffer, sizeof(buffer),
+                          ",\n{\"name\":\"Frame stats\",\"ph\":\"C\",\"pid\":1,\"ts\":%.3f,\"args\":{"
+                          "\"drawCalls\":%" PRIu64 ",\"vertices\":%" PRIu64 ",\"programBinds\":%" PRIu64
+                          ",\"stateChanges\":%" PRIu64 ",\"bufferUploadBytes\":%" PRIu64
+                          ",\"textureUploadBytes\":%" PRIu64 ",\"streamBytes\":%" PRIu64
+                          ",\"textureStreamBytes\":%" PRIu64 "}}",
+                          static_cast<double>(frame.cpuBeginNs - origin) / 1000.0, stats.drawCalls, stats.vertices,
+                          stats.programBinds, stats.stateChanges, stats.bufferUploadBytes, stats.textureUploadBytes,
+                          stats.streamBytes, stats.textureStreamBytes);
+            out += buffer;
+        }
+
+        out += "\n]}\n";
+        return out;
+    }
+
+    bool GLProfiler::WriteChromeTrace(const std::filesystem::path &path) const {
+        std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+
+        if (!stream) {
+            g_LoggerGLProfiler.Log(runtime::LOG_LEVEL_ERROR, "Failed to open %s for writing!", path.string().c_str());
+            return false;
+        }
+
+        auto trace = ToChromeTrace();
+        stream.write(trace.data(), static_cast<std::streamsize>(trace.size()));
+
+        if (!stream) {
+            g_LoggerGLProfiler.Log(runtime::LOG_LEVEL_ERROR, "Failed to write the trace to %s!", path.string().c_str());
+            return false;
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,258 @@
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <system_error>
+#include <thread>
+
+#include <Engine/GLHeader.hpp>
+
+#include <Engine/Backend/OpenGL/GL_ProgramBinaryCache.hpp>
+
+#include <Engine/Runtime/Logger.hpp>
+
+namespace engine::backend::ogl {
+    static runtime::Logger g_LoggerGLProgramBinaryCache("GLProgramBinaryCache");
+
+    static constexpr uint32_t GL_PROGRAM_BINARY_MAGIC = 0x42505852; // "RXPB"
+
+    struct GLProgramBinaryHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t format;
+        uint32_t length;
+        uint64_t driverHash;
+        uint64_t key;
+    };
+
+    // FNV-1a; stable across runs and platforms, which std::hash is not guaranteed to be
+    uint64_t GL_HashBytes(uint64_t hash, const void *data, size_t size) {
+        auto bytes = static_cast<const unsigned char *>(data);
+
+        for (size_t i = 0; i < size; i++) {
+            hash ^= bytes[i];
+            hash *= 0x100000001b3ull;
+        }
+
+        return hash;
+    }
+
+    uint64_t GL_HashString(uint64_t hash, std::string_view str) {
+        // include the length so ("ab", "c") and ("a", "bc") do not collide
+        auto length = static_cast<uint64_t>(str.size());
+        hash = GL_HashBytes(hash, &length, sizeof(length));
+        return GL_HashBytes(hash, str.data(), str.size());
+    }
+
+    static std::string_view GL_GetDriverString(GLenum name) {
+        auto str = reinterpret_cast<const char *>(glGetString(name));
+        return str ? std::string_view(str) : std::string_view();
+    }
+
+    bool GLProgramBinaryCache::Initialize() {
+        m_Supported = false;
+        m_DirectoryOpen = false;
+
+#ifdef GL_WITH_LOADER
+        if (!glGetProgramBinary || !glProgramBinary || !glProgramParameteri) {
+            g_LoggerGLProgramBinaryCache.Log(runtime::LOG_LEVEL_INFO, "Program binaries are not supported by this context.");
+            return false;
+        }
+#endif
+
+        GLint formatCount = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+
+        if (formatCount <= 0) {
+            g_LoggerGLProgramBinaryCache.Log(runtime::LOG_LEVEL_INFO, "The driver exposes no program binary formats.");
+            return false;
+        }
+
+        m_DriverHash = 0xcbf29ce484222325ull;
+        m_DriverHash = GL_HashString(m_DriverHash, GL_GetDriverString(GL_VENDOR));
+        m_DriverHash = GL_HashString(m_DriverHash, GL_GetDriverString(GL_RENDERER));
+        m_DriverHash = GL_HashString(m_DriverHash, GL_GetDriverString(GL_VERSION));
+
+        m_Supported = true;
+
+        // a shared location such as the temp directory would mix binaries of different users and applications
+        if (m_Directory.empty()) {
+            g_LoggerGLProgramBinaryCache.Log(runtime::LOG_LEVEL_INFO,
+                                             "No program binary cache directory set, program binaries are not stored on disk.");
+            return true;
+        }
+
+        OpenDirectory();
+        return true;
+    }
+
+    bool GLProgramBinaryCache::SetDirectory(std::filesystem::path directory) {
+        m_Directory = std::move(directory);
+        m_DirectoryOpen = false;
+
+        if (!m_Supported || m_Directory.empty()) {
+            return false;
+        }
+
+        return OpenDirectory();
+    }
+
+    bool GLProgramBinaryCache::OpenDirectory() {
+        std::error_code ec;
+        std::filesystem::create_directories(m_Directory / ("v" + std::to_string(CACHE_VERSION)), ec);
+
+        if (ec) {
+            g_LoggerGLProgramBinaryCache.Log(runtime::LOG_LEVEL_WARNING, "Failed to create cache directory '%s': %s",
+                                             m_Directory.string().c_str(), ec.message().c_str());
+            return false;
+        }
+
+        m_DirectoryOpen = true;
+
+        g_LoggerGLProgramBinaryCache.Log(runtime::LOG_LEVEL_INFO, "Program binary cache enabled at '%s'.",
+                                         m_Directory.string().c_str());
+
+        return true;
+    }
+
+    uint64_t GLProgramBinaryCache::ComputeKey(std::span<const GLProgramSource> sources) const {
+        auto hash = GL_HashBytes(m_DriverHash, &CACHE_VERSION, sizeof(CACHE_VERSION));
+
+        // the same text compiled as a different stage links to a different program
+        for (auto &source: sources) {
+            hash = GL_HashBytes(hash, &source.stage, sizeof(source.stage));
+            hash = GL_HashString(hash, source.source);
+        }
+
+        // 0 is reserved for "no key"
+        return hash ? hash : 1;
+    }
+
+    std::filesystem::path GLProgramBinaryCache::GetEntryPath(uint64_t key) const {
+        char fileName[32];
+        snprintf(fileName, sizeof(fileName), "%016llx.bin", static_cast<unsigned long long>(key));
+
+        return m_Directory / ("v" + std::to_string(CACHE_VERSION)) / fileName;
+    }
+
+    std::vector<unsigned char> GLProgramBinaryCache::Capture(uint64_t key, unsigned int program) const {
+        GLint length = 0;
+        glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+
+        if (length <= 0) {
+            return {};
+        }
+
+        std::vector<unsigned char> blob(sizeof(GLProgramBinaryHeader) + length);
+
+        GLenum format = 0;
+        GLsizei written = 0;
+        glGetProgramBinary(program, length, &written, &format, blob.data() + sizeof(GLProgramBinaryHeader));
+
+        if (written <= 0) {
+            return {};
+        }
+
+        GLProgramBinaryHeader header{
+                GL_PROGRAM_BINARY_MAGIC,
+                CACHE_VERSION,
+                format,
+                static_cast<uint32_t>(written),
+                m_DriverHash,
+                key
+        };
+
+        std::memcpy(blob.data(), &header, sizeof(header));
+        blob.resize(sizeof(header) + written);
+
+        return blob;
+    }
+
+    bool GLProgramBinaryCache::Apply(std::span<const unsigned char> blob, uint64_t key, unsigned int program) const {
+        if (!m_Supported || blob.size() < sizeof(GLProgramBinaryHeader)) {
+            return false;
+        }
+
+        GLProgramBinaryHeader header;
+        std::memcpy(&header, blob.data(), sizeof(header));
+
+        if (header.magic != GL_PROGRAM_BINARY_MAGIC || header.version != CACHE_VERSION ||
+            header.driverHash != m_DriverHash || (key != 0 && header.key != key) ||
+            header.length != blob.size() - sizeof(header)) {
+            return false;
+        }
+
+        glProgramBinary(program, header.format, blob.data() + sizeof(header), static_cast<GLsizei>(header.length));
+
+        // drivers are allowed to reject binaries at any time (e.g. after an update); caller falls back to source
+        GLint linkStatus = GL_FALSE;
+        glGetProgramiv(program, GL_LINK_STATUS, &linkStatus);
+
+        return linkStatus == GL_TRUE;
+    }
+
+    bool GLProgramBinaryCache::Load(uint64_t key, unsigned int program) {
+        if (!m_DirectoryOpen) {
+            return false;
+        }
+
+        auto path = GetEntryPath(key);
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+
+        if (!file) {
+            return false;
+        }
+
+        std::vector<unsigned char> blob(static_cast<size_t>(file.tellg()));
+        file.seekg(0);
+        file.read(reinterpret_cast<char *>(blob.data()), static_cast<std::streamsize>(blob.size()));
+
+        if (!file || !Apply(blob, key, program)) {
+            g_LoggerGLProgramBinaryCache.Log(runtime::LOG_LEVEL_DEBUG, "Discarding stale cache entry '%s'.",
+                                             path.filename().string().c_str());
+            file.close();
+
+            std::error_code ec;
+            std::filesystem::remove(path, ec);
+            return false;
+        }
+
+        return true;
+    }
+
+    void GLProgramBinaryCache::Store(uint64_t key, unsigned int program) {
+        if (!m_DirectoryOpen) {
+            return;
+        }
+
+        auto blob = Capture(key, program);
+
+        if (blob.empty()) {
+            return;
+        }
+
+        // write to a temporary file first so a crash never leaves a truncated entry behind. the name is
+        // per thread because contexts rendering concurrently may store the same program at the same time.
+        auto path = GetEntryPath(key);
+        auto tempPath = path;
+        tempPath += "." + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) + ".tmp";
+
+        {
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char *>(blob.data()), static_cast<std::streamsize>(blob.size()));
+
+            if (!file) {
+                g_LoggerGLProgramBinaryCache.Log(runtime::LOG_LEVEL_WARNING, "Failed to write cache entry '%s'.",
+                                                 tempPath.string().c_str());
+                return;
+            }
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(tempPath, path, ec);
+
+        if (ec) {
+            std::filesystem::remove(tempPath, ec);
+        }
+    }
+}
@@ -0,0 +1,91 @@
+#include <algorithm>
+
+#include <Engine/Backend/OpenGL/GL_RangeAllocator.hpp>
+
+namespace engine::backend::ogl {
+    GLRangeAllocator::GLRangeAllocator(size_t capacity) {
+        Reset(capacity);
+    }
+
+    void GLRangeAllocator::Reset(size_t capacity) {
+        m_Capacity = capacity;
+        m_FreeSpace = capacity;
+        m_FreeBlocks.clear();
+
+        if (capacity > 0) {
+            m_FreeBlocks.emplace(0, capacity);
+        }
+    }
+
+    size_t GLRangeAllocator::Allocate(size_t size, size_t alignment) {
+        if (size == 0) {
+            return INVALID_OFFSET;
+        }
+
+        alignment = std::max<size_t>(alignment, 1);
+
+        for (auto it = m_FreeBlocks.begin(); it != m_FreeBlocks.end(); ++it) {
+            auto [blockOffset, blockSize] = *it;
+            auto alignedOffset = (blockOffset + alignment - 1) / alignment * alignment;
+            auto padding = alignedOffset - blockOffset;
+
+            if (blockSize < padding + size) {
+                continue;
+            }
+
+            m_FreeBlocks.erase(it);
+
+            // keep the alignment padding and the tail as separate free blocks
+            if (padding > 0) {
+                m_FreeBlocks.emplace(blockOffset, padding);
+            }
+
+            if (blockSize > padding + size) {
+                m_FreeBlocks.emplace(alignedOffset + size, blockSize - padding - size);
+            }
+
+            m_FreeSpace -= size;
+            return alignedOffset;
+        }
+
+        return INVALID_OFFSET;
+    }
+
+    void GLRangeAllocator::Free(size_t offset, size_t size) {
+        if (size == 0 || offset == INVALID_OFFSET) {
+            return;
+        }
+
+        m_FreeSpace += size;
+
+        auto next = m_FreeBlocks.lower_bound(offset);
+
+        // merge with the following block
+        if (next != m_FreeBlocks.end() && offset + size == next->first) {
+            size += next->second;
+            next = m_FreeBlocks.erase(next);
+        }
+
+        // merge with the preceding block
+        if (next != m_FreeBlocks.begin()) {
+            auto prev = std::prev(next);
+
+            if (prev->first + prev->second == offset) {
+                prev->second += size;
+                return;
+            }
+        }
+
+        m_FreeBlocks.emplace_hint(next, offset, size);
+    }
+
+    size_t GLRangeAllocator::GetLargestFreeBlock() const {
+        size_t largest = 0;
+
+        for (auto &[offset, size]: m_FreeBlocks) {
+            largest = std::max(largest, size);
+        }
+
+        return largest;
+    }
+}
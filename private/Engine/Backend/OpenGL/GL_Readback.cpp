@@ -0,0 +1,269 @@
+#include <algorithm>
+#include <cstring>
+
+#include <Engine/GLHeader.hpp>
+
+#include <Engine/Backend/OpenGL/GL_Backend.hpp>
+#include <Engine/Backend/OpenGL/GL_Readback.hpp>
+#include <Engine/Backend/OpenGL/GL_Texture.hpp>
+
+#include <Engine/Runtime/Logger.hpp>
+
+namespace engine::backend::ogl {
+    static runtime::Logger g_LoggerGLReadback("GLReadback");
+
+    static std::future<core::runtime::graphics::Bitmap> GL_MakeEmptyReadback() {
+        std::promise<core::runtime::graphics::Bitmap> promise;
+        promise.set_value({});
+        return promise.get_future();
+    }
+
+    GLReadback::GLReadback(GLBackend *backend, int stagingBufferCount) : m_Backend(backend) {
+        m_StagingBuffers.resize(std::max(stagingBufferCount, 1));
+    }
+
+    GLReadback::~GLReadback() {
+        if (m_Framebuffer || !m_Pending.empty()) {
+            g_LoggerGLReadback.Log(runtime::LOG_LEVEL_WARNING, "Readback was not destroyed before being released!");
+        }
+    }
+
+    void GLReadback::Destroy() {
+        WaitAll();
+
+        auto &stateCache = m_Backend->GetStateCache();
+
+        for (auto &staging: m_StagingBuffers) {
+            if (staging.handle) {
+                glDeleteBuffers(1, &staging.handle);
+                stateCache.OnBufferDeleted(staging.handle);
+            }
+
+            staging = {};
+        }
+
+        if (m_Framebuffer) {
+            glDeleteFramebuffers(1, &m_Framebuffer);
+            m_Framebuffer = 0;
+        }
+    }
+
+    int GLReadback::AcquireStagingBuffer(size_t size) {
+        int candidate = -1;
+
+        for (int i = 0; i < static_cast<int>(m_StagingBuffers.size()); i++) {
+            auto &staging = m_StagingBuffers[i];
+
+            if (staging.busy) {
+                continue;
+            }
+
+            if (staging.capacity >= size) {
+                candidate = i;
+                break;
+            }
+
+            // an idle buffer that is too small gets re-specified below
+            if (candidate < 0) {
+                candidate = i;
+            }
+        }
+
+        if (candidate < 0) {
+            candidate = static_cast<int>(m_StagingBuffers.size());
+            m_StagingBuffers.emplace_back();
+
+            g_LoggerGLReadback.Log(runtime::LOG_LEVEL_DEBUG, "All staging buffers in flight; growing the pool to %zu.",
+                                   m_StagingBuffers.size());
+        }
+
+        auto &staging = m_StagingBuffers[candidate];
+        auto &stateCache = m_Backend->GetStateCache();
+
+        if (!staging.handle) {
+            glGenBuffers(1, &staging.handle);
+        }
+
+        stateCache.BindBuffer(GL_PIXEL_PACK_BUFFER, staging.handle);
+
+        if (staging.capacity < size) {
+            glBufferData(GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(size), nullptr, GL_STREAM_READ);
+            staging.capacity = size;
+        }
+
+        staging.busy = true;
+        return candidate;
+    }
+
+    void GLReadback::Track(int staging, size_t size, GLReadbackCallback callback) {
+        Pending pending;
+        pending.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        pending.staging = staging;
+        pending.size = size;
+        pending.callback = std::move(callback);
+
+        m_Pending.emplace_back(std::move(pending));
+    }
+
+    std::future<core::runtime::graphics::Bitmap> GLReadback::ReadPixels(int x, int y, int width, int height, bool flipRows) {
+        auto rowSize = static_cast<size_t>(width) * sizeof(core::runtime::graphics::Color);
+        auto size = rowSize * height;
+        auto stagingIndex = AcquireStagingBuffer(size);
+
+        // the pack buffer is bound by AcquireStagingBuffer, so the pointer argument is an offset into it
+        glPixelStorei(GL_PACK_ALIGNMENT, 4);
+        glReadPixels(x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        m_Backend->GetStateCache().BindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+        // std::function needs a copyable target
+        auto promise = std::make_shared<std::promise<core::runtime::graphics::Bitmap>>();
+        auto future = promise->get_future();
+
+        Track(stagingIndex, size, [promise, width, height, rowSize, flipRows](std::span<const unsigned char> data) {
+            if (data.empty()) {
+                promise->set_value({});
+                return;
+            }
+
+            std::vector<core::runtime::graphics::Color> pixels(static_cast<size_t>(width) * height);
+            auto destination = reinterpret_cast<unsigned char *>(pixels.data());
+
+            if (flipRows) {
+                for (int row = 0; row < height; row++) {
+                    std::memcpy(destination + rowSize * (height - 1 - row), data.data() + rowSize * row, rowSize);
+                }
+            } else {
+                std::memcpy(destination, data.data(), data.size());
+            }
+
+            core::math::Vector2 size{static_cast<float>(width), static_cast<float>(height)};
+            promise->set_value(core::runtime::graphics::Bitmap(std::move(pixels), size));
+        });
+
+        return future;
+    }
+
+    void GLReadback::ReadBuffer(unsigned int buffer, size_t offset, size_t size, GLReadbackCallback callback) {
+        if (!buffer || size == 0) {
+            callback({});
+            return;
+        }
+
+        auto stagingIndex = AcquireStagingBuffer(size);
+        auto &stateCache = m_Backend->GetStateCache();
+
+        // copying on the GPU first keeps the source buffer free for further rendering
+        glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_PIXEL_PACK_BUFFER, static_cast<GLintptr>(offset), 0,
+                            static_cast<GLsizeiptr>(size));
+        stateCache.BindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+        Track(stagingIndex, size, std::move(callback));
+    }
+
+    std::future<core::runtime::graphics::Bitmap> GLReadback::ReadTexture(GLTexture &texture, int level) {
+        auto size = texture.GetSize();
+        auto width = std::max(static_cast<int>(size.x) >> level, 1);
+        auto height = std::max(static_cast<int>(size.y) >> level, 1);
+
+        if (texture.GetHandle() == -1 || level < 0 || level >= texture.GetMipLevels()) {
+            g_LoggerGLReadback.Log(runtime::LOG_LEVEL_ERROR, "Cannot read back level %d of this texture.", level);
+            return GL_MakeEmptyReadback();
+        }
+
+        GLint previousFramebuffer = 0;
+        glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &previousFramebuffer);
+
+        if (!m_Framebuffer) {
+            glGenFramebuffers(1, &m_Framebuffer);
+        }
+
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, m_Framebuffer);
+        glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture.GetHandle(), level);
+
+        std::future<core::runtime::graphics::Bitmap> future;
+
+        // compressed and other non-renderable formats cannot be attached
+        if (glCheckFramebufferStatus(GL_READ_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE) {
+            future = ReadPixels(0, 0, width, height, false);
+        } else {
+            g_LoggerGLReadback.Log(runtime::LOG_LEVEL_ERROR, "Texture %u cannot be attached for readback.", texture.GetHandle());
+            future = GL_MakeEmptyReadback();
+        }
+
+        // detach so the texture can be deleted without the framebuffer keeping it alive
+        glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, 0, 0);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<GLuint>(previousFramebuffer));
+
+        return future;
+    }
+
+    std::future<core::runtime::graphics::Bitmap> GLReadback::ReadFramebuffer(int x, int y, int width, int height) {
+        if (width <= 0 || height <= 0) {
+            return GL_MakeEmptyReadback();
+        }
+
+        GLint previousFramebuffer = 0;
+        glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &previousFramebuffer);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, m_Backend->GetDefaultFramebuffer());
+
+        // the default framebuffer's origin is the bottom left, and so is that of render targets
+        auto future = ReadPixels(x, y, width, height, true);
+
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<GLuint>(previousFramebuffer));
+        return future;
+    }
+
+    void GLReadback::Resolve(Pending &pending) {
+        auto &staging = m_StagingBuffers[pending.staging];
+        auto &stateCache = m_Backend->GetStateCache();
+
+        stateCache.BindBuffer(GL_PIXEL_PACK_BUFFER, staging.handle);
+        auto mapped = static_cast<const unsigned char *>(
+                glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, static_cast<GLsizeiptr>(pending.size), GL_MAP_READ_BIT));
+
+        if (mapped) {
+            pending.callback({mapped, pending.size});
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        } else {
+            g_LoggerGLReadback.Log(runtime::LOG_LEVEL_ERROR, "Failed to map a readback staging buffer!");
+            pending.callback({});
+        }
+
+        stateCache.BindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+        glDeleteSync(static_cast<GLsync>(pending.fence));
+        staging.busy = false;
+    }
+
+    void GLReadback::Poll() {
+        // readbacks complete in submission order, so stop at the first one that is still in flight
+        size_t resolved = 0;
+
+        for (; resolved < m_Pending.size(); resolved++) {
+            auto result = glClientWaitSync(static_cast<GLsync>(m_Pending[resolved].fence), GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+
+            if (result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED) {
+                break;
+            }
+
+            Resolve(m_Pending[resolved]);
+        }
+
+        m_Pending.erase(m_Pending.begin(), m_Pending.begin() + static_cast<std::ptrdiff_t>(resolved));
+    }
+
+    void GLReadback::WaitAll() {
+        for (auto &pending: m_Pending) {
+            GLenum result;
+
+            do {
+                result = glClientWaitSync(static_cast<GLsync>(pending.fence), GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+            } while (result == GL_TIMEOUT_EXPIRED);
+
+            Resolve(pending);
+        }
+
+        m_Pending.clear();
+    }
+}
@@ -0,0 +1,127 @@
+#include <algorithm>
+#include <climits>
+
+#include <Engine/Backend/OpenGL/GL_RectAllocator.hpp>
+
+namespace engine::backend::ogl {
+    GLRectAllocator::GLRectAllocator(int width, int height) {
+        Reset(width, height);
+    }
+
+    void GLRectAllocator::Reset(int width, int height) {
+        m_Width = std::max(width, 0);
+        m_Height = std::max(height, 0);
+        m_FreeArea = static_cast<int64_t>(m_Width) * m_Height;
+        m_FreeRects.clear();
+
+        if (m_FreeArea > 0) {
+            m_FreeRects.push_back({0, 0, m_Width, m_Height});
+        }
+    }
+
+    GLRect GLRectAllocator::Allocate(int width, int height) {
+        if (width <= 0 || height <= 0) {
+            return {};
+        }
+
+        // best short side fit: leaves the most usable leftover strips
+        size_t best = m_FreeRects.size();
+        int bestShortSide = INT_MAX;
+        int bestLongSide = INT_MAX;
+
+        for (size_t i = 0; i < m_FreeRects.size(); i++) {
+            auto &free = m_FreeRects[i];
+
+            if (free.width < width || free.height < height) {
+                continue;
+            }
+
+            auto leftoverX = free.width - width;
+            auto leftoverY = free.height - height;
+            auto shortSide = std::min(leftoverX, leftoverY);
+            auto longSide = std::max(leftoverX, leftoverY);
+
+            if (shortSide < bestShortSide || (shortSide == bestShortSide && longSide < bestLongSide)) {
+                best = i;
+                bestShortSide = shortSide;
+                bestLongSide = longSide;
+            }
+        }
+
+        if (best == m_FreeRects.size()) {
+            return {};
+        }
+
+        auto free = m_FreeRects[best];
+        m_FreeRects[best] = m_FreeRects.back();
+        m_FreeRects.pop_back();
+
+        GLRect rect{free.x, free.y, width, height};
+
+        // split along the shorter leftover axis so the larger remainder stays in one piece
+        auto leftoverX = free.width - width;
+        auto leftoverY = free.height - height;
+
+        GLRect right, bottom;
+
+        if (leftoverX < leftoverY) {
+            right = {free.x + width, free.y, leftoverX, height};
+            bottom = {free.x, free.y + height, free.width, leftoverY};
+        } else {
+            right = {free.x + width, free.y, leftoverX, free.height};
+            bottom = {free.x, free.y + height, width, leftoverY};
+        }
+
+        if (right.IsValid()) {
+            m_FreeRects.push_back(right);
+        }
+
+        if (bottom.IsValid()) {
+            m_FreeRects.push_back(bottom);
+        }
+
+        m_FreeArea -= static_cast<int64_t>(width) * height;
+        return rect;
+    }
+
+    void GLRectAllocator::Free(const GLRect &rect) {
+        if (!rect.IsValid()) {
+            return;
+        }
+
+        m_FreeArea += static_cast<int64_t>(rect.width) * rect.height;
+        m_FreeRects.push_back(rect);
+
+        MergeFreeRects();
+    }
+
+    void GLRectAllocator::MergeFreeRects() {
+        bool merged = true;
+
+        while (merged) {
+            merged = false;
+
+            for (size_t i = 0; i < m_FreeRects.size() && !merged; i++) {
+                for (size_t j = i + 1; j < m_FreeRects.size(); j++) {
+                    auto &a = m_FreeRects[i];
+                    auto &b = m_FreeRects[j];
+
+                    if (a.y == b.y && a.height == b.height && (a.x + a.width == b.x || b.x + b.width == a.x)) {
+                        a.x = std::min(a.x, b.x);
+                        a.width += b.width;
+                    } else if (a.x == b.x && a.width == b.width && (a.y + a.height == b.y || b.y + b.height == a.y)) {
+                        a.y = std::min(a.y, b.y);
+                        a.height += b.height;
+                    } else {
+                        continue;
+                    }
+
+                    m_FreeRects[j] = m_FreeRects.back();
+                    m_FreeRects.pop_back();
+                    merged = true;
+                    break;
+                }
+            }
+        }
+    }
+}
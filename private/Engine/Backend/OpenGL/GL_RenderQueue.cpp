@@ -0,0 +1,204 @@
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#include <Engine/Backend/OpenGL/GL_Backend.hpp>
+#include <Engine/Backend/OpenGL/GL_RenderQueue.hpp>
+#include <Engine/Backend/OpenGL/GL_ShaderProgram.hpp>
+#include <Engine/Backend/OpenGL/GL_VertexBuffer.hpp>
+
+namespace engine::backend::ogl {
+    static constexpr uint32_t GL_QUEUE_PROGRAM_BITS = 14;
+    static constexpr uint32_t GL_QUEUE_TEXTURE_BITS = 14;
+    static constexpr uint32_t GL_QUEUE_BUFFER_BITS = 11;
+    static constexpr uint32_t GL_QUEUE_DEPTH_BITS = 16;
+
+    // the sign, exponent and top mantissa bits; for non-negative floats the bit pattern orders like the value
+    static uint64_t GL_QuantizeDepth(float depth) {
+        if (!(depth > 0.f)) {
+            return 0;
+        }
+
+        uint32_t bits;
+        std::memcpy(&bits, &depth, sizeof(bits));
+        return bits >> (32 - GL_QUEUE_DEPTH_BITS);
+    }
+
+    void GL_RadixSort(const std::vector<uint64_t> &keys, std::vector<uint32_t> &order, std::vector<uint32_t> &scratch) {
+        auto count = keys.size();
+
+        order.resize(count);
+        scratch.resize(count);
+
+        for (uint32_t i = 0; i < count; i++) {
+            order[i] = i;
+        }
+
+        if (count < 2) {
+            return;
+        }
+
+        // one pass over the keys builds the histograms of all eight digits
+        std::array<std::array<uint32_t, 256>, 8> histograms{};
+
+        for (auto key: keys) {
+            for (int digit = 0; digit < 8; digit++) {
+                histograms[digit][(key >> (digit * 8)) & 0xFF]++;
+            }
+        }
+
+        auto *source = &order;
+        auto *destination = &scratch;
+
+        for (int digit = 0; digit < 8; digit++) {
+            auto &histogram = histograms[digit];
+            auto shift = digit * 8;
+
+            // every key has the same digit here, so the pass would not change the order
+            if (histogram[(keys[0] >> shift) & 0xFF] == count) {
+                continue;
+            }
+
+            uint32_t offset = 0;
+
+            for (auto &bucket: histogram) {
+                auto size = bucket;
+                bucket = offset;
+                offset += size;
+            }
+
+            for (auto index: *source) {
+                (*destination)[histogram[(keys[index] >> shift) & 0xFF]++] = index;
+            }
+
+            std::swap(source, destination);
+        }
+
+        if (source != &order) {
+            order.swap(scratch);
+        }
+    }
+
+    uint32_t GLRenderQueue::GetId(std::unordered_map<const void *, uint32_t> &ids, const void *object, uint32_t bits) {
+        auto limit = (1u << bits) - 1;
+        auto id = ids.try_emplace(object, static_cast<uint32_t>(ids.size())).first->second;
+        return std::min(id, limit);
+    }
+
+    void GLRenderQueue::Add(const GLDrawItem &item) {
+        if (!item.program || !item.buffer) {
+            return;
+        }
+
+        uint64_t program = GetId(m_ProgramIds, item.program, GL_QUEUE_PROGRAM_BITS);
+        uint64_t texture = GetId(m_TextureIds, item.texture, GL_QUEUE_TEXTURE_BITS);
+        uint64_t buffer = GetId(m_BufferIds, item.buffer, GL_QUEUE_BUFFER_BITS);
+        uint64_t depth = GL_QuantizeDepth(item.depth);
+
+        uint64_t key = static_cast<uint64_t>(item.layer) << 56;
+
+        // 55 bits below the layer and translucency bit: 14 + 14 + 11 + 16
+        if (item.translucent) {
+            auto farFirst = (~depth) & ((1u << GL_QUEUE_DEPTH_BITS) - 1);
+            key |= uint64_t(1) << 55;
+            key |= farFirst << 39 | program << 25 | texture << 11 | buffer;
+        } else {
+            key |= program << 41 | texture << 27 | buffer << 16 | depth;
+        }
+
+        m_Items.push_back(item);
+        m_Keys.push_back(key);
+    }
+
+    void GLRenderQueue::Submit() {
+        GLRenderQueueStats stats;
+        stats.draws = m_Items.size();
+
+        if (m_Items.empty()) {
+            m_LastStats = stats;
+            return;
+        }
+
+        const GLDrawItem *previous = nullptr;
+
+        for (auto &item: m_Items) {
+            stats.unsortedProgramSwitches += !previous || previous->program != item.program;
+            stats.unsortedTextureSwitches += item.texture && (!previous || previous->texture != item.texture);
+            stats.unsortedBufferSwitches += !previous || previous->buffer != item.buffer;
+            previous = &item;
+        }
+
+        GL_RadixSort(m_Keys, m_Order, m_Scratch);
+
+        auto blendingWasActive =
+                (m_Backend->GetActiveFeatures() & core::runtime::graphics::BACKEND_FEATURE_ALPHA_BLENDING) != 0;
+        auto blending = blendingWasActive;
+
+        GLShaderProgram *program = nullptr;
+        core::runtime::graphics::ITexture *texture = nullptr;
+        int textureSlot = -1;
+        GLVertexBuffer *buffer = nullptr;
+
+        for (auto index: m_Order) {
+            auto &item = m_Items[index];
+
+            if (item.translucent != blending) {
+                blending = item.translucent;
+
+                if (blending) {
+                    m_Backend->EnableFeatures(core::runtime::graphics::BACKEND_FEATURE_ALPHA_BLENDING);
+                } else {
+                    m_Backend->DisableFeatures(core::runtime::graphics::BACKEND_FEATURE_ALPHA_BLENDING);
+                }
+            }
+
+            if (item.program != program) {
+                program = item.program;
+                program->Bind();
+                stats.programSwitches++;
+            }
+
+            if (item.texture && (item.texture != texture || item.textureSlot != textureSlot)) {
+                texture = item.texture;
+                textureSlot = item.textureSlot;
+                texture->Bind(textureSlot);
+                stats.textureSwitches++;
+            }
+
+            if (item.buffer != buffer) {
+                buffer = item.buffer;
+                stats.bufferSwitches++;
+            }
+
+            if (item.transformUniform.IsValid()) {
+                program->SetUniform(item.transformUniform, item.transform);
+            }
+
+            if (item.indexCount > 0) {
+                buffer->DrawIndexedRange(item.firstIndex, item.indexCount, item.baseVertex);
+            } else if (item.instanced) {
+                buffer->DrawInstanced();
+            } else {
+                buffer->Draw();
+            }
+        }
+
+        if (blending != blendingWasActive) {
+            if (blendingWasActive) {
+                m_Backend->EnableFeatures(core::runtime::graphics::BACKEND_FEATURE_ALPHA_BLENDING);
+            } else {
+                m_Backend->DisableFeatures(core::runtime::graphics::BACKEND_FEATURE_ALPHA_BLENDING);
+            }
+        }
+
+        m_LastStats = stats;
+    }
+
+    void GLRenderQueue::Clear() {
+        m_Items.clear();
+        m_Keys.clear();
+        m_ProgramIds.clear();
+        m_TextureIds.clear();
+        m_BufferIds.clear();
+    }
+}
@@ -0,0 +1,94 @@
+#include <Engine/GLHeader.hpp>
+
+#include <Engine/Backend/OpenGL/GL_Backend.hpp>
+#include <Engine/Backend/OpenGL/GL_RenderTarget.hpp>
+
+#include <Engine/Runtime/Logger.hpp>
+
+namespace engine::backend::ogl {
+    static runtime::Logger g_LoggerGLRenderTarget("GLRenderTarget");
+
+    GLRenderTarget::GLRenderTarget(GLBackend *backend, int width, int height)
+            : m_Backend(backend), m_Width(width), m_Height(height) {}
+
+    GLRenderTarget::~GLRenderTarget() {
+        if (m_FboHandle) {
+            g_LoggerGLRenderTarget.Log(runtime::LOG_LEVEL_WARNING, "Render target was not destroyed before being released!");
+        }
+    }
+
+    bool GLRenderTarget::Create() {
+        if (m_FboHandle) {
+            return true;
+        }
+
+        if (m_Width <= 0 || m_Height <= 0) {
+            g_LoggerGLRenderTarget.Log(runtime::LOG_LEVEL_ERROR, "Invalid render target size %dx%d!", m_Width, m_Height);
+            return false;
+        }
+
+        auto &stateCache = m_Backend->GetStateCache();
+
+        glGenTextures(1, &m_ColorHandle);
+        stateCache.BindTexture(GL_TEXTURE_2D, m_ColorHandle);
+
+        if (m_Backend->GetCapabilities().textureStorage) {
+            glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, m_Width, m_Height);
+        } else {
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_Width, m_Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        }
+
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+
+        glGenRenderbuffers(1, &m_DepthHandle);
+        glBindRenderbuffer(GL_RENDERBUFFER, m_DepthHandle);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, m_Width, m_Height);
+        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+        glGenFramebuffers(1, &m_FboHandle);
+        glBindFramebuffer(GL_FRAMEBUFFER, m_FboHandle);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_ColorHandle, 0);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_DepthHandle);
+
+        auto status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+
+        if (status != GL_FRAMEBUFFER_COMPLETE) {
+            g_LoggerGLRenderTarget.Log(runtime::LOG_LEVEL_ERROR, "Render target framebuffer is incomplete (0x%x)!", status);
+            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            Destroy();
+            return false;
+        }
+
+        g_LoggerGLRenderTarget.Log(runtime::LOG_LEVEL_DEBUG, "Created %dx%d render target.", m_Width, m_Height);
+        return true;
+    }
+
+    void GLRenderTarget::Destroy() {
+        if (m_FboHandle) {
+            glDeleteFramebuffers(1, &m_FboHandle);
+            m_FboHandle = 0;
+        }
+
+        if (m_DepthHandle) {
+            glDeleteRenderbuffers(1, &m_DepthHandle);
+            m_DepthHandle = 0;
+        }
+
+        if (m_ColorHandle) {
+            glDeleteTextures(1, &m_ColorHandle);
+            m_Backend->GetStateCache().OnTextureDeleted(m_ColorHandle);
+            m_ColorHandle = 0;
+        }
+    }
+
+    void GLRenderTarget::Bind() {
+        if (!m_FboHandle && !Create()) {
+            return;
+        }
+
+        glBindFramebuffer(GL_FRAMEBUFFER, m_FboHandle);
+        m_Backend->GetStateCache().SetViewport(0, 0, m_Width, m_Height);
+    }
+}
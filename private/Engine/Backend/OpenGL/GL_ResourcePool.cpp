@@ -0,0 +1,207 @@
+#include <algorithm>
+
+#include <Engine/GLHeader.hpp>
+
+#include <Engine/Backend/OpenGL/GL_Backend.hpp>
+#include <Engine/Backend/OpenGL/GL_ResourcePool.hpp>
+#include <Engine/Backend/OpenGL/GL_TextureFormat.hpp>
+
+#include <Engine/Runtime/Logger.hpp>
+
+namespace engine::backend::ogl {
+    static runtime::Logger g_LoggerGLResourcePool("GLResourcePool");
+
+    // the whole mip chain; formats the backend does not know as compressed are RGBA8
+    static size_t GL_GetTextureStorageSize(unsigned int internalFormat, int width, int height, int levels) {
+        size_t bytes = 0;
+
+        for (int level = 0; level < levels; level++) {
+            auto levelWidth = std::max(width >> level, 1);
+            auto levelHeight = std::max(height >> level, 1);
+
+            if (GL_GetCompressedFormatInfo(internalFormat).IsValid()) {
+                bytes += GL_GetCompressedImageSize(internalFormat, levelWidth, levelHeight);
+            } else {
+                bytes += static_cast<size_t>(levelWidth) * static_cast<size_t>(levelHeight) * 4;
+            }
+        }
+
+        return bytes;
+    }
+
+    GLResourcePool::~GLResourcePool() {
+        if (!m_Buffers.empty() || !m_Textures.empty()) {
+            g_LoggerGLResourcePool.Log(runtime::LOG_LEVEL_WARNING, "Resource pool was not destroyed before being released!");
+        }
+    }
+
+    void GLResourcePool::Destroy() {
+        for (auto &buffer: m_Buffers) {
+            DeleteBuffer(buffer.second.handle);
+        }
+
+        for (auto &texture: m_Textures) {
+            DeleteTexture(texture.second.handle);
+        }
+
+        m_Buffers.clear();
+        m_Textures.clear();
+        m_PooledBytes = 0;
+
+        auto &buffers = m_Names[static_cast<int>(GLNameType::NAME_BUFFER)];
+        auto &vertexArrays = m_Names[static_cast<int>(GLNameType::NAME_VERTEX_ARRAY)];
+        auto &textures = m_Names[static_cast<int>(GLNameType::NAME_TEXTURE)];
+
+        if (!buffers.empty()) {
+            glDeleteBuffers(static_cast<GLsizei>(buffers.size()), buffers.data());
+        }
+
+        if (!vertexArrays.empty()) {
+            glDeleteVertexArrays(static_cast<GLsizei>(vertexArrays.size()), vertexArrays.data());
+        }
+
+        if (!textures.empty()) {
+            glDeleteTextures(static_cast<GLsizei>(textures.size()), textures.data());
+        }
+
+        for (auto &names: m_Names) {
+            names.clear();
+        }
+    }
+
+    unsigned int GLResourcePool::GenName(GLNameType type) {
+        auto &names = m_Names[static_cast<int>(type)];
+
+        if (names.empty()) {
+            names.resize(NAME_BATCH);
+
+            switch (type) {
+                case GLNameType::NAME_BUFFER:
+                    glGenBuffers(NAME_BATCH, names.data());
+                    break;
+                case GLNameType::NAME_VERTEX_ARRAY:
+                    glGenVertexArrays(NAME_BATCH, names.data());
+                    break;
+                case GLNameType::NAME_TEXTURE:
+                    glGenTextures(NAME_BATCH, names.data());
+                    break;
+            }
+        }
+
+        auto name = names.back();
+        names.pop_back();
+        return name;
+    }
+
+    void GLResourcePool::ReleaseName(GLNameType type, unsigned int name) {
+        if (name != 0) {
+            m_Names[static_cast<int>(type)].push_back(name);
+        }
+    }
+
+    unsigned int GLResourcePool::AcquireBuffer(size_t size, unsigned int usage, size_t &capacity) {
+        if (size == 0) {
+            return 0;
+        }
+
+        auto limit = size + size / 4;
+
+        for (auto it = m_Buffers.lower_bound(size); it != m_Buffers.end() && it->first <= limit; ++it) {
+            if (it->second.usage != usage) {
+                continue;
+            }
+
+            auto buffer = it->second.handle;
+            capacity = it->first;
+            m_PooledBytes -= capacity;
+            m_Buffers.erase(it);
+
+            m_Backend->GetCurrentFrameStats().objectsRecycled++;
+            return buffer;
+        }
+
+        return 0;
+    }
+
+    void GLResourcePool::RecycleBuffer(unsigned int buffer, size_t capacity, unsigned int usage) {
+        if (buffer == 0) {
+            return;
+        }
+
+        if (capacity == 0 || m_PooledBytes + capacity > m_Budget) {
+            DeleteBuffer(buffer);
+            return;
+        }
+
+        m_Buffers.emplace(capacity, PooledBuffer{buffer, usage, m_Backend->GetFrameIndex()});
+        m_PooledBytes += capacity;
+    }
+
+    unsigned int GLResourcePool::AcquireTexture(unsigned int internalFormat, int width, int height, int levels) {
+        auto it = m_Textures.find(TextureKey{internalFormat, width, height, levels});
+
+        if (it == m_Textures.end()) {
+            return 0;
+        }
+
+        auto texture = it->second.handle;
+        m_PooledBytes -= it->second.bytes;
+        m_Textures.erase(it);
+
+        m_Backend->GetCurrentFrameStats().objectsRecycled++;
+        return texture;
+    }
+
+    void GLResourcePool::RecycleTexture(unsigned int texture, unsigned int internalFormat, int width, int height,
+                                        int levels) {
+        if (texture == 0) {
+            return;
+        }
+
+        auto bytes = GL_GetTextureStorageSize(internalFormat, width, height, levels);
+
+        if (m_PooledBytes + bytes > m_Budget) {
+            DeleteTexture(texture);
+            return;
+        }
+
+        m_Textures.emplace(TextureKey{internalFormat, width, height, levels},
+                           PooledTexture{texture, bytes, m_Backend->GetFrameIndex()});
+        m_PooledBytes += bytes;
+    }
+
+    void GLResourcePool::Update() {
+        auto frame = m_Backend->GetFrameIndex();
+
+        // besides the idle objects, a lowered budget drops objects in map order until the pool fits in it
+        for (auto it = m_Buffers.begin(); it != m_Buffers.end();) {
+            if (frame > it->second.frame + MAX_IDLE_FRAMES || m_PooledBytes > m_Budget) {
+                DeleteBuffer(it->second.handle);
+                m_PooledBytes -= it->first;
+                it = m_Buffers.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        for (auto it = m_Textures.begin(); it != m_Textures.end();) {
+            if (frame > it->second.frame + MAX_IDLE_FRAMES || m_PooledBytes > m_Budget) {
+                DeleteTexture(it->second.handle);
+                m_PooledBytes -= it->second.bytes;
+                it = m_Textures.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    void GLResourcePool::DeleteBuffer(unsigned int buffer) {
+        glDeleteBuffers(1, &buffer);
+        m_Backend->GetStateCache().OnBufferDeleted(buffer);
+    }
+
+    void GLResourcePool::DeleteTexture(unsigned int texture) {
+        glDeleteTextures(1, &texture);
+        m_Backend->GetStateCache().OnTextureDeleted(texture);
+    }
+}
@@ -0,0 +1,99 @@
+#include <algorithm>
+#include <cmath>
+
+#include <Engine/GLHeader.hpp>
+
+#include <Engine/Backend/OpenGL/GL_Backend.hpp>
+#include <Engine/Backend/OpenGL/GL_SamplerCache.hpp>
+
+#include <Engine/Runtime/Logger.hpp>
+
+#ifndef GL_TEXTURE_MAX_ANISOTROPY
+#define GL_TEXTURE_MAX_ANISOTROPY 0x84FE
+#endif
+
+namespace engine::backend::ogl {
+    static runtime::Logger g_LoggerGLSamplerCache("GLSamplerCache");
+
+    static GLint GL_MapMinFilter(GLTextureFilter filter) {
+        switch (filter) {
+            case GLTextureFilter::FILTER_NEAREST:
+                return GL_NEAREST_MIPMAP_NEAREST;
+            case GLTextureFilter::FILTER_TRILINEAR:
+                return GL_LINEAR_MIPMAP_LINEAR;
+            default:
+                return GL_LINEAR_MIPMAP_NEAREST;
+        }
+    }
+
+    static GLint GL_MapWrap(GLTextureWrap wrap) {
+        switch (wrap) {
+            case GLTextureWrap::WRAP_REPEAT:
+                return GL_REPEAT;
+            case GLTextureWrap::WRAP_MIRROR:
+                return GL_MIRRORED_REPEAT;
+            default:
+                return GL_CLAMP_TO_EDGE;
+        }
+    }
+
+    // whole anisotropy steps are plenty; keeps near-identical descriptions on one sampler
+    static int GL_QuantizeAnisotropy(float anisotropy, float maxAnisotropy) {
+        return static_cast<int>(std::lround(std::clamp(anisotropy, 1.f, std::max(maxAnisotropy, 1.f))));
+    }
+
+    unsigned int GLSamplerCache::Get(const GLSamplerDesc &desc) {
+        auto anisotropy = GL_QuantizeAnisotropy(desc.anisotropy, m_Backend->GetCapabilities().maxAnisotropy);
+        auto key = static_cast<uint32_t>(desc.filter) |
+                   (static_cast<uint32_t>(desc.wrapS) << 4) |
+                   (static_cast<uint32_t>(desc.wrapT) << 8) |
+                   (static_cast<uint32_t>(anisotropy) << 12);
+
+        if (auto it = m_Samplers.find(key); it != m_Samplers.end()) {
+            return it->second;
+        }
+
+        GLuint sampler = 0;
+        glGenSamplers(1, &sampler);
+
+        // mipmapped min filters behave like their base filter on textures without mips
+        glSamplerParameteri(sampler, GL_TEXTURE_MIN_FILTER, GL_MapMinFilter(desc.filter));
+        glSamplerParameteri(sampler, GL_TEXTURE_MAG_FILTER,
+                            desc.filter == GLTextureFilter::FILTER_NEAREST ? GL_NEAREST : GL_LINEAR);
+        glSamplerParameteri(sampler, GL_TEXTURE_WRAP_S, GL_MapWrap(desc.wrapS));
+        glSamplerParameteri(sampler, GL_TEXTURE_WRAP_T, GL_MapWrap(desc.wrapT));
+
+        if (anisotropy > 1) {
+            glSamplerParameterf(sampler, GL_TEXTURE_MAX_ANISOTROPY, static_cast<float>(anisotropy));
+        }
+
+        g_LoggerGLSamplerCache.Log(runtime::LOG_LEVEL_DEBUG, "Created sampler %u (key 0x%05X).", sampler, key);
+
+        m_Samplers.emplace(key, sampler);
+        return sampler;
+    }
+
+    void GLSamplerCache::Destroy() {
+        auto &stateCache = m_Backend->GetStateCache();
+
+        for (auto &[key, sampler]: m_Samplers) {
+            glDeleteSamplers(1, &sampler);
+            stateCache.OnSamplerDeleted(sampler);
+        }
+
+        m_Samplers.clear();
+    }
+
+    void GLSamplerCache::ApplyToTexture(unsigned int target, const GLSamplerDesc &desc, float maxAnisotropy) {
+        auto anisotropy = GL_QuantizeAnisotropy(desc.anisotropy, maxAnisotropy);
+
+        glTexParameteri(target, GL_TEXTURE_MIN_FILTER, GL_MapMinFilter(desc.filter));
+        glTexParameteri(target, GL_TEXTURE_MAG_FILTER, desc.filter == GLTextureFilter::FILTER_NEAREST ? GL_NEAREST : GL_LINEAR);
+        glTexParameteri(target, GL_TEXTURE_WRAP_S, GL_MapWrap(desc.wrapS));
+        glTexParameteri(target, GL_TEXTURE_WRAP_T, GL_MapWrap(desc.wrapT));
+
+        if (anisotropy > 1) {
+            glTexParameterf(target, GL_TEXTURE_MAX_ANISOTROPY, static_cast<float>(anisotropy));
+        }
+    }
+}
@@ -3,6 +3,7 @@
 #include <vector>
 
 #include <Engine/GLHeader.hpp>
+#include <Engine/Backend/OpenGL/GL_Backend.hpp>
 #include <Engine/Backend/OpenGL/GL_Shader.hpp>
 
 #include <Engine/Runtime/Logger.hpp>
@@ -29,6 +30,7 @@ namespace engine::backend::ogl {
         }
 
         glCompileShader(m_ShaderHandle);
+        m_CompileSubmitted = true;
 
         GLint compileStatus = GL_FALSE;
         glGetShaderiv(m_ShaderHandle, GL_COMPILE_STATUS, &compileStatus);
@@ -40,6 +42,7 @@ namespace engine::backend::ogl {
         if (m_ShaderHandle != -1) {
             glDeleteShader(m_ShaderHandle);
             m_ShaderHandle = -1;
+            m_CompileSubmitted = false;
         }
     }
 
@@ -48,8 +51,21 @@ namespace engine::backend::ogl {
             m_ShaderHandle = glCreateShader(GL_MapShaderType(type));
         }
 
-        const char *sourceCStr = source.data();
+        m_Type = type;
+        m_Source.assign(source);
+
+        const char *sourceCStr = m_Source.c_str();
         glShaderSource(m_ShaderHandle, 1, &sourceCStr, nullptr);
+        m_CompileSubmitted = false;
+    }
+
+    void GLShader::SubmitCompile() {
+        if (m_ShaderHandle == -1 || m_CompileSubmitted) {
+            return;
+        }
+
+        glCompileShader(m_ShaderHandle);
+        m_CompileSubmitted = true;
     }
 
     std::string GLShader::GetSource() {
@@ -102,4 +118,31 @@ namespace engine::backend::ogl {
         return compileStatus == GL_TRUE;
     }
 
+    bool GLShader::UseCompiledShader(const std::span<unsigned char> &data, core::runtime::graphics::ShaderType type) {
+        if (!m_Backend->GetProgramBinaryCache().IsSupported()) {
+            g_LoggerGLShader.Log(runtime::LOG_LEVEL_ERROR, "Compiled shaders are not supported by this context.");
+            return false;
+        }
+
+        if (data.empty()) {
+            return false;
+        }
+
+        m_Type = type;
+        m_CompiledBinary.assign(data.begin(), data.end());
+
+        return true;
+    }
+
+    std::span<unsigned char> GLShader::GetCompiledShader() {
+        return m_CompiledBinary;
+    }
+
+    core::runtime::graphics::ShaderCapsFlags GLShader::GetImplCapabilities() const {
+        if (m_Backend->GetProgramBinaryCache().IsSupported()) {
+            return core::runtime::graphics::ShaderCapsFlags::SHADER_CAPS_PRECOMPILED;
+        }
+
+        return core::runtime::graphics::ShaderCapsFlags::SHADER_CAPS_NONE;
+    }
 }
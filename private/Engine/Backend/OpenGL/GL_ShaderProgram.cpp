@@ -1,5 +1,10 @@
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
 #include <Engine/GLHeader.hpp>
 
+#include <Engine/Backend/OpenGL/GL_Backend.hpp>
 #include <Engine/Backend/OpenGL/GL_Shader.hpp>
 #include <Engine/Backend/OpenGL/GL_ShaderProgram.hpp>
 
@@ -7,12 +12,138 @@
 
 namespace engine::backend::ogl {
     static runtime::Logger g_LoggerGLShaderProgram("GLShaderProgram");
-    
+
+    // whether the source declares the uniform block with a binding in its layout qualifier
+    static bool GL_HasExplicitBlockBinding(std::string_view source, std::string_view blockName) {
+        auto isIdentifier = [](char c) {
+            return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+        };
+
+        for (auto pos = source.find(blockName); pos != std::string_view::npos; pos = source.find(blockName, pos + 1)) {
+            auto end = pos + blockName.size();
+
+            if ((pos > 0 && isIdentifier(source[pos - 1])) || (end < source.size() && isIdentifier(source[end]))) {
+                continue;
+            }
+
+            // the declaration starts after the previous statement or block
+            auto start = pos > 0 ? source.find_last_of(";}", pos - 1) : std::string_view::npos;
+            start = start == std::string_view::npos ? 0 : start + 1;
+
+            auto declaration = source.substr(start, pos - start);
+
+            if (declaration.find("uniform") != std::string_view::npos &&
+                declaration.find("binding") != std::string_view::npos) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // size in bytes of a single element of the given uniform type, as seen by the glUniform* family
+    size_t GL_GetUniformElementSize(GLenum type) {
+        switch (type) {
+            case GL_FLOAT:
+            case GL_INT:
+            case GL_UNSIGNED_INT:
+            case GL_BOOL:
+                return 4;
+            case GL_FLOAT_VEC2:
+            case GL_INT_VEC2:
+            case GL_UNSIGNED_INT_VEC2:
+            case GL_BOOL_VEC2:
+                return 8;
+            case GL_FLOAT_VEC3:
+            case GL_INT_VEC3:
+            case GL_UNSIGNED_INT_VEC3:
+            case GL_BOOL_VEC3:
+                return 12;
+            case GL_FLOAT_VEC4:
+            case GL_INT_VEC4:
+            case GL_UNSIGNED_INT_VEC4:
+            case GL_BOOL_VEC4:
+            case GL_FLOAT_MAT2:
+                return 16;
+            case GL_FLOAT_MAT2x3:
+            case GL_FLOAT_MAT3x2:
+                return 24;
+            case GL_FLOAT_MAT2x4:
+            case GL_FLOAT_MAT4x2:
+                return 32;
+            case GL_FLOAT_MAT3:
+                return 36;
+            case GL_FLOAT_MAT3x4:
+            case GL_FLOAT_MAT4x3:
+                return 48;
+            case GL_FLOAT_MAT4:
+                return 64;
+            default:
+                // samplers and images are set through glUniform1i
+                return 4;
+        }
+    }
+
+    // whether the glUniform* call that uploads values of valueType may set a uniform of the given type.
+    // bools take ints and floats alike; samplers and images only take ints.
+    static bool GL_IsUniformTypeCompatible(GLenum uniformType, GLenum valueType) {
+        if (uniformType == valueType) {
+            return true;
+        }
+
+        switch (valueType) {
+            case GL_INT:
+                // anything GL_GetUniformElementSize does not list is a sampler or an image
+                return uniformType == GL_BOOL || (GL_GetUniformElementSize(uniformType) == 4 &&
+                                                  uniformType != GL_FLOAT && uniformType != GL_UNSIGNED_INT);
+            case GL_FLOAT:
+                return uniformType == GL_BOOL;
+            case GL_FLOAT_VEC2:
+                return uniformType == GL_BOOL_VEC2;
+            case GL_FLOAT_VEC3:
+                return uniformType == GL_BOOL_VEC3;
+            case GL_FLOAT_VEC4:
+                return uniformType == GL_BOOL_VEC4;
+            default:
+                return false;
+        }
+    }
+
     bool GLShaderProgram::Link() {
+        if (!LinkAsync()) {
+            return false;
+        }
+
+        return FinishLink();
+    }
+
+    bool GLShaderProgram::LinkAsync() {
         if (m_ProgramHandle == -1) {
             m_ProgramHandle = glCreateProgram();
         }
 
+        if (LinkFromBinary()) {
+            g_LoggerGLShaderProgram.Log(runtime::LOG_LEVEL_DEBUG, "Shader program restored from a program binary.");
+
+            ReflectUniforms();
+            ReleaseShaders();
+            m_LinkState = GLLinkState::LINK_STATE_READY;
+            return true;
+        }
+
+        // shaders given only a compiled binary have no shader object; once the driver rejected the binary (e.g.
+        // after an update) there is nothing left to compile
+        for (auto &sh: m_Shaders) {
+            auto glShader = dynamic_cast<GLShader *>(sh.get());
+
+            if (glShader && glShader->GetHandle() == static_cast<unsigned int>(-1)) {
+                g_LoggerGLShaderProgram.Log(runtime::LOG_LEVEL_ERROR,
+                                            "The program binary was rejected and a shader has no source to compile from!");
+                m_LinkState = GLLinkState::LINK_STATE_FAILED;
+                return false;
+            }
+        }
+
         g_LoggerGLShaderProgram.Log(runtime::LOG_LEVEL_DEBUG, "Beginning to attach the shaders to the program...");
 
         for (auto sh: m_Shaders) {
@@ -20,64 +151,190 @@ namespace engine::backend::ogl {
 
             if (!glShader) {
                 g_LoggerGLShaderProgram.Log(runtime::LOG_LEVEL_ERROR, "The attached shader is NOT of GLShader type!");
+                m_LinkState = GLLinkState::LINK_STATE_FAILED;
                 return false;
             }
 
-            if (!glShader->IsCompiled()) {
-                g_LoggerGLShaderProgram.Log(runtime::LOG_LEVEL_WARNING, "The attached shader is not compiled! Compiling...");
-                if (!glShader->Compile()) {
-                    g_LoggerGLShaderProgram.Log(runtime::LOG_LEVEL_ERROR, "One of the shaders failed to compile!\nReason: %s",
-                           glShader->GetCompileLog().c_str());
-                    return false;
-                }
-            }
+            // compile status is only checked once linking finishes, so the driver can work on all stages at once
+            glShader->SubmitCompile();
 
             g_LoggerGLShaderProgram.Log(runtime::LOG_LEVEL_DEBUG, "Attaching shader to program...");
             glAttachShader(m_ProgramHandle, glShader->GetHandle());
         }
 
+        if (m_Backend->GetProgramBinaryCache().IsSupported()) {
+            glProgramParameteri(m_ProgramHandle, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        }
+
         g_LoggerGLShaderProgram.Log(runtime::LOG_LEVEL_DEBUG, "Linking shader program...");
         glLinkProgram(m_ProgramHandle);
 
+        m_LinkState = GLLinkState::LINK_STATE_PENDING;
+        return true;
+    }
+
+    bool GLShaderProgram::LinkOnWorker() {
+        if (m_WorkerLinkPending) {
+            return true;
+        }
+
+        auto &workers = m_Backend->GetWorkerPool();
+
+        // the program and its shaders are shared objects, so the whole link can run in the worker's context
+        m_WorkerLinkPending = workers.Submit(this, [this]() { Link(); }, [this](bool cancelled) {
+            if (!cancelled) {
+                m_WorkerLinkPending = false;
+            }
+        });
+
+        return m_WorkerLinkPending || LinkAsync();
+    }
+
+    GLLinkState GLShaderProgram::PollLink() {
+        if (m_WorkerLinkPending) {
+            return GLLinkState::LINK_STATE_PENDING;
+        }
+
+        if (m_LinkState != GLLinkState::LINK_STATE_PENDING) {
+            return m_LinkState;
+        }
+
+        if (m_Backend->GetCapabilities().parallelShaderCompile) {
+            GLint completed = GL_FALSE;
+            glGetProgramiv(m_ProgramHandle, GL_COMPLETION_STATUS_KHR, &completed);
+
+            if (completed != GL_TRUE) {
+                return m_LinkState;
+            }
+        }
+
+        // without GL_KHR_parallel_shader_compile there is no way to ask; finishing blocks until the driver is done
+        FinishLink();
+        return m_LinkState;
+    }
+
+    bool GLShaderProgram::FinishLink() {
+        if (m_LinkState != GLLinkState::LINK_STATE_PENDING) {
+            return m_LinkState == GLLinkState::LINK_STATE_READY;
+        }
+
         GLint linkStatus;
         glGetProgramiv(m_ProgramHandle, GL_LINK_STATUS, &linkStatus);
 
         if (linkStatus == GL_TRUE) {
-            // cleanup; destroy shader objects
-            for (auto& sh: m_Shaders) {
-                auto glShader = dynamic_cast<GLShader *>(sh.get());
+            auto &binaryCache = m_Backend->GetProgramBinaryCache();
 
-                if (!glShader) {
-                    g_LoggerGLShaderProgram.Log(runtime::LOG_LEVEL_ERROR, "The attached shader is NOT of GLShader type!");
-                    return false;
-                }
+            if (binaryCache.IsSupported() && m_BinaryKey != 0) {
+                binaryCache.Store(m_BinaryKey, m_ProgramHandle);
+            }
+
+            ReflectUniforms();
+            ReleaseShaders();
+            m_LinkState = GLLinkState::LINK_STATE_READY;
+            return true;
+        }
+
+        // a failed compile shows up as a failed link; report the stage that caused it
+        for (auto &sh: m_Shaders) {
+            auto glShader = dynamic_cast<GLShader *>(sh.get());
+
+            if (glShader && !glShader->IsCompiled()) {
+                g_LoggerGLShaderProgram.Log(runtime::LOG_LEVEL_ERROR, "One of the shaders failed to compile!\nReason: %s",
+                                            glShader->GetCompileLog().c_str());
+            }
+        }
+
+        g_LoggerGLShaderProgram.Log(runtime::LOG_LEVEL_ERROR, "Shader Program linking failed!\nReason: %s", GetLinkLog().c_str());
+
+        m_LinkState = GLLinkState::LINK_STATE_FAILED;
+        return false;
+    }
+
+    bool GLShaderProgram::LinkFromBinary() {
+        auto &binaryCache = m_Backend->GetProgramBinaryCache();
+        m_BinaryKey = 0;
+
+        if (!binaryCache.IsSupported()) {
+            return false;
+        }
+
+        std::vector<GLProgramSource> sources;
+        sources.reserve(m_Shaders.size());
+
+        for (auto &sh: m_Shaders) {
+            auto glShader = dynamic_cast<GLShader *>(sh.get());
+
+            if (!glShader) {
+                return false;
+            }
+
+            // a binary handed in through UseCompiledShader takes precedence over the on-disk cache
+            auto compiled = glShader->GetCompiledShader();
 
+            if (!compiled.empty() && binaryCache.Apply(compiled, 0, m_ProgramHandle)) {
+                return true;
+            }
+
+            sources.push_back({static_cast<unsigned int>(glShader->GetType()), glShader->GetCachedSource()});
+        }
+
+        if (sources.empty()) {
+            return false;
+        }
+
+        m_BinaryKey = binaryCache.ComputeKey(sources);
+
+        return binaryCache.Load(m_BinaryKey, m_ProgramHandle);
+    }
+
+    void GLShaderProgram::ReleaseShaders() {
+        // cleanup; destroy shader objects
+        for (auto &sh: m_Shaders) {
+            auto glShader = dynamic_cast<GLShader *>(sh.get());
+
+            if (glShader) {
                 glShader->Destroy();
             }
+        }
+
+        m_Shaders.clear();
+    }
 
-            m_Shaders.clear();
-        } else {
-            g_LoggerGLShaderProgram.Log(runtime::LOG_LEVEL_ERROR, "Shader Program linking failed!\nReason: %s", GetLinkLog().c_str());
+    std::vector<unsigned char> GLShaderProgram::GetProgramBinary() const {
+        if (m_ProgramHandle == -1 || !m_Backend->GetProgramBinaryCache().IsSupported()) {
+            return {};
         }
 
-        return linkStatus == GL_TRUE;
+        return m_Backend->GetProgramBinaryCache().Capture(m_BinaryKey, m_ProgramHandle);
     }
 
     void GLShaderProgram::Destroy() {
+        if (m_WorkerLinkPending) {
+            m_Backend->GetWorkerPool().Cancel(this);
+            m_WorkerLinkPending = false;
+        }
+
         if (m_ProgramHandle != -1) {
-            glDeleteProgram(m_ProgramHandle);
+            m_Backend->GetDeletionQueue().ReleaseProgram(m_ProgramHandle);
             m_ProgramHandle = -1;
         }
+
+        m_LinkState = GLLinkState::LINK_STATE_NONE;
+
+        m_Uniforms.clear();
+        m_UniformLookup.clear();
+        m_UniformShadow.clear();
+        m_UniformBlocks.clear();
     }
 
     void GLShaderProgram::Bind() {
-        if (m_ProgramHandle != -1) {
-            glUseProgram(m_ProgramHandle);
+        if (m_ProgramHandle != -1 && !m_WorkerLinkPending) {
+            m_Backend->GetStateCache().UseProgram(m_ProgramHandle);
         }
     }
 
     void GLShaderProgram::Unbind() {
-        glUseProgram(0);
+        m_Backend->GetStateCache().UseProgram(0);
     }
 
     void GLShaderProgram::AddShader(std::unique_ptr<core::runtime::graphics::IShader> shader) {
@@ -115,13 +372,280 @@ namespace engine::backend::ogl {
         return linkStatus == GL_TRUE;
     }
 
-    void GLShaderProgram::SetUniformMat4(std::string_view name, const glm::mat4 &mat) {
+    void GLShaderProgram::ReflectUniforms() {
+        m_Uniforms.clear();
+        m_UniformLookup.clear();
+        m_UniformShadow.clear();
+
+        GLint uniformCount = 0, maxNameLength = 0;
+        glGetProgramiv(m_ProgramHandle, GL_ACTIVE_UNIFORMS, &uniformCount);
+        glGetProgramiv(m_ProgramHandle, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+
+        std::vector<char> nameBuffer(std::max(maxNameLength, 1));
+        size_t shadowSize = 0;
+
+        for (GLint i = 0; i < uniformCount; i++) {
+            GLsizei nameLength = 0;
+            GLint arraySize = 0;
+            GLenum type = 0;
+
+            glGetActiveUniform(m_ProgramHandle, static_cast<GLuint>(i), static_cast<GLsizei>(nameBuffer.size()), &nameLength,
+                               &arraySize, &type, nameBuffer.data());
+
+            GLUniformInfo info;
+            info.name.assign(nameBuffer.data(), nameLength);
+            info.location = glGetUniformLocation(m_ProgramHandle, info.name.c_str());
+
+            // members of uniform blocks have no location and cannot be set through glUniform*
+            if (info.location == -1) {
+                continue;
+            }
+
+            // arrays are reported as "name[0]"; the info keeps the plain name, and both resolve to the uniform
+            auto index = static_cast<int>(m_Uniforms.size());
+
+            if (info.name.ends_with("[0]")) {
+                m_UniformLookup.emplace(info.name, index);
+                info.name.resize(info.name.size() - 3);
+            }
+
+            info.type = type;
+            info.arraySize = std::max(arraySize, 1);
+            info.elementSize = GL_GetUniformElementSize(type);
+            info.shadowOffset = shadowSize;
+
+            shadowSize += info.elementSize * info.arraySize;
+
+            m_UniformLookup.emplace(info.name, index);
+            m_Uniforms.emplace_back(std::move(info));
+        }
+
+        m_UniformShadow.resize(shadowSize);
+
+        g_LoggerGLShaderProgram.Log(runtime::LOG_LEVEL_DEBUG, "Reflected %zu active uniforms (%zu bytes of shadow storage).",
+                                    m_Uniforms.size(), shadowSize);
+
+        ReflectUniformBlocks();
+    }
+
+    void GLShaderProgram::ReflectUniformBlocks() {
+        m_UniformBlocks.clear();
+
+        GLint blockCount = 0, maxNameLength = 0;
+        glGetProgramiv(m_ProgramHandle, GL_ACTIVE_UNIFORM_BLOCKS, &blockCount);
+
+        if (blockCount <= 0) {
+            return;
+        }
+
+        glGetProgramiv(m_ProgramHandle, GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH, &maxNameLength);
+
+        std::vector<char> nameBuffer(std::max(maxNameLength, 1));
+
+        for (GLint i = 0; i < blockCount; i++) {
+            GLsizei nameLength = 0;
+            GLint dataSize = 0, binding = 0;
+
+            glGetActiveUniformBlockName(m_ProgramHandle, static_cast<GLuint>(i), static_cast<GLsizei>(nameBuffer.size()),
+                                        &nameLength, nameBuffer.data());
+
+            GLUniformBlockInfo info;
+            info.name.assign(nameBuffer.data(), nameLength);
+            info.index = glGetUniformBlockIndex(m_ProgramHandle, info.name.c_str());
+
+            if (info.index == GL_INVALID_INDEX) {
+                continue;
+            }
+
+            glGetActiveUniformBlockiv(m_ProgramHandle, info.index, GL_UNIFORM_BLOCK_DATA_SIZE, &dataSize);
+            glGetActiveUniformBlockiv(m_ProgramHandle, info.index, GL_UNIFORM_BLOCK_BINDING, &binding);
+
+            // arrays of blocks are reported as "name[0]"
+            std::string_view blockName(info.name);
+            blockName = blockName.substr(0, blockName.find('['));
+
+            bool hasSource = false;
+            bool explicitBinding = false;
+
+            for (auto &sh: m_Shaders) {
+                auto glShader = dynamic_cast<GLShader *>(sh.get());
+
+                if (glShader && !glShader->GetCachedSource().empty()) {
+                    hasSource = true;
+                    explicitBinding = explicitBinding || GL_HasExplicitBlockBinding(glShader->GetCachedSource(), blockName);
+                }
+            }
+
+            unsigned int namedBinding = 0;
+
+            if (hasSource && !explicitBinding) {
+                namedBinding = m_Backend->GetUniformBlockBinding(info.name);
+            } else if (hasSource || !m_Backend->FindUniformBlockBinding(info.name, namedBinding)) {
+                // an explicit binding, or a program restored from a binary alone whose block was never bound by
+                // name; only blocks other programs already bound by name can be recognized without sources
+                if (explicitBinding && static_cast<unsigned int>(binding) >= m_Backend->GetFirstNamedUniformBlockBinding()) {
+                    g_LoggerGLShaderProgram.Log(runtime::LOG_LEVEL_WARNING,
+                                                "Uniform block '%s' uses binding %d, which is reserved for blocks bound by name.",
+                                                info.name.c_str(), binding);
+                }
+
+                namedBinding = static_cast<unsigned int>(binding);
+            }
+
+            if (namedBinding != static_cast<unsigned int>(binding)) {
+                binding = static_cast<GLint>(namedBinding);
+                glUniformBlockBinding(m_ProgramHandle, info.index, namedBinding);
+            }
+
+            info.binding = static_cast<unsigned int>(binding);
+            info.dataSize = static_cast<size_t>(dataSize);
+
+            m_UniformBlocks.emplace_back(std::move(info));
+        }
+
+        g_LoggerGLShaderProgram.Log(runtime::LOG_LEVEL_DEBUG, "Reflected %zu uniform blocks.", m_UniformBlocks.size());
+    }
+
+    const GLUniformBlockInfo *GLShaderProgram::GetUniformBlock(std::string_view name) const {
+        for (auto &block: m_UniformBlocks) {
+            if (block.name == name) {
+                return &block;
+            }
+        }
+
+        return nullptr;
+    }
+
+    GLUniformHandle GLShaderProgram::GetUniformHandle(std::string_view name) const {
+        auto it = m_UniformLookup.find(name);
+
+        if (it == m_UniformLookup.end()) {
+            return {};
+        }
+
+        return {it->second};
+    }
+
+    const GLUniformInfo *GLShaderProgram::GetUniformInfo(GLUniformHandle handle) const {
+        if (!handle.IsValid() || handle.index >= static_cast<int>(m_Uniforms.size())) {
+            return nullptr;
+        }
+
+        return &m_Uniforms[handle.index];
+    }
+
+    int GLShaderProgram::PrepareUniformUpload(GLUniformHandle handle, const void *data, unsigned int valueType, size_t count) {
+        if (!handle.IsValid() || handle.index >= static_cast<int>(m_Uniforms.size()) || count == 0) {
+            return 0;
+        }
+
+        auto &info = m_Uniforms[handle.index];
+
+        // a glUniform* call of the wrong type fails with GL_INVALID_OPERATION, which would leave the shadow stale
+        if (!GL_IsUniformTypeCompatible(info.type, valueType)) {
+            g_LoggerGLShaderProgram.Log(runtime::LOG_LEVEL_WARNING, "Uniform '%s' set with a value of mismatching type!",
+                                        info.name.c_str());
+            return 0;
+        }
+
+        count = std::min(count, static_cast<size_t>(info.arraySize));
+
+        auto bytes = info.elementSize * count;
+        auto shadow = m_UniformShadow.data() + info.shadowOffset;
+
+        if (info.shadowValid && std::memcmp(shadow, data, bytes) == 0) {
+            m_Backend->GetCurrentFrameStats().uniformUploadsSkipped++;
+
+            return 0;
+        }
+
+        std::memcpy(shadow, data, bytes);
+
+        // a partial array upload leaves the remaining elements unknown to the shadow copy
+        info.shadowValid = count == static_cast<size_t>(info.arraySize);
+
+        m_Backend->GetCurrentFrameStats().uniformUploads++;
+
         Bind();
-        glUniformMatrix4fv(glGetUniformLocation(m_ProgramHandle, name.data()), 1, GL_FALSE, &mat[0][0]);
+
+        return static_cast<int>(count);
+    }
+
+    void GLShaderProgram::SetUniform(GLUniformHandle handle, int val) {
+        if (PrepareUniformUpload(handle, &val, GL_INT, 1)) {
+            glUniform1i(m_Uniforms[handle.index].location, val);
+        }
+    }
+
+    void GLShaderProgram::SetUniform(GLUniformHandle handle, float val) {
+        if (PrepareUniformUpload(handle, &val, GL_FLOAT, 1)) {
+            glUniform1f(m_Uniforms[handle.index].location, val);
+        }
+    }
+
+    void GLShaderProgram::SetUniform(GLUniformHandle handle, const glm::vec2 &val) {
+        SetUniformArray(handle, std::span<const glm::vec2>(&val, 1));
+    }
+
+    void GLShaderProgram::SetUniform(GLUniformHandle handle, const glm::vec3 &val) {
+        SetUniformArray(handle, std::span<const glm::vec3>(&val, 1));
+    }
+
+    void GLShaderProgram::SetUniform(GLUniformHandle handle, const glm::vec4 &val) {
+        SetUniformArray(handle, std::span<const glm::vec4>(&val, 1));
+    }
+
+    void GLShaderProgram::SetUniform(GLUniformHandle handle, const glm::mat3 &val) {
+        if (PrepareUniformUpload(handle, &val, GL_FLOAT_MAT3, 1)) {
+            glUniformMatrix3fv(m_Uniforms[handle.index].location, 1, GL_FALSE, &val[0][0]);
+        }
+    }
+
+    void GLShaderProgram::SetUniform(GLUniformHandle handle, const glm::mat4 &val) {
+        SetUniformArray(handle, std::span<const glm::mat4>(&val, 1));
+    }
+
+    void GLShaderProgram::SetUniformArray(GLUniformHandle handle, std::span<const int> values) {
+        if (auto count = PrepareUniformUpload(handle, values.data(), GL_INT, values.size())) {
+            glUniform1iv(m_Uniforms[handle.index].location, count, values.data());
+        }
+    }
+
+    void GLShaderProgram::SetUniformArray(GLUniformHandle handle, std::span<const float> values) {
+        if (auto count = PrepareUniformUpload(handle, values.data(), GL_FLOAT, values.size())) {
+            glUniform1fv(m_Uniforms[handle.index].location, count, values.data());
+        }
+    }
+
+    void GLShaderProgram::SetUniformArray(GLUniformHandle handle, std::span<const glm::vec2> values) {
+        if (auto count = PrepareUniformUpload(handle, values.data(), GL_FLOAT_VEC2, values.size())) {
+            glUniform2fv(m_Uniforms[handle.index].location, count, &values[0][0]);
+        }
+    }
+
+    void GLShaderProgram::SetUniformArray(GLUniformHandle handle, std::span<const glm::vec3> values) {
+        if (auto count = PrepareUniformUpload(handle, values.data(), GL_FLOAT_VEC3, values.size())) {
+            glUniform3fv(m_Uniforms[handle.index].location, count, &values[0][0]);
+        }
+    }
+
+    void GLShaderProgram::SetUniformArray(GLUniformHandle handle, std::span<const glm::vec4> values) {
+        if (auto count = PrepareUniformUpload(handle, values.data(), GL_FLOAT_VEC4, values.size())) {
+            glUniform4fv(m_Uniforms[handle.index].location, count, &values[0][0]);
+        }
+    }
+
+    void GLShaderProgram::SetUniformArray(GLUniformHandle handle, std::span<const glm::mat4> values) {
+        if (auto count = PrepareUniformUpload(handle, values.data(), GL_FLOAT_MAT4, values.size())) {
+            glUniformMatrix4fv(m_Uniforms[handle.index].location, count, GL_FALSE, &values[0][0][0]);
+        }
+    }
+
+    void GLShaderProgram::SetUniformMat4(std::string_view name, const glm::mat4 &mat) {
+        SetUniform(GetUniformHandle(name), mat);
     }
 
     void GLShaderProgram::SetUniformI(std::string_view name, int val) {
-        Bind();
-        glUniform1i(glGetUniformLocation(m_ProgramHandle, name.data()), val);
+        SetUniform(GetUniformHandle(name), val);
     }
 }
@@ -0,0 +1,63 @@
+#include <algorithm>
+#include <new>
+
+#include <Engine/Backend/OpenGL/GL_SlabPool.hpp>
+
+namespace engine::backend::ogl {
+    GLSlabPool::GLSlabPool(size_t slotSize, size_t slotAlignment, size_t slotsPerSlab)
+            : m_SlotsPerSlab(std::max<size_t>(slotsPerSlab, 1)) {
+        // a free slot stores the link, and every slot of a slab has to keep the alignment of the first
+        auto alignment = std::max({slotAlignment, alignof(FreeSlot), size_t(1)});
+        m_SlotSize = (std::max(slotSize, sizeof(FreeSlot)) + alignment - 1) / alignment * alignment;
+    }
+
+    GLSlabPool::~GLSlabPool() {
+        for (auto slab: m_Slabs) {
+            ::operator delete(slab);
+        }
+    }
+
+    void *GLSlabPool::Allocate() {
+        std::lock_guard lock(m_Mutex);
+
+        if (!m_FreeList) {
+            // operator new aligns to __STDCPP_DEFAULT_NEW_ALIGNMENT__, which covers every backend object
+            auto slab = static_cast<unsigned char *>(::operator new(m_SlotSize * m_SlotsPerSlab));
+            m_Slabs.push_back(slab);
+
+            for (size_t i = m_SlotsPerSlab; i-- > 0;) {
+                auto slot = reinterpret_cast<FreeSlot *>(slab + i * m_SlotSize);
+                slot->next = m_FreeList;
+                m_FreeList = slot;
+            }
+        }
+
+        auto slot = m_FreeList;
+        m_FreeList = slot->next;
+        m_LiveCount++;
+        return slot;
+    }
+
+    void GLSlabPool::Free(void *slot) {
+        if (!slot) {
+            return;
+        }
+
+        std::lock_guard lock(m_Mutex);
+
+        auto freeSlot = static_cast<FreeSlot *>(slot);
+        freeSlot->next = m_FreeList;
+        m_FreeList = freeSlot;
+        m_LiveCount--;
+    }
+
+    size_t GLSlabPool::GetLiveCount() const {
+        std::lock_guard lock(m_Mutex);
+        return m_LiveCount;
+    }
+
+    size_t GLSlabPool::GetCapacity() const {
+        std::lock_guard lock(m_Mutex);
+        return m_Slabs.size() * m_SlotsPerSlab;
+    }
+}
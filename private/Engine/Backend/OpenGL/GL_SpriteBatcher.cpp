@@ -0,0 +1,347 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+#include <Engine/GLHeader.hpp>
+
+#include <Engine/Backend/OpenGL/GL_Backend.hpp>
+#include <Engine/Backend/OpenGL/GL_Shader.hpp>
+#include <Engine/Backend/OpenGL/GL_SpriteBatcher.hpp>
+
+#include <Engine/Runtime/Logger.hpp>
+
+namespace engine::backend::ogl {
+    static runtime::Logger g_LoggerGLSpriteBatcher("GLSpriteBatcher");
+
+    static constexpr const char *GL_SPRITE_VERTEX_SOURCE = R"(
+layout(location = 0) in vec2 a_Position;
+layout(location = 1) in vec3 a_TexCoord;
+layout(location = 2) in vec4 a_Color;
+
+uniform mat4 u_Projection;
+
+out vec3 v_TexCoord;
+out vec4 v_Color;
+
+void main() {
+    v_TexCoord = a_TexCoord;
+    v_Color = a_Color;
+    gl_Position = u_Projection * vec4(a_Position, 0.0, 1.0);
+}
+)";
+
+    static constexpr const char *GL_SPRITE_FRAGMENT_SOURCE = R"(
+precision mediump float;
+precision mediump sampler2DArray;
+
+in vec3 v_TexCoord;
+in vec4 v_Color;
+
+uniform sampler2DArray u_Texture;
+
+out vec4 o_Color;
+
+void main() {
+    o_Color = texture(u_Texture, v_TexCoord) * v_Color;
+}
+)";
+
+    GLSpriteBatcher::GLSpriteBatcher(GLBackend *backend, int layersPerArray)
+            : m_Backend(backend), m_LayersPerArray(std::max(layersPerArray, 1)) {}
+
+    GLSpriteBatcher::~GLSpriteBatcher() {
+        if (m_VaoHandle || !m_Arrays.empty()) {
+            g_LoggerGLSpriteBatcher.Log(runtime::LOG_LEVEL_WARNING, "Sprite batcher was not destroyed before being released!");
+        }
+    }
+
+    bool GLSpriteBatcher::Create() {
+        if (m_VaoHandle) {
+            return true;
+        }
+
+        auto &caps = m_Backend->GetCapabilities();
+        auto &stateCache = m_Backend->GetStateCache();
+
+        // precision qualifiers are accepted (and ignored) by desktop GLSL 3.30
+        std::string header = caps.isES ? "#version 300 es\n" : "#version 330 core\n";
+
+        auto vertexShader = std::make_unique<GLShader>(m_Backend);
+        vertexShader->SetSource(header + GL_SPRITE_VERTEX_SOURCE, core::runtime::graphics::ShaderType::SHADER_TYPE_VERTEX);
+
+        auto fragmentShader = std::make_unique<GLShader>(m_Backend);
+        fragmentShader->SetSource(header + GL_SPRITE_FRAGMENT_SOURCE, core::runtime::graphics::ShaderType::SHADER_TYPE_FRAGMENT);
+
+        m_Program = std::make_unique<GLShaderProgram>(m_Backend);
+        m_Program->AddShader(std::move(vertexShader));
+        m_Program->AddShader(std::move(fragmentShader));
+
+        if (!m_Program->Link()) {
+            g_LoggerGLSpriteBatcher.Log(runtime::LOG_LEVEL_ERROR, "Failed to build the sprite program!");
+            m_Program->Destroy();
+            m_Program.reset();
+            return false;
+        }
+
+        m_ProjectionUniform = m_Program->GetUniformHandle("u_Projection");
+        m_TextureUniform = m_Program->GetUniformHandle("u_Texture");
+
+        // every quad uses the same 0-1-2 / 2-3-0 pattern, so one static index buffer serves every draw
+        std::vector<uint16_t> indices(MAX_SPRITES_PER_DRAW * 6);
+
+        for (size_t i = 0; i < MAX_SPRITES_PER_DRAW; i++) {
+            auto base = static_cast<uint16_t>(i * 4);
+            uint16_t quad[] = {base, static_cast<uint16_t>(base + 1), static_cast<uint16_t>(base + 2),
+                               static_cast<uint16_t>(base + 2), static_cast<uint16_t>(base + 3), base};
+            std::memcpy(indices.data() + i * 6, quad, sizeof(quad));
+        }
+
+        glGenVertexArrays(1, &m_VaoHandle);
+        glGenBuffers(1, &m_EboHandle);
+
+        stateCache.BindVertexArray(m_VaoHandle);
+        stateCache.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EboHandle);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(indices.size() * sizeof(uint16_t)), indices.data(),
+                     GL_STATIC_DRAW);
+
+        glEnableVertexAttribArray(0);
+        glEnableVertexAttribArray(1);
+        glEnableVertexAttribArray(2);
+
+        m_AttributeSource = 0;
+        m_AttributeOffset = 0;
+
+        return true;
+    }
+
+    void GLSpriteBatcher::Destroy() {
+        auto &stateCache = m_Backend->GetStateCache();
+
+        for (auto &array: m_Arrays) {
+            array->Destroy();
+        }
+
+        m_Arrays.clear();
+
+        if (m_Program) {
+            m_Program->Destroy();
+            m_Program.reset();
+        }
+
+        if (m_EboHandle) {
+            glDeleteBuffers(1, &m_EboHandle);
+            stateCache.OnBufferDeleted(m_EboHandle);
+            m_EboHandle = 0;
+        }
+
+        if (m_VaoHandle) {
+            glDeleteVertexArrays(1, &m_VaoHandle);
+            stateCache.OnVertexArrayDeleted(m_VaoHandle);
+            m_VaoHandle = 0;
+        }
+
+        m_Sprites.clear();
+        m_Order.clear();
+    }
+
+    GLSpriteImage GLSpriteBatcher::AddImage(const core::runtime::graphics::Bitmap &bitmap) {
+        auto size = bitmap.Size();
+        auto width = static_cast<int>(size.x);
+        auto height = static_cast<int>(size.y);
+
+        if (width <= 0 || height <= 0) {
+            return {};
+        }
+
+        // only the most recent array of a size class can have room left; older ones are full
+        int arrayIndex = -1;
+
+        for (int i = static_cast<int>(m_Arrays.size()) - 1; i >= 0; i--) {
+            auto &array = m_Arrays[i];
+
+            if (array->GetWidth() == width && array->GetHeight() == height) {
+                arrayIndex = array->IsFull() ? -1 : i;
+                break;
+            }
+        }
+
+        if (arrayIndex < 0) {
+            auto array = std::make_unique<GLTextureArray>(m_Backend, width, height, m_LayersPerArray);
+
+            if (!array->Create()) {
+                return {};
+            }
+
+            g_LoggerGLSpriteBatcher.Log(runtime::LOG_LEVEL_DEBUG, "Created texture array #%zu for %dx%d images.",
+                                        m_Arrays.size(), width, height);
+
+            arrayIndex = static_cast<int>(m_Arrays.size());
+            m_Arrays.emplace_back(std::move(array));
+        }
+
+        auto layer = m_Arrays[arrayIndex]->AddLayer(bitmap);
+
+        if (layer < 0) {
+            return {};
+        }
+
+        return {arrayIndex, layer, {static_cast<float>(width), static_cast<float>(height)}};
+    }
+
+    void GLSpriteBatcher::Begin(const glm::mat4 &projection) {
+        m_Projection = projection;
+        m_Sprites.clear();
+    }
+
+    void GLSpriteBatcher::Draw(const GLSpriteImage &image, glm::vec2 position, glm::vec2 size,
+                               core::runtime::graphics::Color color, int sortLayer, GLSpriteBlend blend,
+                               glm::vec4 uvRect) {
+        if (!image.IsValid() || image.array >= static_cast<int>(m_Arrays.size())) {
+            return;
+        }
+
+        // sort layer in the high bits (biased so negative layers order first), then blend mode, then array
+        auto key = (static_cast<uint64_t>(static_cast<uint32_t>(sortLayer) ^ 0x80000000u) << 32) |
+                   (static_cast<uint64_t>(blend) << 24) |
+                   static_cast<uint64_t>(image.array & 0xFFFFFF);
+
+        auto layer = static_cast<float>(image.layer);
+        auto x1 = position.x + size.x;
+        auto y1 = position.y + size.y;
+
+        Sprite sprite{key, image.array, blend, {
+                {position.x, position.y, uvRect.x, uvRect.y, layer, color},
+                {x1, position.y, uvRect.z, uvRect.y, layer, color},
+                {x1, y1, uvRect.z, uvRect.w, layer, color},
+                {position.x, y1, uvRect.x, uvRect.w, layer, color}
+        }};
+
+        m_Sprites.emplace_back(sprite);
+    }
+
+    void GLSpriteBatcher::ApplyBlend(GLSpriteBlend blend) {
+        auto &stateCache = m_Backend->GetStateCache();
+
+        switch (blend) {
+            case GLSpriteBlend::SPRITE_BLEND_OPAQUE:
+                stateCache.SetCapability(GL_BLEND, false);
+                return;
+            case GLSpriteBlend::SPRITE_BLEND_ADDITIVE:
+                stateCache.SetCapability(GL_BLEND, true);
+                stateCache.SetBlendEquation(GL_FUNC_ADD);
+                stateCache.SetBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE, GL_ONE, GL_ONE);
+                return;
+            default:
+                stateCache.SetCapability(GL_BLEND, true);
+                stateCache.SetBlendEquation(GL_FUNC_ADD);
+                stateCache.SetBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+                return;
+        }
+    }
+
+    void GLSpriteBatcher::ConfigureAttributes(unsigned int sourceBuffer, size_t byteOffset) {
+        if (m_AttributeSource == sourceBuffer && m_AttributeOffset == byteOffset) {
+            return;
+        }
+
+        m_AttributeSource = sourceBuffer;
+        m_AttributeOffset = byteOffset;
+
+        m_Backend->GetStateCache().BindBuffer(GL_ARRAY_BUFFER, sourceBuffer);
+
+        constexpr auto stride = static_cast<GLsizei>(sizeof(SpriteVertex));
+
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, stride,
+                              reinterpret_cast<const void *>(byteOffset + offsetof(SpriteVertex, x)));
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride,
+                              reinterpret_cast<const void *>(byteOffset + offsetof(SpriteVertex, u)));
+        glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride,
+                              reinterpret_cast<const void *>(byteOffset + offsetof(SpriteVertex, color)));
+    }
+
+    void GLSpriteBatcher::SubmitRun(size_t first, size_t count) {
+        auto &stream = m_Backend->GetVertexStream();
+        auto allocation = stream.Allocate(count * 4 * sizeof(SpriteVertex), sizeof(SpriteVertex));
+
+        if (!allocation.IsValid()) {
+            g_LoggerGLSpriteBatcher.Log(runtime::LOG_LEVEL_ERROR, "Failed to stream %zu sprites!", count);
+            return;
+        }
+
+        auto *vertices = static_cast<SpriteVertex *>(allocation.data);
+
+        for (size_t i = 0; i < count; i++) {
+            std::memcpy(vertices + i * 4, m_Sprites[m_Order[first + i]].vertices, sizeof(Sprite::vertices));
+        }
+
+        stream.Commit(allocation);
+
+        auto indexCount = static_cast<GLsizei>(count * 6);
+
+        // the allocation is stride-aligned, so its offset is a whole number of vertices into the ring
+        if (m_Backend->GetCapabilities().drawElementsBaseVertex) {
+            ConfigureAttributes(stream.GetHandle(), 0);
+            glDrawElementsBaseVertex(GL_TRIANGLES, indexCount, GL_UNSIGNED_SHORT, nullptr,
+                                     static_cast<GLint>(allocation.offset / sizeof(SpriteVertex)));
+        } else {
+            ConfigureAttributes(stream.GetHandle(), allocation.offset);
+            glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_SHORT, nullptr);
+        }
+
+        m_Backend->GetCurrentFrameStats().CountDraw(static_cast<uint64_t>(indexCount));
+        m_LastDrawCount++;
+    }
+
+    void GLSpriteBatcher::End() {
+        m_LastDrawCount = 0;
+
+        if (m_Sprites.empty() || (!m_VaoHandle && !Create())) {
+            m_Sprites.clear();
+            return;
+        }
+
+        // sort indices rather than the sprites themselves; stable so equal keys keep submission order
+        m_Order.resize(m_Sprites.size());
+
+        for (size_t i = 0; i < m_Order.size(); i++) {
+            m_Order[i] = static_cast<uint32_t>(i);
+        }
+
+        std::stable_sort(m_Order.begin(), m_Order.end(), [this](uint32_t a, uint32_t b) {
+            return m_Sprites[a].key < m_Sprites[b].key;
+        });
+
+        auto &stateCache = m_Backend->GetStateCache();
+
+        m_Program->Bind();
+        m_Program->SetUniform(m_ProjectionUniform, m_Projection);
+        m_Program->SetUniform(m_TextureUniform, 0);
+
+        stateCache.BindVertexArray(m_VaoHandle);
+
+        size_t runStart = 0;
+
+        while (runStart < m_Order.size()) {
+            auto &head = m_Sprites[m_Order[runStart]];
+            auto runEnd = runStart + 1;
+
+            while (runEnd < m_Order.size() && runEnd - runStart < MAX_SPRITES_PER_DRAW) {
+                auto &sprite = m_Sprites[m_Order[runEnd]];
+
+                if (sprite.array != head.array || sprite.blend != head.blend) {
+                    break;
+                }
+
+                runEnd++;
+            }
+
+            ApplyBlend(head.blend);
+            m_Arrays[head.array]->Bind(0);
+            SubmitRun(runStart, runEnd - runStart);
+
+            runStart = runEnd;
+        }
+
+        m_Sprites.clear();
+    }
+}
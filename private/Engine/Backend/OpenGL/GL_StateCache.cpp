@@ -0,0 +1,342 @@
+#include <Engine/GLHeader.hpp>
+
+#include <Engine/Backend/OpenGL/GL_Backend.hpp>
+#include <Engine/Backend/OpenGL/GL_StateCache.hpp>
+
+namespace engine::backend::ogl {
+    void GLStateCache::Invalidate() {
+        m_Program = UNKNOWN;
+        m_ActiveTextureUnit = -1;
+
+        for (auto &unit: m_Textures) {
+            unit.fill(UNKNOWN);
+        }
+
+        m_Samplers.fill(UNKNOWN);
+
+        m_VertexArray = UNKNOWN;
+        m_Buffers = {{
+                {GL_ARRAY_BUFFER, UNKNOWN},
+                {GL_PIXEL_UNPACK_BUFFER, UNKNOWN},
+                {GL_PIXEL_PACK_BUFFER, UNKNOWN},
+                {GL_UNIFORM_BUFFER, UNKNOWN},
+                {GL_DRAW_INDIRECT_BUFFER, UNKNOWN},
+                {GL_COPY_WRITE_BUFFER, UNKNOWN}
+        }};
+
+        m_UniformRanges.fill({UNKNOWN, 0, 0});
+
+        m_Blend = -1;
+        m_ScissorTest = -1;
+        m_BlendEquation = UNKNOWN;
+        m_BlendFunc.fill(UNKNOWN);
+
+        m_Viewport = {-1, -1, -1, -1};
+        m_Scissor = {-1, -1, -1, -1};
+        m_ClearColor = {-1.f, -1.f, -1.f, -1.f};
+    }
+
+    void GLStateCache::CountChange(bool issued) {
+        if (!m_Backend) {
+            return;
+        }
+
+        auto &stats = m_Backend->GetCurrentFrameStats();
+
+        if (issued) {
+            stats.stateChanges++;
+        } else {
+            stats.stateChangesSkipped++;
+        }
+    }
+
+    int GLStateCache::GetTextureTargetIndex(unsigned int target) {
+        switch (target) {
+            case GL_TEXTURE_2D:
+                return 0;
+            case GL_TEXTURE_2D_ARRAY:
+                return 1;
+            default:
+                return -1;
+        }
+    }
+
+    GLStateCache::BufferBinding *GLStateCache::FindBufferBinding(unsigned int target) {
+        for (auto &binding: m_Buffers) {
+            if (binding.target == target) {
+                return &binding;
+            }
+        }
+
+        return nullptr;
+    }
+
+    void GLStateCache::UseProgram(unsigned int program) {
+        if (m_Program == program) {
+            CountChange(false);
+            return;
+        }
+
+        m_Program = program;
+        glUseProgram(program);
+        CountChange(true);
+
+        if (m_Backend) {
+            m_Backend->GetCurrentFrameStats().programBinds++;
+        }
+    }
+
+    void GLStateCache::ActiveTexture(int unit) {
+        if (m_ActiveTextureUnit == unit) {
+            return;
+        }
+
+        m_ActiveTextureUnit = unit;
+        glActiveTexture(GL_TEXTURE0 + unit);
+    }
+
+    void GLStateCache::BindTexture(int unit, unsigned int target, unsigned int texture) {
+        auto targetIndex = GetTextureTargetIndex(target);
+
+        if (unit < 0 || unit >= MAX_TEXTURE_UNITS || targetIndex < 0) {
+            // untracked unit/target; forward to the driver and forget what we knew about the active unit
+            glActiveTexture(GL_TEXTURE0 + unit);
+            glBindTexture(target, texture);
+            m_ActiveTextureUnit = unit;
+            CountChange(true);
+            return;
+        }
+
+        if (m_Textures[unit][targetIndex] == texture) {
+            CountChange(false);
+            return;
+        }
+
+        ActiveTexture(unit);
+        glBindTexture(target, texture);
+        m_Textures[unit][targetIndex] = texture;
+        CountChange(true);
+    }
+
+    void GLStateCache::BindTexture(unsigned int target, unsigned int texture) {
+        if (m_ActiveTextureUnit < 0) {
+            ActiveTexture(0);
+        }
+
+        BindTexture(m_ActiveTextureUnit, target, texture);
+    }
+
+    void GLStateCache::BindSampler(int unit, unsigned int sampler) {
+        if (unit < 0 || unit >= MAX_TEXTURE_UNITS) {
+            glBindSampler(static_cast<GLuint>(unit), sampler);
+            CountChange(true);
+            return;
+        }
+
+        if (m_Samplers[unit] == sampler) {
+            CountChange(false);
+            return;
+        }
+
+        glBindSampler(static_cast<GLuint>(unit), sampler);
+        m_Samplers[unit] = sampler;
+        CountChange(true);
+    }
+
+    void GLStateCache::BindVertexArray(unsigned int vao) {
+        if (m_VertexArray == vao) {
+            CountChange(false);
+            return;
+        }
+
+        m_VertexArray = vao;
+        glBindVertexArray(vao);
+        CountChange(true);
+    }
+
+    void GLStateCache::BindBuffer(unsigned int target, unsigned int buffer) {
+        auto binding = FindBufferBinding(target);
+
+        if (!binding) {
+            glBindBuffer(target, buffer);
+            CountChange(true);
+            return;
+        }
+
+        if (binding->buffer == buffer) {
+            CountChange(false);
+            return;
+        }
+
+        binding->buffer = buffer;
+        glBindBuffer(target, buffer);
+        CountChange(true);
+    }
+
+    void GLStateCache::BindUniformBufferRange(unsigned int index, unsigned int buffer, size_t offset, size_t size) {
+        if (index < MAX_UNIFORM_BINDINGS) {
+            auto &range = m_UniformRanges[index];
+
+            if (range.buffer == buffer && range.offset == offset && range.size == size) {
+                CountChange(false);
+                return;
+            }
+
+            range = {buffer, offset, size};
+        }
+
+        glBindBufferRange(GL_UNIFORM_BUFFER, index, buffer, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size));
+        FindBufferBinding(GL_UNIFORM_BUFFER)->buffer = buffer;
+        CountChange(true);
+    }
+
+    void GLStateCache::SetCapability(unsigned int cap, bool enabled) {
+        int *shadow = nullptr;
+
+        switch (cap) {
+            case GL_BLEND:
+                shadow = &m_Blend;
+                break;
+            case GL_SCISSOR_TEST:
+                shadow = &m_ScissorTest;
+                break;
+            default:
+                break;
+        }
+
+        if (shadow) {
+            if (*shadow == static_cast<int>(enabled)) {
+                CountChange(false);
+                return;
+            }
+
+            *shadow = enabled;
+        }
+
+        if (enabled) {
+            glEnable(cap);
+        } else {
+            glDisable(cap);
+        }
+
+        CountChange(true);
+    }
+
+    void GLStateCache::SetBlendEquation(unsigned int mode) {
+        if (m_BlendEquation == mode) {
+            CountChange(false);
+            return;
+        }
+
+        m_BlendEquation = mode;
+        glBlendEquation(mode);
+        CountChange(true);
+    }
+
+    void GLStateCache::SetBlendFuncSeparate(unsigned int srcRgb, unsigned int dstRgb, unsigned int srcAlpha,
+                                            unsigned int dstAlpha) {
+        std::array<unsigned int, 4> func = {srcRgb, dstRgb, srcAlpha, dstAlpha};
+
+        if (m_BlendFunc == func) {
+            CountChange(false);
+            return;
+        }
+
+        m_BlendFunc = func;
+        glBlendFuncSeparate(srcRgb, dstRgb, srcAlpha, dstAlpha);
+        CountChange(true);
+    }
+
+    const std::array<int, 4> &GLStateCache::GetViewport() {
+        if (m_Viewport[2] < 0 || m_Viewport[3] < 0) {
+            glGetIntegerv(GL_VIEWPORT, m_Viewport.data());
+        }
+
+        return m_Viewport;
+    }
+
+    void GLStateCache::SetViewport(int x, int y, int width, int height) {
+        std::array<int, 4> viewport = {x, y, width, height};
+
+        if (m_Viewport == viewport) {
+            CountChange(false);
+            return;
+        }
+
+        m_Viewport = viewport;
+        glViewport(x, y, width, height);
+        CountChange(true);
+    }
+
+    void GLStateCache::SetScissor(int x, int y, int width, int height) {
+        std::array<int, 4> scissor = {x, y, width, height};
+
+        if (m_Scissor == scissor) {
+            CountChange(false);
+            return;
+        }
+
+        m_Scissor = scissor;
+        glScissor(x, y, width, height);
+        CountChange(true);
+    }
+
+    void GLStateCache::SetClearColor(float r, float g, float b, float a) {
+        std::array<float, 4> color = {r, g, b, a};
+
+        if (m_ClearColor == color) {
+            CountChange(false);
+            return;
+        }
+
+        m_ClearColor = color;
+        glClearColor(r, g, b, a);
+        CountChange(true);
+    }
+
+    void GLStateCache::OnProgramDeleted(unsigned int program) {
+        // a program in use stays alive until another one is installed, so the cached value is still
+        // correct; but the name may be handed out again, so force the next UseProgram through.
+        if (m_Program == program) {
+            m_Program = UNKNOWN;
+        }
+    }
+
+    void GLStateCache::OnTextureDeleted(unsigned int texture) {
+        for (auto &unit: m_Textures) {
+            for (auto &bound: unit) {
+                if (bound == texture) {
+                    bound = 0;
+                }
+            }
+        }
+    }
+
+    void GLStateCache::OnSamplerDeleted(unsigned int sampler) {
+        for (auto &bound: m_Samplers) {
+            if (bound == sampler) {
+                bound = 0;
+            }
+        }
+    }
+
+    void GLStateCache::OnVertexArrayDeleted(unsigned int vao) {
+        if (m_VertexArray == vao) {
+            m_VertexArray = 0;
+        }
+    }
+
+    void GLStateCache::OnBufferDeleted(unsigned int buffer) {
+        for (auto &binding: m_Buffers) {
+            if (binding.buffer == buffer) {
+                binding.buffer = 0;
+            }
+        }
+
+        for (auto &range: m_UniformRanges) {
+            if (range.buffer == buffer) {
+                range = {0, 0, 0};
+            }
+        }
+    }
+}
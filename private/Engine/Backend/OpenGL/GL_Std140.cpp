@@ -0,0 +1,167 @@
+#include <cstring>
+
+#include <Engine/Backend/OpenGL/GL_Std140.hpp>
+
+namespace engine::backend::ogl {
+    static constexpr size_t GL_STD140_VEC4 = 16;
+
+    static size_t GL_AlignUp(size_t value, size_t alignment) {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    size_t GL_GetStd140Alignment(GLStd140Type type) {
+        switch (type) {
+            case GLStd140Type::STD140_FLOAT:
+            case GLStd140Type::STD140_INT:
+            case GLStd140Type::STD140_UINT:
+                return 4;
+            case GLStd140Type::STD140_VEC2:
+            case GLStd140Type::STD140_IVEC2:
+                return 8;
+            default:
+                return GL_STD140_VEC4;
+        }
+    }
+
+    size_t GL_GetStd140Size(GLStd140Type type) {
+        switch (type) {
+            case GLStd140Type::STD140_FLOAT:
+            case GLStd140Type::STD140_INT:
+            case GLStd140Type::STD140_UINT:
+                return 4;
+            case GLStd140Type::STD140_VEC2:
+            case GLStd140Type::STD140_IVEC2:
+                return 8;
+            case GLStd140Type::STD140_VEC3:
+            case GLStd140Type::STD140_IVEC3:
+                return 12;
+            case GLStd140Type::STD140_VEC4:
+            case GLStd140Type::STD140_IVEC4:
+                return 16;
+            case GLStd140Type::STD140_MAT3:
+                return 3 * GL_STD140_VEC4;
+            case GLStd140Type::STD140_MAT4:
+                return 4 * GL_STD140_VEC4;
+        }
+
+        return 0;
+    }
+
+    size_t GLStd140Layout::Add(GLStd140Type type, size_t arrayCount) {
+        if (arrayCount == 0) {
+            auto offset = GL_AlignUp(m_Offset, GL_GetStd140Alignment(type));
+            m_Offset = offset + GL_GetStd140Size(type);
+            return offset;
+        }
+
+        // array elements are rounded up to a vec4; matrices already are
+        auto stride = GL_AlignUp(GL_GetStd140Size(type), GL_STD140_VEC4);
+        auto offset = GL_AlignUp(m_Offset, GL_STD140_VEC4);
+        m_Offset = offset + stride * arrayCount;
+        return offset;
+    }
+
+    size_t GLStd140Layout::BeginStruct() {
+        m_StructDepth++;
+        m_Offset = GL_AlignUp(m_Offset, GL_STD140_VEC4);
+        return m_Offset;
+    }
+
+    void GLStd140Layout::EndStruct() {
+        if (m_StructDepth > 0) {
+            m_StructDepth--;
+        }
+
+        m_Offset = GL_AlignUp(m_Offset, GL_STD140_VEC4);
+    }
+
+    size_t GLStd140Layout::GetSize() const {
+        return GL_AlignUp(m_Offset, GL_STD140_VEC4);
+    }
+
+    void GLStd140Writer::Write(size_t offset, const void *data, size_t size) {
+        if (offset > m_Size || size > m_Size - offset) {
+            return;
+        }
+
+        std::memcpy(m_Data + offset, data, size);
+    }
+
+    template<typename T>
+    void GLStd140Writer::WriteStrided(size_t offset, std::span<const T> values, size_t stride) {
+        for (auto &value: values) {
+            Write(offset, &value, sizeof(T));
+            offset += stride;
+        }
+    }
+
+    void GLStd140Writer::Set(size_t offset, float val) {
+        Write(offset, &val, sizeof(val));
+    }
+
+    void GLStd140Writer::Set(size_t offset, int val) {
+        Write(offset, &val, sizeof(val));
+    }
+
+    void GLStd140Writer::Set(size_t offset, unsigned int val) {
+        Write(offset, &val, sizeof(val));
+    }
+
+    void GLStd140Writer::Set(size_t offset, const glm::vec2 &val) {
+        Write(offset, &val[0], sizeof(val));
+    }
+
+    void GLStd140Writer::Set(size_t offset, const glm::vec3 &val) {
+        Write(offset, &val[0], sizeof(val));
+    }
+
+    void GLStd140Writer::Set(size_t offset, const glm::vec4 &val) {
+        Write(offset, &val[0], sizeof(val));
+    }
+
+    void GLStd140Writer::Set(size_t offset, const glm::ivec2 &val) {
+        Write(offset, &val[0], sizeof(val));
+    }
+
+    void GLStd140Writer::Set(size_t offset, const glm::ivec3 &val) {
+        Write(offset, &val[0], sizeof(val));
+    }
+
+    void GLStd140Writer::Set(size_t offset, const glm::ivec4 &val) {
+        Write(offset, &val[0], sizeof(val));
+    }
+
+    void GLStd140Writer::Set(size_t offset, const glm::mat3 &val) {
+        for (int column = 0; column < 3; column++) {
+            Write(offset + column * GL_STD140_VEC4, &val[column][0], sizeof(glm::vec3));
+        }
+    }
+
+    void GLStd140Writer::Set(size_t offset, const glm::mat4 &val) {
+        Write(offset, &val[0][0], sizeof(val));
+    }
+
+    void GLStd140Writer::SetArray(size_t offset, std::span<const float> values) {
+        WriteStrided(offset, values, GL_STD140_VEC4);
+    }
+
+    void GLStd140Writer::SetArray(size_t offset, std::span<const int> values) {
+        WriteStrided(offset, values, GL_STD140_VEC4);
+    }
+
+    void GLStd140Writer::SetArray(size_t offset, std::span<const glm::vec2> values) {
+        WriteStrided(offset, values, GL_STD140_VEC4);
+    }
+
+    void GLStd140Writer::SetArray(size_t offset, std::span<const glm::vec3> values) {
+        WriteStrided(offset, values, GL_STD140_VEC4);
+    }
+
+    void GLStd140Writer::SetArray(size_t offset, std::span<const glm::vec4> values) {
+        Write(offset, values.data(), values.size_bytes());
+    }
+
+    void GLStd140Writer::SetArray(size_t offset, std::span<const glm::mat4> values) {
+        Write(offset, values.data(), values.size_bytes());
+    }
+}
@@ -0,0 +1,228 @@
+#include <algorithm>
+#include <chrono>
+
+#include <Engine/GLHeader.hpp>
+
+#include <Engine/Backend/OpenGL/GL_Backend.hpp>
+#include <Engine/Backend/OpenGL/GL_StreamBuffer.hpp>
+
+#include <Engine/Runtime/Logger.hpp>
+
+namespace engine::backend::ogl {
+    static runtime::Logger g_LoggerGLStreamBuffer("GLStreamBuffer");
+
+    GLStreamBuffer::GLStreamBuffer(GLBackend *backend, unsigned int target, size_t regionSize, int regionCount)
+            : m_Backend(backend), m_Target(target), m_RegionSize(regionSize),
+              m_RegionCount(std::clamp(regionCount, 2, MAX_REGIONS)) {}
+
+    GLStreamBuffer::~GLStreamBuffer() {
+        if (m_Handle) {
+            g_LoggerGLStreamBuffer.Log(runtime::LOG_LEVEL_WARNING, "Stream buffer was not destroyed before being released!");
+        }
+    }
+
+    bool GLStreamBuffer::Create() {
+        if (m_Handle) {
+            return true;
+        }
+
+        auto totalSize = static_cast<GLsizeiptr>(m_RegionSize * m_RegionCount);
+        auto &stateCache = m_Backend->GetStateCache();
+
+        glGenBuffers(1, &m_Handle);
+        stateCache.BindBuffer(m_Target, m_Handle);
+
+        m_Persistent = m_Backend->GetCapabilities().bufferStorage;
+
+        if (m_Persistent) {
+            constexpr GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+            glBufferStorage(m_Target, totalSize, nullptr, flags);
+            m_Mapped = static_cast<unsigned char *>(glMapBufferRange(m_Target, 0, totalSize, flags));
+
+            if (!m_Mapped) {
+                g_LoggerGLStreamBuffer.Log(runtime::LOG_LEVEL_WARNING, "Persistent mapping failed; falling back to mapped ranges.");
+
+                // immutable storage cannot be re-specified; start over with a fresh buffer
+                glDeleteBuffers(1, &m_Handle);
+                stateCache.OnBufferDeleted(m_Handle);
+
+                glGenBuffers(1, &m_Handle);
+                stateCache.BindBuffer(m_Target, m_Handle);
+                m_Persistent = false;
+            }
+        }
+
+        if (!m_Persistent) {
+            glBufferData(m_Target, totalSize, nullptr, GL_STREAM_DRAW);
+        }
+
+        m_Region = 0;
+        m_RegionOffset = 0;
+        m_FrameIndex = m_Backend->GetFrameIndex();
+
+        g_LoggerGLStreamBuffer.Log(runtime::LOG_LEVEL_DEBUG, "Created %s stream buffer with %d regions of %zu bytes.",
+                                   m_Persistent ? "persistent" : "mapped-range", m_RegionCount, m_RegionSize);
+
+        return m_Handle != 0;
+    }
+
+    void GLStreamBuffer::Destroy() {
+        for (auto &fence: m_Fences) {
+            if (fence) {
+                glDeleteSync(static_cast<GLsync>(fence));
+                fence = nullptr;
+            }
+        }
+
+        if (m_Handle) {
+            if (m_Mapped) {
+                m_Backend->GetStateCache().BindBuffer(m_Target, m_Handle);
+                glUnmapBuffer(m_Target);
+                m_Mapped = nullptr;
+            }
+
+            glDeleteBuffers(1, &m_Handle);
+            m_Backend->GetStateCache().OnBufferDeleted(m_Handle);
+            m_Handle = 0;
+        }
+
+        m_MappingOpen = false;
+    }
+
+    void GLStreamBuffer::AdvanceRegion() {
+        m_Fences[m_Region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+        m_Region = (m_Region + 1) % m_RegionCount;
+        m_RegionOffset = 0;
+        m_Epoch++;
+
+        auto fence = static_cast<GLsync>(m_Fences[m_Region]);
+
+        if (!fence) {
+            return;
+        }
+
+        // fast path: the GPU has usually finished with a region that is a few frames old
+        auto result = glClientWaitSync(fence, 0, 0);
+
+        if (result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED) {
+            auto waitStart = std::chrono::steady_clock::now();
+
+            // a lost or reset context never signals; give up instead of spinning forever
+            do {
+                result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+            } while (result == GL_TIMEOUT_EXPIRED &&
+                     std::chrono::steady_clock::now() - waitStart < std::chrono::nanoseconds(MAX_FENCE_WAIT_NS));
+
+            if (result == GL_WAIT_FAILED) {
+                g_LoggerGLStreamBuffer.Log(runtime::LOG_LEVEL_ERROR, "Waiting on a stream region fence failed!");
+            } else if (result == GL_TIMEOUT_EXPIRED) {
+                g_LoggerGLStreamBuffer.Log(runtime::LOG_LEVEL_ERROR, "Stream region fence did not signal within %llu ms!",
+                                           static_cast<unsigned long long>(MAX_FENCE_WAIT_NS / 1000000));
+            }
+
+            m_Backend->GetCurrentFrameStats().streamFenceWaitNs += static_cast<uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - waitStart).count());
+        }
+
+        glDeleteSync(fence);
+        m_Fences[m_Region] = nullptr;
+    }
+
+    GLStreamAllocation GLStreamBuffer::Allocate(size_t size, size_t alignment) {
+        if (!m_Handle && !Create()) {
+            return {};
+        }
+
+        if (size == 0 || size > m_RegionSize) {
+            return {};
+        }
+
+        // checked before any space is taken; a second glMapBufferRange would fail with GL_INVALID_OPERATION
+        if (m_MappingOpen) {
+            g_LoggerGLStreamBuffer.Log(runtime::LOG_LEVEL_ERROR, "Previous stream allocation was not committed!");
+            return {};
+        }
+
+        // a new frame always starts in a fresh region, so the previous frame's fence covers all of its draws
+        auto frameIndex = m_Backend->GetFrameIndex();
+
+        if (frameIndex != m_FrameIndex) {
+            m_FrameIndex = frameIndex;
+            AdvanceRegion();
+        }
+
+        alignment = std::max<size_t>(alignment, 1);
+
+        // alignment does not have to be a power of two (e.g. vertex strides), and is relative to the buffer start
+        auto alignedOffset = [&]() {
+            auto base = m_Region * m_RegionSize;
+            return (base + m_RegionOffset + alignment - 1) / alignment * alignment;
+        };
+
+        auto offset = alignedOffset();
+
+        if (offset + size > (m_Region + 1) * m_RegionSize) {
+            AdvanceRegion();
+            offset = alignedOffset();
+
+            if (offset + size > (m_Region + 1) * m_RegionSize) {
+                return {};
+            }
+        }
+
+        GLStreamAllocation allocation;
+        allocation.offset = offset;
+        allocation.size = size;
+
+        if (m_Persistent) {
+            allocation.data = m_Mapped + allocation.offset;
+        } else {
+            // the region is fenced, so the driver does not need to synchronize with in-flight draws
+            m_Backend->GetStateCache().BindBuffer(m_Target, m_Handle);
+            allocation.data = glMapBufferRange(m_Target, static_cast<GLintptr>(allocation.offset),
+                                               static_cast<GLsizeiptr>(size),
+                                               GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+
+            if (!allocation.data) {
+                g_LoggerGLStreamBuffer.Log(runtime::LOG_LEVEL_ERROR, "Failed to map a stream buffer range!");
+                return {};
+            }
+
+            m_MappingOpen = true;
+        }
+
+        // only a successful allocation takes the space
+        m_RegionOffset = offset + size - m_Region * m_RegionSize;
+        m_Backend->GetCurrentFrameStats().streamBytes += size;
+
+        return allocation;
+    }
+
+    void GLStreamBuffer::Refence(size_t offset) {
+        auto region = static_cast<int>(offset / m_RegionSize);
+
+        // the current region is fenced once the ring moves on
+        if (region == m_Region || region >= m_RegionCount) {
+            return;
+        }
+
+        if (m_Fences[region]) {
+            glDeleteSync(static_cast<GLsync>(m_Fences[region]));
+        }
+
+        m_Fences[region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+
+    void GLStreamBuffer::Commit(const GLStreamAllocation &allocation) {
+        if (!allocation.IsValid() || m_Persistent) {
+            // coherent persistent memory needs no explicit flush
+            return;
+        }
+
+        m_Backend->GetStateCache().BindBuffer(m_Target, m_Handle);
+        glUnmapBuffer(m_Target);
+        m_MappingOpen = false;
+    }
+}
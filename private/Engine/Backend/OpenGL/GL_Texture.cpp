@@ -1,60 +1,325 @@
+#include <algorithm>
 #include <cstdio>
 
 #include <Engine/GLHeader.hpp>
 
+#include <Engine/Backend/OpenGL/GL_Backend.hpp>
+#include <Engine/Backend/OpenGL/GL_MappedFile.hpp>
 #include <Engine/Backend/OpenGL/GL_Texture.hpp>
+#include <Engine/Backend/OpenGL/GL_TextureContainer.hpp>
 
 namespace engine::backend::ogl {
-    bool GLTexture::Create(const core::runtime::graphics::Bitmap &bitmap) {
+    bool GLTexture::Allocate(core::math::Vector2 size, int mipLevels) {
         if (m_TexHandle != -1) {
-            glDeleteTextures(1, &m_TexHandle);
+            Destroy();
+        }
+
+        if (size.x <= 0 || size.y <= 0) {
+            printf("GLTexture: Invalid texture size.\n");
+            return false;
+        }
+
+        auto width = static_cast<GLsizei>(size.x);
+        auto height = static_cast<GLsizei>(size.y);
+        auto fullMipCount = GL_GetFullMipCount(width, height);
+
+        m_MipLevels = mipLevels <= 0 ? fullMipCount : std::min(mipLevels, fullMipCount);
+
+        auto &pool = m_Backend->GetResourcePool();
+        auto immutable = m_Backend->GetCapabilities().textureStorage;
+
+        // immutable storage of the same format and size can be taken over as it is
+        m_TexHandle = immutable ? pool.AcquireTexture(GL_RGBA8, width, height, m_MipLevels) : 0;
+
+        if (m_TexHandle != 0) {
+            m_Backend->GetStateCache().BindTexture(GL_TEXTURE_2D, m_TexHandle);
+        } else if (immutable) {
+            m_TexHandle = pool.GenName(GLNameType::NAME_TEXTURE);
+            m_Backend->GetStateCache().BindTexture(GL_TEXTURE_2D, m_TexHandle);
+
+            // immutable storage: the driver validates the mip chain once instead of on every use
+            glTexStorage2D(GL_TEXTURE_2D, m_MipLevels, GL_RGBA8, width, height);
+        } else {
+            m_TexHandle = pool.GenName(GLNameType::NAME_TEXTURE);
+            m_Backend->GetStateCache().BindTexture(GL_TEXTURE_2D, m_TexHandle);
+
+            // the remaining levels are allocated by glGenerateMipmap
+            glTexImage2D(
+                    GL_TEXTURE_2D,
+                    0,
+                    GL_RGBA8,
+                    width,
+                    height,
+                    0,
+                    GL_RGBA,
+                    GL_UNSIGNED_BYTE,
+                    nullptr
+            );
         }
 
-        glGenTextures(1, &m_TexHandle);
-        glBindTexture(GL_TEXTURE_2D, m_TexHandle);
+        m_Size = size;
+        m_InternalFormat = GL_RGBA8;
+        m_Residency = GLTextureResidency::RESIDENCY_NONE;
+
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, m_MipLevels - 1);
+        SetSampler(m_SamplerDesc);
+
+        return true;
+    }
+
+    void GLTexture::GenerateMipmaps() {
+        if (m_TexHandle == -1 || m_MipLevels <= 1) {
+            return;
+        }
+
+        m_Backend->GetStateCache().BindTexture(GL_TEXTURE_2D, m_TexHandle);
+        glGenerateMipmap(GL_TEXTURE_2D);
+    }
+
+    void GLTexture::SetSampler(const GLSamplerDesc &desc) {
+        m_SamplerDesc = desc;
+
+        if (m_TexHandle == -1) {
+            return;
+        }
+
+        auto &caps = m_Backend->GetCapabilities();
+
+        if (caps.samplerObjects) {
+            m_Sampler = m_Backend->GetSamplerCache().Get(desc);
+        } else {
+            m_Backend->GetStateCache().BindTexture(GL_TEXTURE_2D, m_TexHandle);
+            GLSamplerCache::ApplyToTexture(GL_TEXTURE_2D, desc, caps.maxAnisotropy);
+        }
+    }
+
+    bool GLTexture::Create(const core::runtime::graphics::Bitmap &bitmap) {
+        return Create(bitmap, 1);
+    }
 
+    bool GLTexture::Create(const core::runtime::graphics::Bitmap &bitmap, int mipLevels) {
         auto size = bitmap.Size();
-        auto pixels = bitmap.GetPixels();
+        const auto &pixels = bitmap.GetPixels();
 
         if (pixels.empty()) {
             printf("GLTexture: Bitmap data is empty.\n");
             return false;
         }
 
-        glTexImage2D(
+        if (!Allocate(size, mipLevels)) {
+            return false;
+        }
+
+        glTexSubImage2D(
                 GL_TEXTURE_2D,
                 0,
-                GL_RGBA8,
+                0,
+                0,
                 static_cast<GLsizei>(size.x),
                 static_cast<GLsizei>(size.y),
-                0,
                 GL_RGBA,
                 GL_UNSIGNED_BYTE,
                 pixels.data()
         );
 
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        m_Backend->GetCurrentFrameStats().textureUploadBytes += pixels.size() * sizeof(core::runtime::graphics::Color);
+        GenerateMipmaps();
 
+        m_Residency = GLTextureResidency::RESIDENCY_RESIDENT;
         return true;
     }
 
+    bool GLTexture::CreateAsync(std::shared_ptr<const core::runtime::graphics::Bitmap> bitmap, int mipLevels) {
+        if (!bitmap || bitmap->GetPixels().empty()) {
+            printf("GLTexture: Bitmap data is empty.\n");
+            return false;
+        }
+
+        if (!Allocate(bitmap->Size(), mipLevels)) {
+            return false;
+        }
+
+        return m_Backend->GetTextureStreamer().Enqueue(this, std::move(bitmap));
+    }
+
+    bool GLTexture::CreateOnWorker(std::shared_ptr<const core::runtime::graphics::Bitmap> bitmap, int mipLevels) {
+        if (!bitmap || bitmap->GetPixels().empty()) {
+            printf("GLTexture: Bitmap data is empty.\n");
+            return false;
+        }
+
+        auto &workers = m_Backend->GetWorkerPool();
+
+        if (!workers.IsAvailable()) {
+            return CreateAsync(std::move(bitmap), mipLevels);
+        }
+
+        Destroy();
+
+        auto size = bitmap->Size();
+        auto width = static_cast<GLsizei>(size.x);
+        auto height = static_cast<GLsizei>(size.y);
+
+        if (width <= 0 || height <= 0) {
+            printf("GLTexture: Invalid texture size.\n");
+            return false;
+        }
+
+        auto fullMipCount = GL_GetFullMipCount(width, height);
+        auto levels = mipLevels <= 0 ? fullMipCount : std::min(mipLevels, fullMipCount);
+        auto immutable = m_Backend->GetCapabilities().textureStorage;
+        auto handle = std::make_shared<GLuint>(0);
+
+        // the worker context has its own bindings, so it talks to GL directly instead of through the state cache
+        auto job = [bitmap, width, height, levels, immutable, handle]() {
+            glGenTextures(1, handle.get());
+            glBindTexture(GL_TEXTURE_2D, *handle);
+
+            if (immutable) {
+                glTexStorage2D(GL_TEXTURE_2D, levels, GL_RGBA8, width, height);
+            } else {
+                glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+            }
+
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levels - 1);
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, bitmap->GetPixels().data());
+
+            if (levels > 1) {
+                glGenerateMipmap(GL_TEXTURE_2D);
+            }
+
+            glBindTexture(GL_TEXTURE_2D, 0);
+        };
+
+        auto completion = [this, handle, size, levels](bool cancelled) {
+            if (cancelled) {
+                glDeleteTextures(1, handle.get());
+                return;
+            }
+
+            m_TexHandle = *handle;
+            m_Size = size;
+            m_InternalFormat = GL_RGBA8;
+            m_MipLevels = levels;
+            m_Residency = GLTextureResidency::RESIDENCY_RESIDENT;
+
+            // counted here because frame stats belong to the GL thread
+            m_Backend->GetCurrentFrameStats().textureUploadBytes +=
+                    static_cast<uint64_t>(size.x) * static_cast<uint64_t>(size.y) * sizeof(core::runtime::graphics::Color);
+
+            SetSampler(m_SamplerDesc);
+        };
+
+        if (!workers.Submit(this, std::move(job), std::move(completion))) {
+            return CreateAsync(std::move(bitmap), mipLevels);
+        }
+
+        m_Residency = GLTextureResidency::RESIDENCY_STREAMING;
+        return true;
+    }
+
+    bool GLTexture::CreateCompressed(unsigned int internalFormat, std::span<const GLTextureLevel> levels) {
+        if (m_TexHandle != -1) {
+            Destroy();
+        }
+
+        if (levels.empty()) {
+            printf("GLTexture: No mip levels given.\n");
+            return false;
+        }
+
+        auto &caps = m_Backend->GetCapabilities();
+
+        if (!caps.SupportsCompressedFormat(internalFormat)) {
+            printf("GLTexture: Compressed format 0x%04X is not supported by this context.\n", internalFormat);
+            return false;
+        }
+
+        for (auto &level: levels) {
+            if (!level.data || level.size != GL_GetCompressedImageSize(internalFormat, level.width, level.height)) {
+                printf("GLTexture: Mip level %dx%d has an unexpected size.\n", level.width, level.height);
+                return false;
+            }
+        }
+
+        auto &pool = m_Backend->GetResourcePool();
+        auto levelCount = static_cast<GLsizei>(levels.size());
+
+        m_TexHandle = caps.textureStorage
+                      ? pool.AcquireTexture(internalFormat, levels[0].width, levels[0].height, levelCount) : 0;
+
+        if (m_TexHandle != 0) {
+            m_Backend->GetStateCache().BindTexture(GL_TEXTURE_2D, m_TexHandle);
+        } else {
+            m_TexHandle = pool.GenName(GLNameType::NAME_TEXTURE);
+            m_Backend->GetStateCache().BindTexture(GL_TEXTURE_2D, m_TexHandle);
+
+            if (caps.textureStorage) {
+                glTexStorage2D(GL_TEXTURE_2D, levelCount, internalFormat, levels[0].width, levels[0].height);
+            }
+        }
+
+        for (GLsizei i = 0; i < levelCount; i++) {
+            auto &level = levels[i];
+
+            if (caps.textureStorage) {
+                glCompressedTexSubImage2D(GL_TEXTURE_2D, i, 0, 0, level.width, level.height, internalFormat,
+                                          static_cast<GLsizei>(level.size), level.data);
+            } else {
+                glCompressedTexImage2D(GL_TEXTURE_2D, i, internalFormat, level.width, level.height, 0,
+                                       static_cast<GLsizei>(level.size), level.data);
+            }
+
+            m_Backend->GetCurrentFrameStats().textureUploadBytes += level.size;
+        }
+
+        m_Size = {static_cast<float>(levels[0].width), static_cast<float>(levels[0].height)};
+        m_InternalFormat = internalFormat;
+        m_MipLevels = levelCount;
+        m_Residency = GLTextureResidency::RESIDENCY_RESIDENT;
+
+        // files may ship a partial chain; limit sampling to the levels that exist
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levelCount - 1);
+        SetSampler(m_SamplerDesc);
+
+        return true;
+    }
+
+    bool GLTexture::CreateFromFile(const std::filesystem::path &path) {
+        GLMappedFile file;
+
+        if (!file.Open(path)) {
+            printf("GLTexture: Failed to map '%s'.\n", path.string().c_str());
+            return false;
+        }
+
+        // the levels point into the mapping, which has to outlive the upload below
+        GLTextureContainer container;
+
+        if (!GL_ParseTextureContainer(file.GetData(), container)) {
+            printf("GLTexture: '%s' is not a supported KTX2 / DDS file.\n", path.string().c_str());
+            return false;
+        }
+
+        return CreateCompressed(container.internalFormat, container.levels);
+    }
+
     core::runtime::graphics::Bitmap GLTexture::Download() {
         if (m_TexHandle == -1) {
             printf("GLTexture: Texture has not been created.\n");
             return {};
         }
 
-        auto size = GetSize();
-        std::vector<core::runtime::graphics::Color> pixels(size.x * size.y);
+        // blocking; goes through the same FBO + pack buffer path as DownloadAsync, which also works on GLES
+        auto &readback = m_Backend->GetReadback();
+        auto future = readback.ReadTexture(*this);
+        readback.WaitAll();
 
-        // TODO: fix for OpenGL ES
-        // glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
-        glBindTexture(GL_TEXTURE_2D, 0);
+        return future.get();
+    }
 
-        return core::runtime::graphics::Bitmap(std::move(pixels), size);
+    std::future<core::runtime::graphics::Bitmap> GLTexture::DownloadAsync(int level) {
+        return m_Backend->GetReadback().ReadTexture(*this, level);
     }
 
     core::math::Vector2 GLTexture::GetSize() {
@@ -62,33 +327,58 @@ namespace engine::backend::ogl {
             return {0, 0};
         }
 
-        glBindTexture(GL_TEXTURE_2D, m_TexHandle);
-
-        GLint width, height;
-        glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &width);
-        glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &height);
-
-        return {static_cast<float>(width), static_cast<float>(height)};
+        // remembered at creation time; avoids binding the texture and querying the driver
+        return m_Size;
     }
 
     void GLTexture::Bind(int samplerSlot) {
         if (m_TexHandle == -1) {
-            printf("GLTexture: Texture has not been created.\n");
+            // textures created on a worker have no handle until they land
+            if (m_Residency != GLTextureResidency::RESIDENCY_STREAMING) {
+                printf("GLTexture: Texture has not been created.\n");
+            }
+
             return;
         }
 
-        glActiveTexture(GL_TEXTURE0 + samplerSlot);
-        glBindTexture(GL_TEXTURE_2D, m_TexHandle);
+        auto &stateCache = m_Backend->GetStateCache();
+        stateCache.BindTexture(samplerSlot, GL_TEXTURE_2D, m_TexHandle);
+
+        // sampler 0 lets texture parameters apply instead of the sampler the previous texture left on the unit
+        if (m_Backend->GetCapabilities().samplerObjects) {
+            stateCache.BindSampler(samplerSlot, m_Sampler);
+        }
     }
 
     void GLTexture::Unbind() {
-        glBindTexture(GL_TEXTURE_2D, 0);
+        m_Backend->GetStateCache().BindTexture(GL_TEXTURE_2D, 0);
     }
 
     void GLTexture::Destroy() {
+        if (m_Residency == GLTextureResidency::RESIDENCY_STREAMING) {
+            if (m_TexHandle == -1) {
+                m_Backend->GetWorkerPool().Cancel(this);
+            } else if (auto streamer = m_Backend->FindTextureStreamer()) {
+                streamer->Cancel(this);
+            }
+        }
+
+        m_Residency = GLTextureResidency::RESIDENCY_NONE;
+
         if (m_TexHandle != -1) {
-            glDeleteTextures(1, &m_TexHandle);
+            // only immutable storage can be handed to another texture unchanged; either way the GPU may still
+            // sample the texture this frame, so it is released once it is done
+            auto recyclable = m_Backend->GetCapabilities().textureStorage && m_InternalFormat != 0;
+
+            m_Backend->GetDeletionQueue().ReleaseTexture(m_TexHandle, recyclable ? m_InternalFormat : 0,
+                                                         static_cast<int>(m_Size.x), static_cast<int>(m_Size.y),
+                                                         m_MipLevels);
+
             m_TexHandle = -1;
+            m_Size = {0, 0};
+            m_InternalFormat = 0;
+            m_MipLevels = 1;
+            m_Sampler = 0;
         }
     }
 }
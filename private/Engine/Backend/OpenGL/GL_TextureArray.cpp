@@ -0,0 +1,157 @@
+#include <algorithm>
+
+#include <Engine/GLHeader.hpp>
+
+#include <Engine/Backend/OpenGL/GL_Backend.hpp>
+#include <Engine/Backend/OpenGL/GL_TextureArray.hpp>
+
+#include <Engine/Runtime/Logger.hpp>
+
+namespace engine::backend::ogl {
+    static runtime::Logger g_LoggerGLTextureArray("GLTextureArray");
+
+    GLTextureArray::GLTextureArray(GLBackend *backend, int width, int height, int layerCapacity)
+            : m_Backend(backend), m_Width(width), m_Height(height), m_LayerCapacity(std::max(layerCapacity, 1)) {
+        auto layerBytes = static_cast<size_t>(std::max(width, 1)) * static_cast<size_t>(std::max(height, 1)) * 4;
+        auto budgetLayers = static_cast<int>(std::min<size_t>(MAX_BYTES / layerBytes, static_cast<size_t>(m_LayerCapacity)));
+
+        // a single layer is always allowed, even if it alone exceeds the budget
+        m_LayerCapacity = std::max(budgetLayers, 1);
+    }
+
+    GLTextureArray::~GLTextureArray() {
+        if (m_TexHandle) {
+            g_LoggerGLTextureArray.Log(runtime::LOG_LEVEL_WARNING, "Texture array was not destroyed before being released!");
+        }
+    }
+
+    bool GLTextureArray::Create() {
+        if (m_TexHandle) {
+            return true;
+        }
+
+        GLint maxLayers = 0;
+        glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxLayers);
+
+        if (maxLayers > 0 && m_LayerCapacity > maxLayers) {
+            m_LayerCapacity = maxLayers;
+        }
+
+        m_AllocatedLayers = std::min(INITIAL_LAYERS, m_LayerCapacity);
+        m_TexHandle = CreateStorage(m_AllocatedLayers);
+        m_LayerCount = 0;
+        return m_TexHandle != 0;
+    }
+
+    void GLTextureArray::Destroy() {
+        if (m_TexHandle) {
+            glDeleteTextures(1, &m_TexHandle);
+            m_Backend->GetStateCache().OnTextureDeleted(m_TexHandle);
+            m_TexHandle = 0;
+        }
+
+        if (m_CopyFramebuffer) {
+            glDeleteFramebuffers(1, &m_CopyFramebuffer);
+            m_CopyFramebuffer = 0;
+        }
+
+        m_AllocatedLayers = 0;
+        m_LayerCount = 0;
+    }
+
+    unsigned int GLTextureArray::CreateStorage(int layers) {
+        GLuint texture = 0;
+        glGenTextures(1, &texture);
+        m_Backend->GetStateCache().BindTexture(GL_TEXTURE_2D_ARRAY, texture);
+
+        if (m_Backend->GetCapabilities().textureStorage) {
+            glTexStorage3D(GL_TEXTURE_2D_ARRAY, 1, GL_RGBA8, m_Width, m_Height, layers);
+        } else {
+            glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, m_Width, m_Height, layers, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+                         nullptr);
+        }
+
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+        return texture;
+    }
+
+    bool GLTextureArray::Grow(int layers) {
+        auto texture = CreateStorage(layers);
+
+        if (!texture) {
+            return false;
+        }
+
+        if (m_Backend->GetCapabilities().copyImage) {
+            glCopyImageSubData(m_TexHandle, GL_TEXTURE_2D_ARRAY, 0, 0, 0, 0, texture, GL_TEXTURE_2D_ARRAY, 0, 0, 0, 0,
+                               m_Width, m_Height, m_LayerCount);
+        } else {
+            // fallback: read each layer through a framebuffer into the bound new storage
+            GLint previousReadFramebuffer = 0;
+            glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &previousReadFramebuffer);
+
+            if (!m_CopyFramebuffer) {
+                glGenFramebuffers(1, &m_CopyFramebuffer);
+            }
+
+            glBindFramebuffer(GL_READ_FRAMEBUFFER, m_CopyFramebuffer);
+
+            for (int layer = 0; layer < m_LayerCount; layer++) {
+                glFramebufferTextureLayer(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, m_TexHandle, 0, layer);
+                glCopyTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, 0, 0, m_Width, m_Height);
+            }
+
+            glFramebufferTextureLayer(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, 0, 0, 0);
+            glBindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<GLuint>(previousReadFramebuffer));
+        }
+
+        // sprites drawn earlier this frame still sample the old storage
+        m_Backend->GetDeletionQueue().ReleaseTexture(m_TexHandle);
+
+        g_LoggerGLTextureArray.Log(runtime::LOG_LEVEL_DEBUG, "Grew %dx%d texture array from %d to %d layers.",
+                                   m_Width, m_Height, m_AllocatedLayers, layers);
+
+        m_TexHandle = texture;
+        m_AllocatedLayers = layers;
+        return true;
+    }
+
+    int GLTextureArray::AddLayer(const core::runtime::graphics::Bitmap &bitmap) {
+        if ((!m_TexHandle && !Create()) || IsFull()) {
+            return -1;
+        }
+
+        auto size = bitmap.Size();
+        const auto &pixels = bitmap.GetPixels();
+
+        if (static_cast<int>(size.x) != m_Width || static_cast<int>(size.y) != m_Height || pixels.empty()) {
+            g_LoggerGLTextureArray.Log(runtime::LOG_LEVEL_ERROR, "Bitmap does not match the %dx%d layer size!", m_Width, m_Height);
+            return -1;
+        }
+
+        if (m_LayerCount >= m_AllocatedLayers && !Grow(std::min(m_AllocatedLayers * 2, m_LayerCapacity))) {
+            return -1;
+        }
+
+        m_Backend->GetStateCache().BindTexture(GL_TEXTURE_2D_ARRAY, m_TexHandle);
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, m_LayerCount, m_Width, m_Height, 1, GL_RGBA, GL_UNSIGNED_BYTE,
+                        pixels.data());
+        m_Backend->GetCurrentFrameStats().textureUploadBytes += pixels.size() * sizeof(core::runtime::graphics::Color);
+
+        return m_LayerCount++;
+    }
+
+    void GLTextureArray::Bind(int samplerSlot) {
+        auto &stateCache = m_Backend->GetStateCache();
+        stateCache.BindTexture(samplerSlot, GL_TEXTURE_2D_ARRAY, m_TexHandle);
+
+        // the array has a single level; a mipmapping sampler left on the unit would make it incomplete
+        if (m_Backend->GetCapabilities().samplerObjects) {
+            stateCache.BindSampler(samplerSlot, 0);
+        }
+    }
+}
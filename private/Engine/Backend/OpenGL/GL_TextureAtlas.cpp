@@ -0,0 +1,273 @@
+#include <algorithm>
+
+#include <Engine/GLHeader.hpp>
+
+#include <Engine/Backend/OpenGL/GL_Backend.hpp>
+#include <Engine/Backend/OpenGL/GL_TextureAtlas.hpp>
+
+#include <Engine/Runtime/Logger.hpp>
+
+namespace engine::backend::ogl {
+    static runtime::Logger g_LoggerGLTextureAtlas("GLTextureAtlas");
+
+    GLTextureAtlas::GLTextureAtlas(GLBackend *backend, int pageSize)
+            : m_Backend(backend), m_PageSize(pageSize) {}
+
+    GLTextureAtlas::~GLTextureAtlas() {
+        if (!m_Pages.empty()) {
+            g_LoggerGLTextureAtlas.Log(runtime::LOG_LEVEL_WARNING, "Texture atlas was not destroyed before being released!");
+        }
+    }
+
+    void GLTextureAtlas::Destroy() {
+        for (auto &page: m_Pages) {
+            DestroyPage(page);
+        }
+
+        m_Pages.clear();
+        m_Entries.clear();
+        m_FreeEntrySlots.clear();
+        m_UploadScratch.clear();
+        m_UploadScratch.shrink_to_fit();
+
+        if (m_CopyFramebuffer) {
+            glDeleteFramebuffers(1, &m_CopyFramebuffer);
+            m_CopyFramebuffer = 0;
+        }
+    }
+
+    int GLTextureAtlas::CreatePage() {
+        Page page;
+        page.allocator.Reset(m_PageSize, m_PageSize);
+
+        glGenTextures(1, &page.texture);
+        m_Backend->GetStateCache().BindTexture(GL_TEXTURE_2D, page.texture);
+
+        if (m_Backend->GetCapabilities().textureStorage) {
+            glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, m_PageSize, m_PageSize);
+        } else {
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_PageSize, m_PageSize, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        }
+
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+        g_LoggerGLTextureAtlas.Log(runtime::LOG_LEVEL_DEBUG, "Created atlas page #%zu (%dx%d).", m_Pages.size(),
+                                   m_PageSize, m_PageSize);
+
+        m_Pages.emplace_back(std::move(page));
+        return static_cast<int>(m_Pages.size() - 1);
+    }
+
+    void GLTextureAtlas::DestroyPage(Page &page) {
+        if (page.texture) {
+            glDeleteTextures(1, &page.texture);
+            m_Backend->GetStateCache().OnTextureDeleted(page.texture);
+            page.texture = 0;
+        }
+    }
+
+    GLAtlasHandle GLTextureAtlas::Add(const core::runtime::graphics::Bitmap &bitmap) {
+        auto size = bitmap.Size();
+        auto width = static_cast<int>(size.x);
+        auto height = static_cast<int>(size.y);
+        const auto &pixels = bitmap.GetPixels();
+
+        if (width <= 0 || height <= 0 || pixels.size() < static_cast<size_t>(width) * height) {
+            g_LoggerGLTextureAtlas.Log(runtime::LOG_LEVEL_ERROR, "Bitmap data is empty.");
+            return {};
+        }
+
+        auto paddedWidth = width + PADDING * 2;
+        auto paddedHeight = height + PADDING * 2;
+
+        if (paddedWidth > m_PageSize || paddedHeight > m_PageSize) {
+            g_LoggerGLTextureAtlas.Log(runtime::LOG_LEVEL_ERROR, "%dx%d bitmap does not fit in a %dx%d atlas page!",
+                                       width, height, m_PageSize, m_PageSize);
+            return {};
+        }
+
+        int pageIndex = 0;
+        GLRect rect;
+
+        for (; pageIndex < static_cast<int>(m_Pages.size()); pageIndex++) {
+            rect = m_Pages[pageIndex].allocator.Allocate(paddedWidth, paddedHeight);
+
+            if (rect.IsValid()) {
+                break;
+            }
+        }
+
+        if (!rect.IsValid()) {
+            pageIndex = CreatePage();
+            rect = m_Pages[pageIndex].allocator.Allocate(paddedWidth, paddedHeight);
+        }
+
+        // build the padded image with its edge texels extruded into the border
+        m_UploadScratch.resize(static_cast<size_t>(paddedWidth) * paddedHeight);
+
+        for (int y = 0; y < paddedHeight; y++) {
+            auto sourceY = std::clamp(y - PADDING, 0, height - 1);
+            auto *sourceRow = pixels.data() + static_cast<size_t>(sourceY) * width;
+            auto *row = m_UploadScratch.data() + static_cast<size_t>(y) * paddedWidth;
+
+            for (int x = 0; x < PADDING; x++) {
+                row[x] = sourceRow[0];
+                row[paddedWidth - 1 - x] = sourceRow[width - 1];
+            }
+
+            std::copy(sourceRow, sourceRow + width, row + PADDING);
+        }
+
+        m_Backend->GetStateCache().BindTexture(GL_TEXTURE_2D, m_Pages[pageIndex].texture);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, rect.x, rect.y, rect.width, rect.height, GL_RGBA, GL_UNSIGNED_BYTE,
+                        m_UploadScratch.data());
+        m_Backend->GetCurrentFrameStats().textureUploadBytes +=
+                static_cast<uint64_t>(rect.width) * static_cast<uint64_t>(rect.height) * 4;
+
+        Entry entry{pageIndex, rect, true};
+
+        if (!m_FreeEntrySlots.empty()) {
+            auto slot = m_FreeEntrySlots.back();
+            m_FreeEntrySlots.pop_back();
+            m_Entries[slot] = entry;
+            return {slot};
+        }
+
+        m_Entries.emplace_back(entry);
+        return {static_cast<uint32_t>(m_Entries.size() - 1)};
+    }
+
+    void GLTextureAtlas::Remove(GLAtlasHandle handle) {
+        if (!handle.IsValid() || handle.index >= m_Entries.size() || !m_Entries[handle.index].alive) {
+            return;
+        }
+
+        auto &entry = m_Entries[handle.index];
+        m_Pages[entry.page].allocator.Free(entry.rect);
+        entry.alive = false;
+
+        m_FreeEntrySlots.emplace_back(handle.index);
+    }
+
+    GLSubTexture GLTextureAtlas::Get(GLAtlasHandle handle) const {
+        if (!handle.IsValid() || handle.index >= m_Entries.size() || !m_Entries[handle.index].alive) {
+            return {};
+        }
+
+        auto &entry = m_Entries[handle.index];
+        auto scale = 1.f / static_cast<float>(m_PageSize);
+
+        GLSubTexture subTexture;
+        subTexture.texture = m_Pages[entry.page].texture;
+        subTexture.page = entry.page;
+        subTexture.rect = {entry.rect.x + PADDING, entry.rect.y + PADDING,
+                           entry.rect.width - PADDING * 2, entry.rect.height - PADDING * 2};
+        subTexture.uvRect = {
+                static_cast<float>(subTexture.rect.x) * scale,
+                static_cast<float>(subTexture.rect.y) * scale,
+                static_cast<float>(subTexture.rect.x + subTexture.rect.width) * scale,
+                static_cast<float>(subTexture.rect.y + subTexture.rect.height) * scale
+        };
+
+        return subTexture;
+    }
+
+    void GLTextureAtlas::BindPage(int page, int samplerSlot) {
+        if (page < 0 || page >= static_cast<int>(m_Pages.size())) {
+            return;
+        }
+
+        auto &stateCache = m_Backend->GetStateCache();
+        stateCache.BindTexture(samplerSlot, GL_TEXTURE_2D, m_Pages[page].texture);
+
+        // pages have a single level; a mipmapping sampler left on the unit would make them incomplete
+        if (m_Backend->GetCapabilities().samplerObjects) {
+            stateCache.BindSampler(samplerSlot, 0);
+        }
+    }
+
+    void GLTextureAtlas::CopyRegion(const Page &source, const GLRect &sourceRect, const Page &destination,
+                                    const GLRect &destinationRect) {
+        if (m_Backend->GetCapabilities().copyImage) {
+            glCopyImageSubData(source.texture, GL_TEXTURE_2D, 0, sourceRect.x, sourceRect.y, 0,
+                               destination.texture, GL_TEXTURE_2D, 0, destinationRect.x, destinationRect.y, 0,
+                               sourceRect.width, sourceRect.height, 1);
+            return;
+        }
+
+        // fallback: read from the source page through a framebuffer into the bound destination page
+        GLint previousReadFramebuffer = 0;
+        glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &previousReadFramebuffer);
+
+        if (!m_CopyFramebuffer) {
+            glGenFramebuffers(1, &m_CopyFramebuffer);
+        }
+
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, m_CopyFramebuffer);
+        glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, source.texture, 0);
+
+        m_Backend->GetStateCache().BindTexture(GL_TEXTURE_2D, destination.texture);
+        glCopyTexSubImage2D(GL_TEXTURE_2D, 0, destinationRect.x, destinationRect.y, sourceRect.x, sourceRect.y,
+                            sourceRect.width, sourceRect.height);
+
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<GLuint>(previousReadFramebuffer));
+    }
+
+    bool GLTextureAtlas::Defragment() {
+        std::vector<uint32_t> live;
+
+        for (uint32_t i = 0; i < m_Entries.size(); i++) {
+            if (m_Entries[i].alive) {
+                live.push_back(i);
+            }
+        }
+
+        // tallest first packs considerably tighter with a guillotine allocator
+        std::sort(live.begin(), live.end(), [this](uint32_t a, uint32_t b) {
+            auto &rectA = m_Entries[a].rect;
+            auto &rectB = m_Entries[b].rect;
+            return rectA.height != rectB.height ? rectA.height > rectB.height : rectA.width > rectB.width;
+        });
+
+        auto oldPages = std::move(m_Pages);
+        m_Pages.clear();
+
+        for (auto index: live) {
+            auto &entry = m_Entries[index];
+            int pageIndex = 0;
+            GLRect rect;
+
+            for (; pageIndex < static_cast<int>(m_Pages.size()); pageIndex++) {
+                rect = m_Pages[pageIndex].allocator.Allocate(entry.rect.width, entry.rect.height);
+
+                if (rect.IsValid()) {
+                    break;
+                }
+            }
+
+            if (!rect.IsValid()) {
+                pageIndex = CreatePage();
+                rect = m_Pages[pageIndex].allocator.Allocate(entry.rect.width, entry.rect.height);
+            }
+
+            CopyRegion(oldPages[entry.page], entry.rect, m_Pages[pageIndex], rect);
+
+            entry.page = pageIndex;
+            entry.rect = rect;
+        }
+
+        g_LoggerGLTextureAtlas.Log(runtime::LOG_LEVEL_DEBUG, "Defragmented %zu images from %zu into %zu pages.",
+                                   live.size(), oldPages.size(), m_Pages.size());
+
+        for (auto &page: oldPages) {
+            DestroyPage(page);
+        }
+
+        m_Generation++;
+        return true;
+    }
+}
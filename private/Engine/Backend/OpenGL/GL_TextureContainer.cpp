@@ -0,0 +1,261 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#include <Engine/GLHeader.hpp>
+
+#include <Engine/Backend/OpenGL/GL_TextureContainer.hpp>
+#include <Engine/Backend/OpenGL/GL_TextureFormatEnums.hpp>
+
+#include <Engine/Runtime/Logger.hpp>
+
+namespace engine::backend::ogl {
+    static runtime::Logger g_LoggerGLTextureContainer("GLTextureContainer");
+
+    static constexpr unsigned char GL_KTX2_IDENTIFIER[12] = {0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'};
+
+    static constexpr uint32_t GL_MakeFourCC(char a, char b, char c, char d) {
+        return static_cast<uint32_t>(static_cast<unsigned char>(a)) |
+               (static_cast<uint32_t>(static_cast<unsigned char>(b)) << 8) |
+               (static_cast<uint32_t>(static_cast<unsigned char>(c)) << 16) |
+               (static_cast<uint32_t>(static_cast<unsigned char>(d)) << 24);
+    }
+
+    // files are little endian, as is every platform we ship on
+    template<typename T>
+    static T GL_ReadValue(std::span<const unsigned char> data, size_t offset) {
+        T value;
+        std::memcpy(&value, data.data() + offset, sizeof(T));
+        return value;
+    }
+
+    static unsigned int GL_MapVkFormat(uint32_t vkFormat) {
+        switch (vkFormat) {
+            case 131: return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;           // VK_FORMAT_BC1_RGB_UNORM_BLOCK
+            case 132: return GL_COMPRESSED_SRGB_S3TC_DXT1_EXT;
+            case 133: return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;          // VK_FORMAT_BC1_RGBA_UNORM_BLOCK
+            case 134: return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT;
+            case 135: return GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;          // VK_FORMAT_BC2_UNORM_BLOCK
+            case 136: return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT;
+            case 137: return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;          // VK_FORMAT_BC3_UNORM_BLOCK
+            case 138: return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT;
+            case 139: return GL_COMPRESSED_RED_RGTC1;                   // VK_FORMAT_BC4_UNORM_BLOCK
+            case 140: return GL_COMPRESSED_SIGNED_RED_RGTC1;
+            case 141: return GL_COMPRESSED_RG_RGTC2;                    // VK_FORMAT_BC5_UNORM_BLOCK
+            case 142: return GL_COMPRESSED_SIGNED_RG_RGTC2;
+            case 143: return GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT;     // VK_FORMAT_BC6H_UFLOAT_BLOCK
+            case 144: return GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT;
+            case 145: return GL_COMPRESSED_RGBA_BPTC_UNORM;             // VK_FORMAT_BC7_UNORM_BLOCK
+            case 146: return GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM;
+            case 147: return GL_COMPRESSED_RGB8_ETC2;                   // VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK
+            case 148: return GL_COMPRESSED_SRGB8_ETC2;
+            case 149: return GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2;
+            case 150: return GL_COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2;
+            case 151: return GL_COMPRESSED_RGBA8_ETC2_EAC;              // VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK
+            case 152: return GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC;
+            case 153: return GL_COMPRESSED_R11_EAC;                     // VK_FORMAT_EAC_R11_UNORM_BLOCK
+            case 154: return GL_COMPRESSED_SIGNED_R11_EAC;
+            case 155: return GL_COMPRESSED_RG11_EAC;
+            case 156: return GL_COMPRESSED_SIGNED_RG11_EAC;
+            default:
+                break;
+        }
+
+        // VK_FORMAT_ASTC_4x4_UNORM_BLOCK .. VK_FORMAT_ASTC_12x12_SRGB_BLOCK alternate unorm / srgb
+        if (vkFormat >= 157 && vkFormat <= 184) {
+            auto index = (vkFormat - 157) / 2;
+            auto srgb = (vkFormat - 157) % 2 == 1;
+            return (srgb ? GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR : GL_COMPRESSED_RGBA_ASTC_4x4_KHR) + index;
+        }
+
+        return 0;
+    }
+
+    static unsigned int GL_MapDxgiFormat(uint32_t dxgiFormat) {
+        switch (dxgiFormat) {
+            case 71: return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;           // DXGI_FORMAT_BC1_UNORM
+            case 72: return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT;
+            case 74: return GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;           // DXGI_FORMAT_BC2_UNORM
+            case 75: return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT;
+            case 77: return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;           // DXGI_FORMAT_BC3_UNORM
+            case 78: return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT;
+            case 80: return GL_COMPRESSED_RED_RGTC1;                    // DXGI_FORMAT_BC4_UNORM
+            case 81: return GL_COMPRESSED_SIGNED_RED_RGTC1;
+            case 83: return GL_COMPRESSED_RG_RGTC2;                     // DXGI_FORMAT_BC5_UNORM
+            case 84: return GL_COMPRESSED_SIGNED_RG_RGTC2;
+            case 95: return GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT;      // DXGI_FORMAT_BC6H_UF16
+            case 96: return GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT;
+            case 98: return GL_COMPRESSED_RGBA_BPTC_UNORM;              // DXGI_FORMAT_BC7_UNORM
+            case 99: return GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM;
+            default:
+                return 0;
+        }
+    }
+
+    static unsigned int GL_MapFourCC(uint32_t fourCC) {
+        switch (fourCC) {
+            case GL_MakeFourCC('D', 'X', 'T', '1'):
+                return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+            case GL_MakeFourCC('D', 'X', 'T', '3'):
+                return GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
+            case GL_MakeFourCC('D', 'X', 'T', '5'):
+                return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+            case GL_MakeFourCC('A', 'T', 'I', '1'):
+            case GL_MakeFourCC('B', 'C', '4', 'U'):
+                return GL_COMPRESSED_RED_RGTC1;
+            case GL_MakeFourCC('A', 'T', 'I', '2'):
+            case GL_MakeFourCC('B', 'C', '5', 'U'):
+                return GL_COMPRESSED_RG_RGTC2;
+            default:
+                return 0;
+        }
+    }
+
+    bool GL_ParseKTX2(std::span<const unsigned char> data, GLTextureContainer &container) {
+        // identifier, 9 header words, index (4 x uint32 + 2 x uint64)
+        constexpr size_t headerSize = 12 + 9 * 4 + 4 * 4 + 2 * 8;
+        constexpr size_t levelEntrySize = 3 * 8;
+
+        if (data.size() < headerSize || std::memcmp(data.data(), GL_KTX2_IDENTIFIER, sizeof(GL_KTX2_IDENTIFIER)) != 0) {
+            return false;
+        }
+
+        auto vkFormat = GL_ReadValue<uint32_t>(data, 12);
+        auto width = GL_ReadValue<uint32_t>(data, 20);
+        auto height = GL_ReadValue<uint32_t>(data, 24);
+        auto depth = GL_ReadValue<uint32_t>(data, 28);
+        auto layerCount = GL_ReadValue<uint32_t>(data, 32);
+        auto faceCount = GL_ReadValue<uint32_t>(data, 36);
+        auto levelCount = std::max<uint32_t>(GL_ReadValue<uint32_t>(data, 40), 1);
+        auto supercompression = GL_ReadValue<uint32_t>(data, 44);
+
+        if (supercompression != 0) {
+            g_LoggerGLTextureContainer.Log(runtime::LOG_LEVEL_ERROR, "Supercompressed KTX2 files are not supported.");
+            return false;
+        }
+
+        // arrays and cubemaps store several images per level, of which only the first would be read
+        if (depth > 1 || layerCount > 1 || faceCount != 1 || width == 0 || height == 0 ||
+            width > std::numeric_limits<int>::max() || height > std::numeric_limits<int>::max()) {
+            g_LoggerGLTextureContainer.Log(runtime::LOG_LEVEL_ERROR, "Only 2D KTX2 textures are supported.");
+            return false;
+        }
+
+        // levels past the 1x1 one would shift the size by 32 or more
+        levelCount = std::min<uint32_t>(levelCount, GL_GetFullMipCount(static_cast<int>(width), static_cast<int>(height)));
+
+        auto internalFormat = GL_MapVkFormat(vkFormat);
+
+        if (!internalFormat) {
+            g_LoggerGLTextureContainer.Log(runtime::LOG_LEVEL_ERROR, "Unsupported KTX2 format %u.", vkFormat);
+            return false;
+        }
+
+        if (data.size() < headerSize + levelCount * levelEntrySize) {
+            return false;
+        }
+
+        container.internalFormat = internalFormat;
+        container.width = static_cast<int>(width);
+        container.height = static_cast<int>(height);
+        container.levels.clear();
+
+        for (uint32_t level = 0; level < levelCount; level++) {
+            auto entry = headerSize + level * levelEntrySize;
+            auto offset = GL_ReadValue<uint64_t>(data, entry);
+            auto levelWidth = std::max(container.width >> level, 1);
+            auto levelHeight = std::max(container.height >> level, 1);
+            auto size = GL_GetCompressedImageSize(internalFormat, levelWidth, levelHeight);
+
+            // written so a huge offset cannot wrap around
+            if (offset > data.size() || size > data.size() - offset || size > GL_ReadValue<uint64_t>(data, entry + 8)) {
+                g_LoggerGLTextureContainer.Log(runtime::LOG_LEVEL_ERROR, "KTX2 level %u is truncated.", level);
+                return false;
+            }
+
+            container.levels.push_back({data.data() + offset, size, levelWidth, levelHeight});
+        }
+
+        return true;
+    }
+
+    bool GL_ParseDDS(std::span<const unsigned char> data, GLTextureContainer &container) {
+        constexpr size_t headerSize = 4 + 124;
+        constexpr size_t dx10HeaderSize = 20;
+        constexpr uint32_t pixelFormatFourCC = 0x4;
+
+        if (data.size() < headerSize || GL_ReadValue<uint32_t>(data, 0) != GL_MakeFourCC('D', 'D', 'S', ' ')) {
+            return false;
+        }
+
+        auto height = GL_ReadValue<uint32_t>(data, 12);
+        auto width = GL_ReadValue<uint32_t>(data, 16);
+        auto levelCount = std::max<uint32_t>(GL_ReadValue<uint32_t>(data, 28), 1);
+        auto pixelFormatFlags = GL_ReadValue<uint32_t>(data, 80);
+        auto fourCC = GL_ReadValue<uint32_t>(data, 84);
+
+        if (!(pixelFormatFlags & pixelFormatFourCC) || width == 0 || height == 0 ||
+            width > std::numeric_limits<int>::max() || height > std::numeric_limits<int>::max()) {
+            g_LoggerGLTextureContainer.Log(runtime::LOG_LEVEL_ERROR, "Only block-compressed DDS files are supported.");
+            return false;
+        }
+
+        levelCount = std::min<uint32_t>(levelCount, GL_GetFullMipCount(static_cast<int>(width), static_cast<int>(height)));
+
+        unsigned int internalFormat;
+        size_t offset = headerSize;
+
+        if (fourCC == GL_MakeFourCC('D', 'X', '1', '0')) {
+            if (data.size() < headerSize + dx10HeaderSize) {
+                return false;
+            }
+
+            internalFormat = GL_MapDxgiFormat(GL_ReadValue<uint32_t>(data, headerSize));
+            offset += dx10HeaderSize;
+        } else {
+            internalFormat = GL_MapFourCC(fourCC);
+        }
+
+        if (!internalFormat) {
+            g_LoggerGLTextureContainer.Log(runtime::LOG_LEVEL_ERROR, "Unsupported DDS pixel format.");
+            return false;
+        }
+
+        container.internalFormat = internalFormat;
+        container.width = static_cast<int>(width);
+        container.height = static_cast<int>(height);
+        container.levels.clear();
+
+        // levels are stored back to back, largest first
+        for (uint32_t level = 0; level < levelCount; level++) {
+            auto levelWidth = std::max(container.width >> level, 1);
+            auto levelHeight = std::max(container.height >> level, 1);
+            auto size = GL_GetCompressedImageSize(internalFormat, levelWidth, levelHeight);
+
+            if (offset > data.size() || size > data.size() - offset) {
+                g_LoggerGLTextureContainer.Log(runtime::LOG_LEVEL_ERROR, "DDS level %u is truncated.", level);
+                return false;
+            }
+
+            container.levels.push_back({data.data() + offset, size, levelWidth, levelHeight});
+            offset += size;
+        }
+
+        return true;
+    }
+
+    bool GL_ParseTextureContainer(std::span<const unsigned char> data, GLTextureContainer &container) {
+        if (data.size() >= sizeof(GL_KTX2_IDENTIFIER) &&
+            std::memcmp(data.data(), GL_KTX2_IDENTIFIER, sizeof(GL_KTX2_IDENTIFIER)) == 0) {
+            return GL_ParseKTX2(data, container);
+        }
+
+        if (data.size() >= 4 && GL_ReadValue<uint32_t>(data, 0) == GL_MakeFourCC('D', 'D', 'S', ' ')) {
+            return GL_ParseDDS(data, container);
+        }
+
+        g_LoggerGLTextureContainer.Log(runtime::LOG_LEVEL_ERROR, "Unrecognized texture container.");
+        return false;
+    }
+}
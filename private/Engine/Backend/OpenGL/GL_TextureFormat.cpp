@@ -0,0 +1,90 @@
+#include <algorithm>
+
+#include <Engine/GLHeader.hpp>
+
+#include <Engine/Backend/OpenGL/GL_TextureFormat.hpp>
+#include <Engine/Backend/OpenGL/GL_TextureFormatEnums.hpp>
+
+namespace engine::backend::ogl {
+    GLCompressedFormatInfo GL_GetCompressedFormatInfo(unsigned int internalFormat) {
+        using Family = GLCompressionFamily;
+
+        switch (internalFormat) {
+            case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+            case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
+            case GL_COMPRESSED_SRGB_S3TC_DXT1_EXT:
+            case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT:
+                return {Family::COMPRESSION_S3TC, 4, 4, 8};
+            case GL_COMPRESSED_RGBA_S3TC_DXT3_EXT:
+            case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+            case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT:
+            case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT:
+                return {Family::COMPRESSION_S3TC, 4, 4, 16};
+            case GL_COMPRESSED_RED_RGTC1:
+            case GL_COMPRESSED_SIGNED_RED_RGTC1:
+                return {Family::COMPRESSION_RGTC, 4, 4, 8};
+            case GL_COMPRESSED_RG_RGTC2:
+            case GL_COMPRESSED_SIGNED_RG_RGTC2:
+                return {Family::COMPRESSION_RGTC, 4, 4, 16};
+            case GL_COMPRESSED_RGBA_BPTC_UNORM:
+            case GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM:
+            case GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT:
+            case GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT:
+                return {Family::COMPRESSION_BPTC, 4, 4, 16};
+            case GL_COMPRESSED_RGB8_ETC2:
+            case GL_COMPRESSED_SRGB8_ETC2:
+            case GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2:
+            case GL_COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2:
+            case GL_COMPRESSED_R11_EAC:
+            case GL_COMPRESSED_SIGNED_R11_EAC:
+                return {Family::COMPRESSION_ETC2, 4, 4, 8};
+            case GL_COMPRESSED_RGBA8_ETC2_EAC:
+            case GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC:
+            case GL_COMPRESSED_RG11_EAC:
+            case GL_COMPRESSED_SIGNED_RG11_EAC:
+                return {Family::COMPRESSION_ETC2, 4, 4, 16};
+            default:
+                break;
+        }
+
+        // the ASTC LDR formats are contiguous, in the same block size order for linear and sRGB
+        static constexpr int astcBlocks[][2] = {
+                {4, 4}, {5, 4}, {5, 5}, {6, 5}, {6, 6}, {8, 5}, {8, 6},
+                {8, 8}, {10, 5}, {10, 6}, {10, 8}, {10, 10}, {12, 10}, {12, 12}
+        };
+        static constexpr unsigned int astcCount = sizeof(astcBlocks) / sizeof(astcBlocks[0]);
+        static constexpr unsigned int astcBases[] = {GL_COMPRESSED_RGBA_ASTC_4x4_KHR, GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR};
+
+        for (auto base: astcBases) {
+            if (internalFormat >= base && internalFormat < base + astcCount) {
+                auto &block = astcBlocks[internalFormat - base];
+                return {Family::COMPRESSION_ASTC, block[0], block[1], 16};
+            }
+        }
+
+        return {};
+    }
+
+    size_t GL_GetCompressedImageSize(unsigned int internalFormat, int width, int height) {
+        auto info = GL_GetCompressedFormatInfo(internalFormat);
+
+        if (!info.IsValid() || width <= 0 || height <= 0) {
+            return 0;
+        }
+
+        auto blocksX = static_cast<size_t>((width + info.blockWidth - 1) / info.blockWidth);
+        auto blocksY = static_cast<size_t>((height + info.blockHeight - 1) / info.blockHeight);
+
+        return blocksX * blocksY * info.blockBytes;
+    }
+
+    int GL_GetFullMipCount(int width, int height) {
+        int levels = 1;
+
+        for (auto size = std::max(width, height); size > 1; size >>= 1) {
+            levels++;
+        }
+
+        return levels;
+    }
+}
@@ -0,0 +1,375 @@
+#include <algorithm>
+#include <cstring>
+
+#include <Engine/GLHeader.hpp>
+
+#include <Engine/Backend/OpenGL/GL_Backend.hpp>
+#include <Engine/Backend/OpenGL/GL_Texture.hpp>
+#include <Engine/Backend/OpenGL/GL_TextureStreamer.hpp>
+
+#include <Engine/Runtime/Logger.hpp>
+
+namespace engine::backend::ogl {
+    static runtime::Logger g_LoggerGLTextureStreamer("GLTextureStreamer");
+
+    GLTextureStreamer::GLTextureStreamer(GLBackend *backend, size_t stagingBufferSize, int stagingBufferCount,
+                                         int workerCount)
+            : m_Backend(backend), m_StagingBufferSize(stagingBufferSize),
+              m_StagingBufferCount(std::max(stagingBufferCount, 1)), m_WorkerCount(std::max(workerCount, 1)) {}
+
+    GLTextureStreamer::~GLTextureStreamer() {
+        if (!m_StagingBuffers.empty()) {
+            g_LoggerGLTextureStreamer.Log(runtime::LOG_LEVEL_WARNING, "Texture streamer was not destroyed before being released!");
+        }
+    }
+
+    bool GLTextureStreamer::Create() {
+        if (!m_StagingBuffers.empty()) {
+            return true;
+        }
+
+        auto &stateCache = m_Backend->GetStateCache();
+        auto size = static_cast<GLsizeiptr>(m_StagingBufferSize);
+
+        m_Persistent = m_Backend->GetCapabilities().bufferStorage;
+        m_StagingBuffers.resize(m_StagingBufferCount);
+
+        for (auto &staging: m_StagingBuffers) {
+            glGenBuffers(1, &staging.handle);
+            stateCache.BindBuffer(GL_PIXEL_UNPACK_BUFFER, staging.handle);
+
+            if (m_Persistent) {
+                constexpr GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+                glBufferStorage(GL_PIXEL_UNPACK_BUFFER, size, nullptr, flags);
+                staging.mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, flags);
+            } else {
+                glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+            }
+        }
+
+        // a non-zero unpack buffer turns every other texture upload's pointer into an offset
+        stateCache.BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+        if (m_Persistent && std::any_of(m_StagingBuffers.begin(), m_StagingBuffers.end(),
+                                        [](const StagingBuffer &staging) { return !staging.mapped; })) {
+            g_LoggerGLTextureStreamer.Log(runtime::LOG_LEVEL_ERROR, "Failed to map staging buffers!");
+            Destroy();
+            return false;
+        }
+
+        m_Stopping = false;
+
+        for (int i = 0; i < m_WorkerCount; i++) {
+            m_Workers.emplace_back(&GLTextureStreamer::WorkerMain, this);
+        }
+
+        g_LoggerGLTextureStreamer.Log(runtime::LOG_LEVEL_DEBUG, "Created %d %s staging buffers of %zu bytes with %d workers.",
+                                      m_StagingBufferCount, m_Persistent ? "persistent" : "mapped-range",
+                                      m_StagingBufferSize, m_WorkerCount);
+
+        return true;
+    }
+
+    void GLTextureStreamer::Destroy() {
+        {
+            std::lock_guard lock(m_Mutex);
+            m_Stopping = true;
+            m_PendingBands.clear();
+        }
+
+        m_Condition.notify_all();
+
+        for (auto &worker: m_Workers) {
+            worker.join();
+        }
+
+        m_Workers.clear();
+        m_FinishedBands.clear();
+
+        auto &stateCache = m_Backend->GetStateCache();
+
+        for (auto &request: m_Requests) {
+            if (request->fence) {
+                glDeleteSync(static_cast<GLsync>(request->fence));
+            }
+
+            // the texture no longer waits for us, so its Destroy must not look for the request
+            if (request->texture) {
+                request->texture->m_Residency = GLTextureResidency::RESIDENCY_NONE;
+            }
+        }
+
+        m_Requests.clear();
+
+        for (auto &staging: m_StagingBuffers) {
+            if (staging.fence) {
+                glDeleteSync(static_cast<GLsync>(staging.fence));
+            }
+
+            if (staging.mapped) {
+                stateCache.BindBuffer(GL_PIXEL_UNPACK_BUFFER, staging.handle);
+                glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+            }
+
+            glDeleteBuffers(1, &staging.handle);
+            stateCache.OnBufferDeleted(staging.handle);
+        }
+
+        m_StagingBuffers.clear();
+    }
+
+    void GLTextureStreamer::WorkerMain() {
+        while (true) {
+            Band band;
+
+            {
+                std::unique_lock lock(m_Mutex);
+                m_Condition.wait(lock, [this]() { return m_Stopping || !m_PendingBands.empty(); });
+
+                if (m_Stopping) {
+                    return;
+                }
+
+                band = m_PendingBands.front();
+                m_PendingBands.pop_front();
+            }
+
+            // the request and its mapping stay untouched by the GL thread while the band is in flight
+            band.succeeded = band.request->source(band.firstRow, band.rowCount,
+                                                  static_cast<core::runtime::graphics::Color *>(band.destination));
+
+            std::lock_guard lock(m_Mutex);
+            m_FinishedBands.push_back(band);
+        }
+    }
+
+    bool GLTextureStreamer::Enqueue(GLTexture *texture, GLTextureSource source) {
+        if (!texture || !source || (m_StagingBuffers.empty() && !Create())) {
+            return false;
+        }
+
+        auto size = texture->GetSize();
+        auto width = static_cast<int>(size.x);
+        auto height = static_cast<int>(size.y);
+        auto rowSize = static_cast<size_t>(width) * sizeof(core::runtime::graphics::Color);
+
+        if (width <= 0 || height <= 0 || rowSize > m_StagingBufferSize) {
+            g_LoggerGLTextureStreamer.Log(runtime::LOG_LEVEL_ERROR, "Cannot stream a %dx%d texture!", width, height);
+            return false;
+        }
+
+        auto request = std::make_unique<Request>();
+        request->texture = texture;
+        request->source = std::move(source);
+        request->width = width;
+        request->height = height;
+        request->rowsPerBand = static_cast<int>(std::min<size_t>(m_StagingBufferSize / rowSize, height));
+
+        texture->m_Residency = GLTextureResidency::RESIDENCY_STREAMING;
+        m_Requests.emplace_back(std::move(request));
+
+        return true;
+    }
+
+    bool GLTextureStreamer::Enqueue(GLTexture *texture, std::shared_ptr<const core::runtime::graphics::Bitmap> bitmap) {
+        if (!bitmap) {
+            return false;
+        }
+
+        auto width = static_cast<size_t>(bitmap->Size().x);
+
+        return Enqueue(texture, [bitmap = std::move(bitmap), width](int firstRow, int rowCount,
+                                                                    core::runtime::graphics::Color *destination) {
+            const auto &pixels = bitmap->GetPixels();
+            auto first = static_cast<size_t>(firstRow) * width;
+            auto count = static_cast<size_t>(rowCount) * width;
+
+            if (first + count > pixels.size()) {
+                return false;
+            }
+
+            std::memcpy(destination, pixels.data() + first, count * sizeof(core::runtime::graphics::Color));
+            return true;
+        });
+    }
+
+    void GLTextureStreamer::Cancel(GLTexture *texture) {
+        for (auto &request: m_Requests) {
+            if (request->texture == texture) {
+                request->cancelled = true;
+                request->texture = nullptr;
+            }
+        }
+    }
+
+    bool GLTextureStreamer::IsSignaled(void *fence) {
+        if (!fence) {
+            return true;
+        }
+
+        auto result = glClientWaitSync(static_cast<GLsync>(fence), 0, 0);
+        return result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED;
+    }
+
+    int GLTextureStreamer::AcquireStagingBuffer() {
+        for (int i = 0; i < static_cast<int>(m_StagingBuffers.size()); i++) {
+            auto &staging = m_StagingBuffers[i];
+
+            if (staging.busy || !IsSignaled(staging.fence)) {
+                continue;
+            }
+
+            if (staging.fence) {
+                glDeleteSync(static_cast<GLsync>(staging.fence));
+                staging.fence = nullptr;
+            }
+
+            return i;
+        }
+
+        return -1;
+    }
+
+    void GLTextureStreamer::SubmitBand(const Band &band) {
+        auto &staging = m_StagingBuffers[band.staging];
+        auto &request = *band.request;
+        auto &stateCache = m_Backend->GetStateCache();
+
+        stateCache.BindBuffer(GL_PIXEL_UNPACK_BUFFER, staging.handle);
+
+        if (!m_Persistent) {
+            glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+            staging.mapped = nullptr;
+        }
+
+        if (!request.cancelled && band.succeeded) {
+            stateCache.BindTexture(GL_TEXTURE_2D, request.texture->GetHandle());
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, band.firstRow, request.width, band.rowCount, GL_RGBA,
+                            GL_UNSIGNED_BYTE, nullptr);
+
+            staging.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            m_Backend->GetCurrentFrameStats().textureStreamBytes +=
+                    static_cast<uint64_t>(request.width) * band.rowCount * sizeof(core::runtime::graphics::Color);
+        } else if (!band.succeeded && !request.cancelled) {
+            g_LoggerGLTextureStreamer.Log(runtime::LOG_LEVEL_ERROR, "Texture source failed for rows %d-%d; dropping upload.",
+                                          band.firstRow, band.firstRow + band.rowCount - 1);
+            request.texture->m_Residency = GLTextureResidency::RESIDENCY_NONE;
+            request.cancelled = true;
+            request.texture = nullptr;
+        }
+
+        staging.busy = false;
+        request.bandsInFlight--;
+    }
+
+    void GLTextureStreamer::Update() {
+        if (m_StagingBuffers.empty()) {
+            return;
+        }
+
+        auto &stateCache = m_Backend->GetStateCache();
+
+        std::vector<Band> finished;
+
+        {
+            std::lock_guard lock(m_Mutex);
+            finished.swap(m_FinishedBands);
+        }
+
+        for (auto &band: finished) {
+            SubmitBand(band);
+        }
+
+        // retire requests: fully submitted ones get a fence, signaled ones become resident
+        std::erase_if(m_Requests, [](std::unique_ptr<Request> &request) {
+            if (request->bandsInFlight > 0) {
+                return false;
+            }
+
+            if (request->cancelled) {
+                if (request->fence) {
+                    glDeleteSync(static_cast<GLsync>(request->fence));
+                }
+
+                return true;
+            }
+
+            if (request->nextRow < request->height) {
+                return false;
+            }
+
+            if (!request->fence) {
+                // every band is in; the mip chain can be derived on the GPU before the texture goes resident
+                request->texture->GenerateMipmaps();
+                request->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+                return false;
+            }
+
+            if (!IsSignaled(request->fence)) {
+                return false;
+            }
+
+            glDeleteSync(static_cast<GLsync>(request->fence));
+            request->texture->m_Residency = GLTextureResidency::RESIDENCY_RESIDENT;
+            return true;
+        });
+
+        // stage new bands; the first band of a frame is always allowed so huge rows cannot stall streaming
+        size_t stagedBytes = 0;
+        std::vector<Band> staged;
+
+        for (auto &request: m_Requests) {
+            while (!request->cancelled && request->nextRow < request->height) {
+                auto rowCount = std::min(request->rowsPerBand, request->height - request->nextRow);
+                auto bytes = static_cast<size_t>(request->width) * rowCount * sizeof(core::runtime::graphics::Color);
+
+                if (stagedBytes > 0 && stagedBytes + bytes > m_FrameBudget) {
+                    break;
+                }
+
+                auto stagingIndex = AcquireStagingBuffer();
+
+                if (stagingIndex < 0) {
+                    break;
+                }
+
+                auto &staging = m_StagingBuffers[stagingIndex];
+
+                if (!m_Persistent) {
+                    stateCache.BindBuffer(GL_PIXEL_UNPACK_BUFFER, staging.handle);
+                    staging.mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(bytes),
+                                                      GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+
+                    if (!staging.mapped) {
+                        g_LoggerGLTextureStreamer.Log(runtime::LOG_LEVEL_ERROR, "Failed to map a staging buffer!");
+                        break;
+                    }
+                }
+
+                staging.busy = true;
+                staged.push_back({request.get(), stagingIndex, staging.mapped, request->nextRow, rowCount, false});
+
+                request->nextRow += rowCount;
+                request->bandsInFlight++;
+                stagedBytes += bytes;
+            }
+
+            if (stagedBytes >= m_FrameBudget) {
+                break;
+            }
+        }
+
+        stateCache.BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+        if (!staged.empty()) {
+            {
+                std::lock_guard lock(m_Mutex);
+                m_PendingBands.insert(m_PendingBands.end(), staged.begin(), staged.end());
+            }
+
+            m_Condition.notify_all();
+        }
+    }
+}
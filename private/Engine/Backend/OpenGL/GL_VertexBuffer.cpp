@@ -1,32 +1,60 @@
+#include <algorithm>
 #include <stdexcept>
 #include <cstdio>
+#include <cstring>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
 
 #include <Engine/GLHeader.hpp>
 
+#include <Engine/Backend/OpenGL/GL_Backend.hpp>
+#include <Engine/Backend/OpenGL/GL_EnumMapping.hpp>
 #include <Engine/Backend/OpenGL/GL_VertexBuffer.hpp>
 
+#include <Engine/Runtime/Logger.hpp>
+
 namespace engine::backend::ogl {
-    static unsigned int GL_VertexBuffer_CurrentBoundVAO = 0;
+    static runtime::Logger g_LoggerGLVertexBuffer("GLVertexBuffer");
 
     bool GLVertexBuffer::Create() {
-        glGenVertexArrays(1, &m_VaoHandle);
-        glGenBuffers(1, &m_VboHandle);
+        auto &pool = m_Backend->GetResourcePool();
+        m_VaoHandle = pool.GenName(GLNameType::NAME_VERTEX_ARRAY);
+        m_VboHandle = pool.GenName(GLNameType::NAME_BUFFER);
         return m_VaoHandle != 0 && m_VboHandle != 0;
     }
 
     void GLVertexBuffer::Destroy() {
-        if(GL_VertexBuffer_CurrentBoundVAO == m_VaoHandle) {
-            Unbind();
-        }
+        m_Backend->GetWorkerPool().Cancel(this);
+
+        // draws of this frame may still read from the objects; the storage is recycled once the GPU is done,
+        // since storage of the same size is likely to be asked for again soon (transient meshes, particles)
+        auto &deletionQueue = m_Backend->GetDeletionQueue();
 
         if (m_VboHandle) {
-            glDeleteBuffers(1, &m_VboHandle);
+            deletionQueue.ReleaseBuffer(m_VboHandle, m_Capacity, GL_MapUsageType(m_UsageHint));
             m_VboHandle = 0;
         }
+        if (m_EboHandle) {
+            deletionQueue.ReleaseBuffer(m_EboHandle);
+            m_EboHandle = 0;
+            m_IndexCount = 0;
+        }
         if (m_VaoHandle) {
-            glDeleteVertexArrays(1, &m_VaoHandle);
+            deletionQueue.ReleaseVertexArray(m_VaoHandle);
             m_VaoHandle = 0;
         }
+
+        m_Capacity = 0;
+        m_AttributeSource = 0;
+
+        // instance attributes were VAO state
+        m_InstanceLayout.clear();
+        m_InstanceStride = 0;
+        m_InstanceCount = 0;
+        m_BaseInstance = 0;
+        m_InstanceSource = 0;
+        m_InstanceSourceOffset = 0;
     }
 
     void GLVertexBuffer::Bind() {
@@ -35,22 +63,16 @@ namespace engine::backend::ogl {
             Create();
         }
 
-        // make sure we aren't binding the same VAO many times
-        if(GL_VertexBuffer_CurrentBoundVAO == m_VaoHandle) {
-            return;
-        }
-
-        GL_VertexBuffer_CurrentBoundVAO = m_VaoHandle;
-
-        glBindVertexArray(m_VaoHandle);
-        glBindBuffer(GL_ARRAY_BUFFER, m_VboHandle);
+        // the state cache makes sure we aren't binding the same VAO many times
+        auto &stateCache = m_Backend->GetStateCache();
+        stateCache.BindVertexArray(m_VaoHandle);
+        stateCache.BindBuffer(GL_ARRAY_BUFFER, m_VboHandle);
     }
 
     void GLVertexBuffer::Unbind() {
-        GL_VertexBuffer_CurrentBoundVAO = 0;
-
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        glBindVertexArray(0);
+        auto &stateCache = m_Backend->GetStateCache();
+        stateCache.BindBuffer(GL_ARRAY_BUFFER, 0);
+        stateCache.BindVertexArray(0);
     }
 
     GLenum GL_MapUsageType(core::runtime::graphics::BufferUsageHint usage) {
@@ -81,9 +103,290 @@ namespace engine::backend::ogl {
         }
     }
 
+    size_t GL_GetIndexSize(GLenum indexType) {
+        return indexType == GL_UNSIGNED_SHORT ? sizeof(uint16_t) : sizeof(uint32_t);
+    }
+
     void GLVertexBuffer::Draw() {
+        if (!ResolveStreamedVertices()) {
+            return;
+        }
+
+        if (m_IndexCount > 0) {
+            DrawIndexedRange(0, m_IndexCount, m_FirstVertex);
+            return;
+        }
+
+        Bind();
+        glDrawArrays(GL_MapPrimitiveType(m_PrimType), m_FirstVertex, (GLsizei) m_VertexCount);
+        m_Backend->GetCurrentFrameStats().CountDraw(m_VertexCount);
+    }
+
+    void GLVertexBuffer::DrawIndexedRange(size_t firstIndex, size_t indexCount, int baseVertex) {
+        if (firstIndex >= m_IndexCount || !ResolveStreamedVertices()) {
+            return;
+        }
+
+        indexCount = std::min(indexCount, m_IndexCount - firstIndex);
+
+        Bind();
+
+        auto mode = GL_MapPrimitiveType(m_PrimType);
+        auto offset = reinterpret_cast<const void *>(firstIndex * GL_GetIndexSize(m_IndexType));
+
+        if (baseVertex == 0) {
+            glDrawElements(mode, (GLsizei) indexCount, m_IndexType, offset);
+        } else if (m_Backend->GetCapabilities().drawElementsBaseVertex) {
+            glDrawElementsBaseVertex(mode, (GLsizei) indexCount, m_IndexType, offset, baseVertex);
+        } else {
+            g_LoggerGLVertexBuffer.Log(runtime::LOG_LEVEL_ERROR, "Base vertex draws are not supported by this context!");
+            return;
+        }
+
+        m_Backend->GetCurrentFrameStats().CountDraw(indexCount);
+    }
+
+    void GLVertexBuffer::UploadIndexData(const void *data, size_t count, unsigned int indexType,
+                                         core::runtime::graphics::BufferUsageHint usage) {
+        // GL_ELEMENT_ARRAY_BUFFER is VAO state, so the VAO must be bound while attaching the buffer
+        Bind();
+
+        if (!m_EboHandle) {
+            m_EboHandle = m_Backend->GetResourcePool().GenName(GLNameType::NAME_BUFFER);
+        }
+
+        m_Backend->GetStateCache().BindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EboHandle);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(count * GL_GetIndexSize(indexType)), data,
+                     GL_MapUsageType(usage));
+        m_Backend->GetCurrentFrameStats().bufferUploadBytes += count * GL_GetIndexSize(indexType);
+
+        m_IndexCount = count;
+        m_IndexType = indexType;
+    }
+
+    void GLVertexBuffer::UploadIndices(std::span<const uint16_t> indices, core::runtime::graphics::BufferUsageHint usage) {
+        UploadIndexData(indices.data(), indices.size(), GL_UNSIGNED_SHORT, usage);
+    }
+
+    void GLVertexBuffer::UploadIndices(std::span<const uint32_t> indices, core::runtime::graphics::BufferUsageHint usage) {
+        UploadIndexData(indices.data(), indices.size(), GL_UNSIGNED_INT, usage);
+    }
+
+    void GLVertexBuffer::ClearIndices() {
+        m_IndexCount = 0;
+    }
+
+    std::vector<GLInstanceAttribute> GL_GetDefaultInstanceLayout() {
+        std::vector<GLInstanceAttribute> layout;
+
+        for (unsigned int column = 0; column < 4; column++) {
+            layout.push_back({
+                    GL_INSTANCE_ATTRIBUTE_BASE + column,
+                    4,
+                    GL_FLOAT,
+                    false,
+                    false,
+                    offsetof(GLInstanceData, transform) + column * sizeof(glm::vec4)
+            });
+        }
+
+        layout.push_back({
+                GL_INSTANCE_ATTRIBUTE_BASE + 4,
+                4,
+                GL_UNSIGNED_BYTE,
+                true,
+                false,
+                offsetof(GLInstanceData, color)
+        });
+
+        return layout;
+    }
+
+    void GLVertexBuffer::SetInstanceLayout(std::span<const GLInstanceAttribute> attributes, size_t stride) {
+        Bind();
+
+        for (auto &attribute: m_InstanceLayout) {
+            glDisableVertexAttribArray(attribute.location);
+        }
+
+        m_InstanceLayout.assign(attributes.begin(), attributes.end());
+        m_InstanceStride = stride;
+        m_InstanceCount = 0;
+        m_InstanceSource = 0;
+
+        // the arrays are enabled once UploadInstances has given them a pointer
+        for (auto &attribute: m_InstanceLayout) {
+            glVertexAttribDivisor(attribute.location, 1);
+        }
+    }
+
+    void GLVertexBuffer::ConfigureInstanceAttributes(unsigned int sourceBuffer, size_t byteOffset) {
+        if (m_InstanceSource == sourceBuffer && m_InstanceSourceOffset == byteOffset) {
+            return;
+        }
+
+        m_InstanceSource = sourceBuffer;
+        m_InstanceSourceOffset = byteOffset;
+
+        Bind();
+        m_Backend->GetStateCache().BindBuffer(GL_ARRAY_BUFFER, sourceBuffer);
+
+        for (auto &attribute: m_InstanceLayout) {
+            auto pointer = reinterpret_cast<const void *>(byteOffset + attribute.offset);
+
+            if (attribute.integer) {
+                glVertexAttribIPointer(attribute.location, attribute.components, attribute.type,
+                                       static_cast<GLsizei>(m_InstanceStride), pointer);
+            } else {
+                glVertexAttribPointer(attribute.location, attribute.components, attribute.type,
+                                      attribute.normalized ? GL_TRUE : GL_FALSE, static_cast<GLsizei>(m_InstanceStride), pointer);
+            }
+
+            glEnableVertexAttribArray(attribute.location);
+        }
+    }
+
+    bool GLVertexBuffer::UploadInstances(const void *data, size_t instanceCount) {
+        if (m_InstanceLayout.empty() || m_InstanceStride == 0) {
+            g_LoggerGLVertexBuffer.Log(runtime::LOG_LEVEL_ERROR, "No instance layout has been set!");
+            return false;
+        }
+
+        m_InstanceCount = 0;
+
+        if (instanceCount == 0) {
+            return true;
+        }
+
+        auto &stream = m_Backend->GetVertexStream();
+        auto allocation = stream.Allocate(instanceCount * m_InstanceStride, m_InstanceStride);
+
+        if (!allocation.IsValid()) {
+            g_LoggerGLVertexBuffer.Log(runtime::LOG_LEVEL_ERROR, "Instance data does not fit in a stream region!");
+            return false;
+        }
+
+        std::memcpy(allocation.data, data, allocation.size);
+        stream.Commit(allocation);
+
+        // with base instance support the attribute pointers stay at offset 0 and the draw selects the records;
+        // otherwise the pointers are moved to the new records, which only touches the instance attributes
+        if (m_Backend->GetCapabilities().baseInstance) {
+            m_BaseInstance = static_cast<int>(allocation.offset / m_InstanceStride);
+            ConfigureInstanceAttributes(stream.GetHandle(), 0);
+        } else {
+            m_BaseInstance = 0;
+            ConfigureInstanceAttributes(stream.GetHandle(), allocation.offset);
+        }
+
+        m_InstanceCount = instanceCount;
+        return true;
+    }
+
+    bool GLVertexBuffer::UploadInstances(std::span<const GLInstanceData> instances) {
+        return UploadInstances(instances.data(), instances.size());
+    }
+
+    void GLVertexBuffer::DrawInstanced() {
+        if (m_InstanceCount == 0 || !ResolveStreamedVertices()) {
+            return;
+        }
+
         Bind();
-        glDrawArrays(GL_MapPrimitiveType(m_PrimType), 0, (GLsizei) m_VertexCount);
+
+        auto mode = GL_MapPrimitiveType(m_PrimType);
+        auto instanceCount = static_cast<GLsizei>(m_InstanceCount);
+        auto baseInstance = static_cast<GLuint>(m_BaseInstance);
+
+        if (m_IndexCount == 0) {
+            if (baseInstance != 0) {
+                glDrawArraysInstancedBaseInstance(mode, m_FirstVertex, (GLsizei) m_VertexCount, instanceCount, baseInstance);
+            } else {
+                glDrawArraysInstanced(mode, m_FirstVertex, (GLsizei) m_VertexCount, instanceCount);
+            }
+
+            m_Backend->GetCurrentFrameStats().CountDraw(m_VertexCount, m_InstanceCount);
+            return;
+        }
+
+        auto indexCount = static_cast<GLsizei>(m_IndexCount);
+
+        if (baseInstance != 0) {
+            glDrawElementsInstancedBaseVertexBaseInstance(mode, indexCount, m_IndexType, nullptr, instanceCount,
+                                                          m_FirstVertex, baseInstance);
+        } else if (m_FirstVertex == 0) {
+            glDrawElementsInstanced(mode, indexCount, m_IndexType, nullptr, instanceCount);
+        } else if (m_Backend->GetCapabilities().drawElementsBaseVertex) {
+            glDrawElementsInstancedBaseVertex(mode, indexCount, m_IndexType, nullptr, instanceCount, m_FirstVertex);
+        } else {
+            g_LoggerGLVertexBuffer.Log(runtime::LOG_LEVEL_ERROR, "Base vertex draws are not supported by this context!");
+            return;
+        }
+
+        m_Backend->GetCurrentFrameStats().CountDraw(m_IndexCount, m_InstanceCount);
+    }
+
+    struct GL_VertexKeyHash {
+        size_t operator()(const core::runtime::graphics::Vertex &vertex) const {
+            auto bytes = std::string_view(reinterpret_cast<const char *>(&vertex), sizeof(vertex));
+            return std::hash<std::string_view>()(bytes);
+        }
+    };
+
+    struct GL_VertexKeyEqual {
+        bool operator()(const core::runtime::graphics::Vertex &a, const core::runtime::graphics::Vertex &b) const {
+            // bitwise; Vertex is tightly packed, and -0.0/+0.0 or NaNs are rare enough to not matter here
+            return std::memcmp(&a, &b, sizeof(core::runtime::graphics::Vertex)) == 0;
+        }
+    };
+
+    void GLVertexBuffer::BuildIndexList(
+            const std::vector<core::runtime::graphics::Vertex> &data,
+            std::vector<core::runtime::graphics::Vertex> &uniqueVertices,
+            std::vector<uint32_t> &indices
+    ) {
+        std::unordered_map<core::runtime::graphics::Vertex, uint32_t, GL_VertexKeyHash, GL_VertexKeyEqual> lookup;
+        lookup.reserve(data.size());
+
+        uniqueVertices.clear();
+        uniqueVertices.reserve(data.size());
+        indices.clear();
+        indices.reserve(data.size());
+
+        for (auto &vertex: data) {
+            auto [it, inserted] = lookup.try_emplace(vertex, static_cast<uint32_t>(uniqueVertices.size()));
+
+            if (inserted) {
+                uniqueVertices.emplace_back(vertex);
+            }
+
+            indices.emplace_back(it->second);
+        }
+    }
+
+    void GLVertexBuffer::UploadDeduplicated(
+            const std::vector<core::runtime::graphics::Vertex> &data,
+            core::runtime::graphics::PrimitiveType type,
+            core::runtime::graphics::BufferUsageHint usage
+    ) {
+        std::vector<core::runtime::graphics::Vertex> uniqueVertices;
+        std::vector<uint32_t> indices;
+        BuildIndexList(data, uniqueVertices, indices);
+
+        // streamed vertices can only be indexed through a base vertex
+        if (usage == core::runtime::graphics::BufferUsageHint::BUFFER_USAGE_HINT_STREAM &&
+            !m_Backend->GetCapabilities().drawElementsBaseVertex) {
+            usage = core::runtime::graphics::BufferUsageHint::BUFFER_USAGE_HINT_DYNAMIC;
+        }
+
+        Upload(uniqueVertices, type, usage);
+
+        if (uniqueVertices.size() <= 0xFFFF) {
+            std::vector<uint16_t> shortIndices(indices.begin(), indices.end());
+            UploadIndices(shortIndices, usage);
+        } else {
+            UploadIndices(indices, usage);
+        }
     }
 
     void GLVertexBuffer::Upload(
@@ -91,62 +394,368 @@ namespace engine::backend::ogl {
             core::runtime::graphics::PrimitiveType type,
             core::runtime::graphics::BufferUsageHint usage
     ) {
+        // indexed streaming draws need a base vertex to reach into the ring
+        auto canStream = m_IndexCount == 0 || m_Backend->GetCapabilities().drawElementsBaseVertex;
+
+        if (usage == core::runtime::graphics::BufferUsageHint::BUFFER_USAGE_HINT_STREAM && !data.empty() && canStream) {
+            // packed layouts are encoded straight into the ring
+            if (auto memory = MapStreamBytes(data.size(), type)) {
+                WriteVertices(data, memory);
+                CommitStream(data.size());
+                return;
+            }
+        }
+
         Bind();
 
+        auto bytes = data.size() * m_Layout.stride;
+        auto source = PrepareVertices(data);
+
+        // a buffer without storage yet can take over a recycled one of about the same size
+        if (m_Capacity == 0 && bytes > 0) {
+            size_t recycledCapacity = 0;
+            auto &pool = m_Backend->GetResourcePool();
+
+            if (auto recycled = pool.AcquireBuffer(bytes, GL_MapUsageType(usage), recycledCapacity)) {
+                pool.ReleaseName(GLNameType::NAME_BUFFER, m_VboHandle);
+
+                if (m_AttributeSource == m_VboHandle) {
+                    m_AttributeSource = 0;
+                }
+
+                m_VboHandle = recycled;
+                m_Capacity = recycledCapacity;
+                m_UsageHint = usage;
+                m_Backend->GetStateCache().BindBuffer(GL_ARRAY_BUFFER, m_VboHandle);
+            }
+        }
+
+        // re-specifying storage on every upload makes the driver reallocate; reuse it whenever it fits
+        if (bytes > m_Capacity || usage != m_UsageHint) {
+            // buffers that get re-uploaded grow with headroom; first uploads and static data are sized exactly
+            auto newCapacity = bytes;
+
+            if (m_Capacity > 0 && bytes > m_Capacity &&
+                usage != core::runtime::graphics::BufferUsageHint::BUFFER_USAGE_HINT_STATIC) {
+                newCapacity = std::max(bytes, m_Capacity + m_Capacity / 2);
+            }
+
+            m_UsageHint = usage;
+
+            if (newCapacity == bytes) {
+                glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(bytes), source, GL_MapUsageType(m_UsageHint));
+            } else {
+                glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(newCapacity), nullptr, GL_MapUsageType(m_UsageHint));
+                glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(bytes), source);
+            }
+
+            m_Capacity = newCapacity;
+        } else if (bytes > 0) {
+            glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(bytes), source);
+        }
+
+        m_Backend->GetCurrentFrameStats().bufferUploadBytes += bytes;
+
         m_VertexCount = data.size();
         m_PrimType = type;
-        m_UsageHint = usage;
-
-        glBufferData(GL_ARRAY_BUFFER, data.size() * sizeof(core::runtime::graphics::Vertex), data.data(),
-                     GL_MapUsageType(m_UsageHint));
-
-        // configure vertex attributes
-        glEnableVertexAttribArray(0); // position attribute
-        glVertexAttribPointer(
-                0,
-                3,
-                GL_FLOAT,
-                GL_FALSE,
-                sizeof(core::runtime::graphics::Vertex),
-                (void*)offsetof(core::runtime::graphics::Vertex, position)
-        );
-
-        glEnableVertexAttribArray(1); // UV attribute
-        glVertexAttribPointer(
-                1,
-                2,
-                GL_FLOAT,
-                GL_FALSE,
-                sizeof(core::runtime::graphics::Vertex),
-                (void*)offsetof(core::runtime::graphics::Vertex, uv)
-        );
-
-        glEnableVertexAttribArray(2); // normal attribute
-        glVertexAttribPointer(
-                2,
-                3,
-                GL_FLOAT,
-                GL_FALSE,
-                sizeof(core::runtime::graphics::Vertex),
-                (void*)offsetof(core::runtime::graphics::Vertex, normal)
-        );
-
-        glEnableVertexAttribArray(3); // color attribute (NORMALIZED)
-        glVertexAttribPointer(
-                3,
-                4,
-                GL_UNSIGNED_BYTE,
-                GL_TRUE,
-                sizeof(core::runtime::graphics::Vertex),
-                (void*)offsetof(core::runtime::graphics::Vertex, color)
-        );
+        m_FirstVertex = 0;
+
+        ConfigureAttributes(m_VboHandle);
     }
 
-    size_t GLVertexBuffer::Size() {
-        GLint size = 0;
+    bool GLVertexBuffer::UploadOnWorker(std::vector<core::runtime::graphics::Vertex> data,
+                                        core::runtime::graphics::PrimitiveType type) {
+        auto &workers = m_Backend->GetWorkerPool();
+
+        if (!workers.IsAvailable() || data.empty()) {
+            Upload(data, type, core::runtime::graphics::BufferUsageHint::BUFFER_USAGE_HINT_STATIC);
+            return true;
+        }
+
+        workers.Cancel(this);
+
+        auto vertexCount = data.size();
+        auto bytes = vertexCount * m_Layout.stride;
+        auto handle = std::make_shared<GLuint>(0);
+
+        // buffer objects are shared, VAOs are not: the worker only fills the buffer, attributes are set up here
+        auto job = [data = std::move(data), layout = m_Layout, packed = m_PackedLayout, bytes, handle]() {
+            std::vector<unsigned char> encoded;
+            const void *source = data.data();
+
+            if (packed) {
+                encoded.resize(bytes);
+                GL_EncodeVertices(layout, data, encoded.data());
+                source = encoded.data();
+            }
+
+            glGenBuffers(1, handle.get());
+            glBindBuffer(GL_ARRAY_BUFFER, *handle);
+            glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(bytes), source, GL_STATIC_DRAW);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+        };
+
+        auto completion = [this, handle, vertexCount, bytes, type](bool cancelled) {
+            if (cancelled) {
+                glDeleteBuffers(1, handle.get());
+                return;
+            }
+
+            Bind();
+
+            m_Backend->GetDeletionQueue().ReleaseBuffer(m_VboHandle, m_Capacity, GL_MapUsageType(m_UsageHint));
+
+            if (m_AttributeSource == m_VboHandle) {
+                m_AttributeSource = 0;
+            }
+
+            m_VboHandle = *handle;
+            m_Capacity = bytes;
+            m_UsageHint = core::runtime::graphics::BufferUsageHint::BUFFER_USAGE_HINT_STATIC;
+            m_VertexCount = vertexCount;
+            m_PrimType = type;
+            m_FirstVertex = 0;
+
+            ConfigureAttributes(m_VboHandle);
+        };
+
+        return workers.Submit(this, std::move(job), std::move(completion));
+    }
+
+    void GLVertexBuffer::WriteVertices(std::span<const core::runtime::graphics::Vertex> data, void *destination) const {
+        if (m_PackedLayout) {
+            GL_EncodeVertices(m_Layout, data, destination);
+        } else {
+            std::memcpy(destination, data.data(), data.size_bytes());
+        }
+    }
+
+    const void *GLVertexBuffer::PrepareVertices(std::span<const core::runtime::graphics::Vertex> data) {
+        if (!m_PackedLayout) {
+            return data.data();
+        }
+
+        m_EncodeScratch.resize(data.size() * m_Layout.stride);
+        GL_EncodeVertices(m_Layout, data, m_EncodeScratch.data());
+        return m_EncodeScratch.data();
+    }
+
+    void *GLVertexBuffer::MapStreamBytes(size_t vertexCount, core::runtime::graphics::PrimitiveType type) {
+        auto &stream = m_Backend->GetVertexStream();
+
+        // aligning to the vertex size lets the draw address the data through the first vertex index
+        m_StreamAllocation = stream.Allocate(vertexCount * m_Layout.stride, m_Layout.stride);
+
+        if (!m_StreamAllocation.IsValid()) {
+            return nullptr;
+        }
+
+        m_StreamEpoch = stream.GetEpoch();
+
+        m_PrimType = type;
+        m_UsageHint = core::runtime::graphics::BufferUsageHint::BUFFER_USAGE_HINT_STREAM;
+
+        return m_StreamAllocation.data;
+    }
+
+    core::runtime::graphics::Vertex *GLVertexBuffer::MapStream(size_t vertexCount, core::runtime::graphics::PrimitiveType type) {
+        if (m_PackedLayout) {
+            g_LoggerGLVertexBuffer.Log(runtime::LOG_LEVEL_ERROR, "Cannot map Vertex memory for a packed vertex layout!");
+            return nullptr;
+        }
+
+        return static_cast<core::runtime::graphics::Vertex *>(MapStreamBytes(vertexCount, type));
+    }
+
+    void GLVertexBuffer::CommitStream(size_t vertexCount) {
+        if (!m_StreamAllocation.IsValid()) {
+            return;
+        }
+
+        auto &stream = m_Backend->GetVertexStream();
+        stream.Commit(m_StreamAllocation);
+
+        m_VertexCount = std::min(vertexCount, m_StreamAllocation.size / m_Layout.stride);
+        m_FirstVertex = static_cast<int>(m_StreamAllocation.offset / m_Layout.stride);
+        m_StreamAllocation = {};
+        m_StreamFrame = m_Backend->GetFrameIndex();
+
         Bind();
-        glGetBufferParameteriv(GL_ARRAY_BUFFER, GL_BUFFER_SIZE, &size);
-        return static_cast<size_t>(size);
+        ConfigureAttributes(stream.GetHandle());
+    }
+
+    void GLVertexBuffer::SetLayout(const GLVertexLayout &layout) {
+        if (layout == m_Layout) {
+            return;
+        }
+
+        if (layout.elements.empty() || layout.stride == 0) {
+            g_LoggerGLVertexBuffer.Log(runtime::LOG_LEVEL_ERROR, "Cannot use an empty vertex layout!");
+            return;
+        }
+
+        // a pending worker upload was encoded with the old layout
+        m_Backend->GetWorkerPool().Cancel(this);
+
+        m_Layout = layout;
+        m_PackedLayout = !layout.IsStandard();
+
+        // the stored vertices are in the old format; the next upload re-points the attributes
+        m_VertexCount = 0;
+        m_FirstVertex = 0;
+        m_AttributeSource = 0;
+    }
+
+    void GLVertexBuffer::ReserveStorage(size_t bytes, size_t preserveBytes) {
+        if (bytes <= m_Capacity) {
+            return;
+        }
+
+        auto newCapacity = std::max(bytes, m_Capacity + m_Capacity / 2);
+
+        auto &pool = m_Backend->GetResourcePool();
+        auto &stateCache = m_Backend->GetStateCache();
+        size_t recycledCapacity = 0;
+        GLuint newBuffer = pool.AcquireBuffer(newCapacity, GL_MapUsageType(m_UsageHint), recycledCapacity);
+
+        if (newBuffer) {
+            newCapacity = recycledCapacity;
+            stateCache.BindBuffer(GL_ARRAY_BUFFER, newBuffer);
+        } else {
+            newBuffer = pool.GenName(GLNameType::NAME_BUFFER);
+            stateCache.BindBuffer(GL_ARRAY_BUFFER, newBuffer);
+            glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(newCapacity), nullptr, GL_MapUsageType(m_UsageHint));
+        }
+
+        // copy the existing contents on the GPU instead of round-tripping them through the CPU
+        if (preserveBytes > 0 && m_Capacity > 0) {
+            stateCache.BindBuffer(GL_COPY_WRITE_BUFFER, newBuffer);
+            glBindBuffer(GL_COPY_READ_BUFFER, m_VboHandle);
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0,
+                                static_cast<GLsizeiptr>(std::min(preserveBytes, m_Capacity)));
+            glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        }
+
+        // earlier draws of this frame still read from the old buffer
+        m_Backend->GetDeletionQueue().ReleaseBuffer(m_VboHandle, m_Capacity, GL_MapUsageType(m_UsageHint));
+
+        if (m_AttributeSource == m_VboHandle) {
+            m_AttributeSource = 0;
+        }
+
+        m_VboHandle = newBuffer;
+        m_Capacity = newCapacity;
+    }
+
+    bool GLVertexBuffer::ResolveStreamedVertices() {
+        // checked first: GetVertexStream creates the ring, which buffers that never streamed must not do
+        if (m_AttributeSource == 0 || m_AttributeSource == m_VboHandle) {
+            return true;
+        }
+
+        auto &stream = m_Backend->GetVertexStream();
+
+        if (m_AttributeSource != stream.GetHandle()) {
+            return true;
+        }
+
+        if (!stream.IsIntact(m_StreamEpoch)) {
+            g_LoggerGLVertexBuffer.Log(runtime::LOG_LEVEL_ERROR,
+                                       "Streamed vertices were overwritten by the stream ring before being used!");
+            return false;
+        }
+
+        if (m_StreamFrame == m_Backend->GetFrameIndex()) {
+            return true;
+        }
+
+        // the region is only handed out again a few frames from now; copy the vertices while it holds them
+        auto bytes = m_VertexCount * m_Layout.stride;
+        auto offset = GetSourceOffset();
+
+        Bind();
+
+        if (bytes > 0) {
+            ReserveStorage(bytes, 0);
+
+            auto &stateCache = m_Backend->GetStateCache();
+            stateCache.BindBuffer(GL_COPY_WRITE_BUFFER, m_VboHandle);
+            glBindBuffer(GL_COPY_READ_BUFFER, stream.GetHandle());
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(offset), 0,
+                                static_cast<GLsizeiptr>(bytes));
+            glBindBuffer(GL_COPY_READ_BUFFER, 0);
+
+            // the fence the ring waits on before reusing the region predates the copy
+            stream.Refence(offset);
+        }
+
+        m_FirstVertex = 0;
+
+        Bind();
+        ConfigureAttributes(m_VboHandle);
+        return true;
+    }
+
+    bool GLVertexBuffer::UpdateRange(size_t firstVertex, std::span<const core::runtime::graphics::Vertex> data) {
+        if (data.empty()) {
+            return true;
+        }
+
+        if (m_AttributeSource != 0 && m_AttributeSource != m_VboHandle) {
+            g_LoggerGLVertexBuffer.Log(runtime::LOG_LEVEL_ERROR, "Cannot update a range of a streaming vertex buffer!");
+            return false;
+        }
+
+        // ranges above this size are written through a mapping instead of being copied by glBufferSubData
+        static constexpr size_t MAPPED_UPDATE_THRESHOLD = 64 * 1024;
+
+        Bind();
+
+        auto offset = firstVertex * m_Layout.stride;
+        auto bytes = data.size() * m_Layout.stride;
+
+        ReserveStorage(offset + bytes, m_VertexCount * m_Layout.stride);
+        m_Backend->GetStateCache().BindBuffer(GL_ARRAY_BUFFER, m_VboHandle);
+
+        void *mapped = nullptr;
+
+        if (bytes >= MAPPED_UPDATE_THRESHOLD) {
+            mapped = glMapBufferRange(GL_ARRAY_BUFFER, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(bytes),
+                                      GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
+        }
+
+        if (mapped) {
+            WriteVertices(data, mapped);
+            glUnmapBuffer(GL_ARRAY_BUFFER);
+        } else {
+            glBufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(bytes),
+                            PrepareVertices(data));
+        }
+
+        m_Backend->GetCurrentFrameStats().bufferUploadBytes += bytes;
+
+        m_VertexCount = std::max(m_VertexCount, firstVertex + data.size());
+        m_FirstVertex = 0;
+
+        ConfigureAttributes(m_VboHandle);
+        return true;
+    }
+
+    void GLVertexBuffer::ConfigureAttributes(unsigned int sourceBuffer) {
+        // attribute pointers reference the buffer object, not its storage, so they survive glBufferData
+        if (m_AttributeSource == sourceBuffer) {
+            return;
+        }
+
+        m_AttributeSource = sourceBuffer;
+        m_Backend->GetStateCache().BindBuffer(GL_ARRAY_BUFFER, sourceBuffer);
+
+        GL_ConfigureVertexLayout(m_Layout);
+    }
+
+    size_t GLVertexBuffer::Size() {
+        // the buffer may be larger than its contents now that storage grows with headroom
+        return m_VertexCount * m_Layout.stride;
     }
 
     core::runtime::graphics::PrimitiveType GLVertexBuffer::GetPrimitiveType() {
@@ -155,14 +764,180 @@ namespace engine::backend::ogl {
     }
 
     std::vector<core::runtime::graphics::Vertex> GLVertexBuffer::Download() {
-        GLint size = static_cast<GLint>(Size());
-        std::vector<core::runtime::graphics::Vertex> buffer(size / sizeof(core::runtime::graphics::Vertex));
+        std::vector<core::runtime::graphics::Vertex> buffer(m_VertexCount);
 
-        Bind();
-        // TODO: fix for OpenGL ES
-        // glGetBufferSubData(GL_ARRAY_BUFFER, 0, size, buffer.data());
+        if (m_VertexCount == 0 || m_AttributeSource == 0 || !ResolveStreamedVertices()) {
+            return buffer;
+        }
+
+        auto bytes = static_cast<GLsizeiptr>(m_VertexCount * m_Layout.stride);
+        auto offset = static_cast<GLintptr>(GetSourceOffset());
+
+        // packed vertices are read into the scratch buffer and decoded afterwards
+        void *destination = buffer.data();
+
+        if (m_PackedLayout) {
+            m_EncodeScratch.resize(static_cast<size_t>(bytes));
+            destination = m_EncodeScratch.data();
+        }
+
+        // the copy-read target leaves the tracked GL_ARRAY_BUFFER binding alone
+        glBindBuffer(GL_COPY_READ_BUFFER, m_AttributeSource);
+
+        if (!m_Backend->GetCapabilities().isES) {
+            glGetBufferSubData(GL_COPY_READ_BUFFER, offset, bytes, destination);
+        } else {
+            // GLES can only read through a mapping, and the ring is mapped for writing and must not be mapped
+            // again; streamed vertices are copied into a staging buffer and that one is mapped instead
+            GLenum readTarget = GL_COPY_READ_BUFFER;
+            auto readOffset = offset;
+            unsigned int staging = 0;
+            size_t stagingCapacity = 0;
+
+            if (m_AttributeSource != m_VboHandle) {
+                auto &pool = m_Backend->GetResourcePool();
+                auto &stateCache = m_Backend->GetStateCache();
+
+                staging = pool.AcquireBuffer(static_cast<size_t>(bytes), GL_STREAM_READ, stagingCapacity);
+
+                if (staging) {
+                    stateCache.BindBuffer(GL_COPY_WRITE_BUFFER, staging);
+                } else {
+                    staging = pool.GenName(GLNameType::NAME_BUFFER);
+                    stagingCapacity = static_cast<size_t>(bytes);
+                    stateCache.BindBuffer(GL_COPY_WRITE_BUFFER, staging);
+                    glBufferData(GL_COPY_WRITE_BUFFER, bytes, nullptr, GL_STREAM_READ);
+                }
+
+                glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, offset, 0, bytes);
+                readTarget = GL_COPY_WRITE_BUFFER;
+                readOffset = 0;
+            }
+
+            if (auto mapped = glMapBufferRange(readTarget, readOffset, bytes, GL_MAP_READ_BIT)) {
+                std::memcpy(destination, mapped, static_cast<size_t>(bytes));
+                glUnmapBuffer(readTarget);
+            } else {
+                g_LoggerGLVertexBuffer.Log(runtime::LOG_LEVEL_ERROR, "Failed to map the vertex buffer for reading!");
+            }
+
+            // goes back to the resource pool for the next download
+            if (staging) {
+                m_Backend->GetDeletionQueue().ReleaseBuffer(staging, stagingCapacity, GL_STREAM_READ);
+            }
+        }
+
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+
+        if (m_PackedLayout) {
+            GL_DecodeVertices(m_Layout, destination, buffer);
+        }
 
         return buffer;
     }
 
+    GLVertexReadView GLVertexBuffer::MapRead() {
+        GLVertexReadView view;
+
+        if (m_VertexCount == 0 || m_AttributeSource == 0 || !ResolveStreamedVertices()) {
+            return view;
+        }
+
+        // vertices streamed this frame are still in the ring. it is either mapped for writing already, or a read
+        // mapping held by the view would block every other buffer's MapStream until it is released
+        if (m_AttributeSource != m_VboHandle) {
+            g_LoggerGLVertexBuffer.Log(runtime::LOG_LEVEL_ERROR, "Cannot map streamed vertices for reading; use Download.");
+            return view;
+        }
+
+        if (m_PackedLayout) {
+            g_LoggerGLVertexBuffer.Log(runtime::LOG_LEVEL_ERROR, "Packed vertices cannot be viewed as Vertex; use Download.");
+            return view;
+        }
+
+        auto bytes = static_cast<GLsizeiptr>(m_VertexCount * sizeof(core::runtime::graphics::Vertex));
+
+        glBindBuffer(GL_COPY_READ_BUFFER, m_AttributeSource);
+        auto mapped = glMapBufferRange(GL_COPY_READ_BUFFER, static_cast<GLintptr>(GetSourceOffset()), bytes, GL_MAP_READ_BIT);
+
+        if (!mapped) {
+            g_LoggerGLVertexBuffer.Log(runtime::LOG_LEVEL_ERROR, "Failed to map the vertex buffer for reading!");
+            glBindBuffer(GL_COPY_READ_BUFFER, 0);
+            return view;
+        }
+
+        view.m_Buffer = m_AttributeSource;
+        view.m_Vertices = {static_cast<const core::runtime::graphics::Vertex *>(mapped), m_VertexCount};
+        return view;
+    }
+
+    std::future<std::vector<core::runtime::graphics::Vertex>> GLVertexBuffer::DownloadAsync() {
+        auto promise = std::make_shared<std::promise<std::vector<core::runtime::graphics::Vertex>>>();
+        auto future = promise->get_future();
+
+        if (!ResolveStreamedVertices()) {
+            promise->set_value({});
+            return future;
+        }
+
+        // the layout is captured by value; it may change before the copy lands
+        std::optional<GLVertexLayout> packedLayout;
+
+        if (m_PackedLayout) {
+            packedLayout = m_Layout;
+        }
+
+        m_Backend->GetReadback().ReadBuffer(
+                m_AttributeSource, GetSourceOffset(), m_VertexCount * m_Layout.stride,
+                [promise, stride = m_Layout.stride, packedLayout](std::span<const unsigned char> data) {
+                    std::vector<core::runtime::graphics::Vertex> vertices(data.size() / stride);
+
+                    if (packedLayout) {
+                        GL_DecodeVertices(*packedLayout, data.data(), vertices);
+                    } else {
+                        std::memcpy(vertices.data(), data.data(), vertices.size() * sizeof(core::runtime::graphics::Vertex));
+                    }
+
+                    promise->set_value(std::move(vertices));
+                });
+
+        return future;
+    }
+
+    GLVertexReadView::GLVertexReadView(GLVertexReadView &&other) noexcept
+            : m_Buffer(other.m_Buffer), m_Vertices(other.m_Vertices) {
+        other.m_Buffer = 0;
+        other.m_Vertices = {};
+    }
+
+    GLVertexReadView &GLVertexReadView::operator=(GLVertexReadView &&other) noexcept {
+        if (this != &other) {
+            Release();
+
+            m_Buffer = other.m_Buffer;
+            m_Vertices = other.m_Vertices;
+            other.m_Buffer = 0;
+            other.m_Vertices = {};
+        }
+
+        return *this;
+    }
+
+    GLVertexReadView::~GLVertexReadView() {
+        Release();
+    }
+
+    void GLVertexReadView::Release() {
+        if (!m_Buffer) {
+            return;
+        }
+
+        glBindBuffer(GL_COPY_READ_BUFFER, m_Buffer);
+        glUnmapBuffer(GL_COPY_READ_BUFFER);
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+
+        m_Buffer = 0;
+        m_Vertices = {};
+    }
+
 } // namespace engine::backend::ogl
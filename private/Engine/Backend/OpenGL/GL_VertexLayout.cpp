@@ -0,0 +1,514 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GL_VERTEX_LAYOUT_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#include <Engine/GLHeader.hpp>
+
+#include <Engine/Backend/OpenGL/GL_VertexLayout.hpp>
+
+#include <Engine/Runtime/Logger.hpp>
+
+namespace engine::backend::ogl {
+    static runtime::Logger g_LoggerGLVertexLayout("GLVertexLayout");
+
+    static constexpr unsigned int GL_VERTEX_SEMANTIC_COUNT = 4;
+
+    static int GL_GetSemanticComponents(GLVertexSemantic semantic) {
+        switch (semantic) {
+            case GLVertexSemantic::VERTEX_SEMANTIC_UV:
+                return 2;
+            case GLVertexSemantic::VERTEX_SEMANTIC_COLOR:
+                return 4;
+            default:
+                return 3;
+        }
+    }
+
+    void GL_GetVertexElementFormat(GLVertexSemantic semantic, GLVertexEncoding encoding, int &components, uint32_t &size) {
+        components = GL_GetSemanticComponents(semantic);
+
+        switch (encoding) {
+            case GLVertexEncoding::VERTEX_ENCODING_FLOAT32:
+                size = static_cast<uint32_t>(components) * 4;
+                break;
+            case GLVertexEncoding::VERTEX_ENCODING_HALF_FLOAT:
+            case GLVertexEncoding::VERTEX_ENCODING_SNORM16:
+                // 6-byte elements would misalign everything after them
+                components = components == 3 ? 4 : components;
+                size = static_cast<uint32_t>(components) * 2;
+                break;
+            case GLVertexEncoding::VERTEX_ENCODING_UNORM8:
+            case GLVertexEncoding::VERTEX_ENCODING_INT_2_10_10_10_REV:
+                components = 4;
+                size = 4;
+                break;
+        }
+    }
+
+    GLVertexLayout GLVertexLayout::Standard() {
+        GLVertexLayout layout;
+        layout.Add(GLVertexSemantic::VERTEX_SEMANTIC_POSITION, GLVertexEncoding::VERTEX_ENCODING_FLOAT32)
+              .Add(GLVertexSemantic::VERTEX_SEMANTIC_UV, GLVertexEncoding::VERTEX_ENCODING_FLOAT32)
+              .Add(GLVertexSemantic::VERTEX_SEMANTIC_NORMAL, GLVertexEncoding::VERTEX_ENCODING_FLOAT32)
+              .Add(GLVertexSemantic::VERTEX_SEMANTIC_COLOR, GLVertexEncoding::VERTEX_ENCODING_UNORM8);
+        return layout;
+    }
+
+    GLVertexLayout GLVertexLayout::CompactMesh(float positionScale) {
+        GLVertexLayout layout;
+        layout.Add(GLVertexSemantic::VERTEX_SEMANTIC_POSITION, GLVertexEncoding::VERTEX_ENCODING_SNORM16)
+              .Add(GLVertexSemantic::VERTEX_SEMANTIC_UV, GLVertexEncoding::VERTEX_ENCODING_HALF_FLOAT)
+              .Add(GLVertexSemantic::VERTEX_SEMANTIC_NORMAL, GLVertexEncoding::VERTEX_ENCODING_INT_2_10_10_10_REV)
+              .Add(GLVertexSemantic::VERTEX_SEMANTIC_COLOR, GLVertexEncoding::VERTEX_ENCODING_UNORM8);
+        layout.positionScale = positionScale;
+        return layout;
+    }
+
+    GLVertexLayout GLVertexLayout::CompactUI() {
+        GLVertexLayout layout;
+        layout.Add(GLVertexSemantic::VERTEX_SEMANTIC_POSITION, GLVertexEncoding::VERTEX_ENCODING_FLOAT32)
+              .Add(GLVertexSemantic::VERTEX_SEMANTIC_UV, GLVertexEncoding::VERTEX_ENCODING_HALF_FLOAT)
+              .Add(GLVertexSemantic::VERTEX_SEMANTIC_COLOR, GLVertexEncoding::VERTEX_ENCODING_UNORM8);
+        return layout;
+    }
+
+    GLVertexLayout &GLVertexLayout::Add(GLVertexSemantic semantic, GLVertexEncoding encoding) {
+        if (Find(semantic)) {
+            g_LoggerGLVertexLayout.Log(runtime::LOG_LEVEL_ERROR, "Vertex semantic %u is already part of the layout!",
+                                       static_cast<unsigned int>(semantic));
+            return *this;
+        }
+
+        int components = 0;
+        uint32_t size = 0;
+        GL_GetVertexElementFormat(semantic, encoding, components, size);
+
+        elements.push_back({semantic, encoding, stride});
+        stride += size;
+        return *this;
+    }
+
+    const GLVertexElement *GLVertexLayout::Find(GLVertexSemantic semantic) const {
+        for (auto &element: elements) {
+            if (element.semantic == semantic) {
+                return &element;
+            }
+        }
+
+        return nullptr;
+    }
+
+    bool GLVertexLayout::IsStandard() const {
+        if (stride != sizeof(core::runtime::graphics::Vertex) || elements.size() != GL_VERTEX_SEMANTIC_COUNT) {
+            return false;
+        }
+
+        static const GLVertexLayout standard = Standard();
+        return std::equal(elements.begin(), elements.end(), standard.elements.begin(), [](auto &a, auto &b) {
+            return a.semantic == b.semantic && a.encoding == b.encoding && a.offset == b.offset;
+        });
+    }
+
+    bool GLVertexLayout::operator==(const GLVertexLayout &other) const {
+        return stride == other.stride && positionScale == other.positionScale &&
+               std::equal(elements.begin(), elements.end(), other.elements.begin(), other.elements.end(),
+                          [](auto &a, auto &b) {
+                              return a.semantic == b.semantic && a.encoding == b.encoding && a.offset == b.offset;
+                          });
+    }
+
+    static GLenum GL_MapVertexEncoding(GLVertexEncoding encoding) {
+        switch (encoding) {
+            case GLVertexEncoding::VERTEX_ENCODING_HALF_FLOAT:
+                return GL_HALF_FLOAT;
+            case GLVertexEncoding::VERTEX_ENCODING_SNORM16:
+                return GL_SHORT;
+            case GLVertexEncoding::VERTEX_ENCODING_UNORM8:
+                return GL_UNSIGNED_BYTE;
+            case GLVertexEncoding::VERTEX_ENCODING_INT_2_10_10_10_REV:
+                return GL_INT_2_10_10_10_REV;
+            default:
+                return GL_FLOAT;
+        }
+    }
+
+    void GL_ConfigureVertexLayout(const GLVertexLayout &layout, size_t byteOffset) {
+        for (unsigned int location = 0; location < GL_VERTEX_SEMANTIC_COUNT; location++) {
+            auto element = layout.Find(static_cast<GLVertexSemantic>(location));
+
+            if (!element) {
+                glDisableVertexAttribArray(location);
+                continue;
+            }
+
+            int components = 0;
+            uint32_t size = 0;
+            GL_GetVertexElementFormat(element->semantic, element->encoding, components, size);
+
+            auto normalized = element->encoding != GLVertexEncoding::VERTEX_ENCODING_FLOAT32 &&
+                              element->encoding != GLVertexEncoding::VERTEX_ENCODING_HALF_FLOAT;
+
+            glEnableVertexAttribArray(location);
+            glVertexAttribPointer(location, components, GL_MapVertexEncoding(element->encoding),
+                                  normalized ? GL_TRUE : GL_FALSE, static_cast<GLsizei>(layout.stride),
+                                  reinterpret_cast<const void *>(byteOffset + element->offset));
+        }
+    }
+
+    uint16_t GL_FloatToHalf(float value) {
+        // round-to-nearest-even with overflow to infinity; same algorithm as the SSE2 path below
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+
+        uint32_t sign = bits & 0x80000000u;
+        bits ^= sign;
+
+        uint32_t half;
+
+        if (bits >= 0x47800000u) {
+            // too large for a half (or inf / NaN)
+            half = bits > 0x7F800000u ? 0x7E00u : 0x7C00u;
+        } else if (bits < 0x38800000u) {
+            // subnormal half; adding 0.5f lets the FPU do the rounding
+            float magnitude;
+            std::memcpy(&magnitude, &bits, sizeof(magnitude));
+            magnitude += 0.5f;
+
+            uint32_t rounded;
+            std::memcpy(&rounded, &magnitude, sizeof(rounded));
+            half = rounded - 0x3F000000u;
+        } else {
+            uint32_t mantissaOdd = (bits >> 13) & 1;
+            bits += 0xC8000FFFu; // rebias the exponent (15 - 127) and add the rounding bias
+            bits += mantissaOdd;
+            half = bits >> 13;
+        }
+
+        return static_cast<uint16_t>(half | (sign >> 16));
+    }
+
+    float GL_HalfToFloat(uint16_t value) {
+        uint32_t sign = static_cast<uint32_t>(value & 0x8000u) << 16;
+        uint32_t exponent = (value >> 10) & 0x1Fu;
+        uint32_t mantissa = value & 0x3FFu;
+
+        if (exponent == 0) {
+            auto magnitude = std::ldexp(static_cast<float>(mantissa), -24);
+            return sign ? -magnitude : magnitude;
+        }
+
+        uint32_t bits = exponent == 0x1F
+                        ? sign | 0x7F800000u | (mantissa << 13)
+                        : sign | ((exponent + 112) << 23) | (mantissa << 13);
+
+        float result;
+        std::memcpy(&result, &bits, sizeof(result));
+        return result;
+    }
+
+    static uint32_t GL_Pack2101010(const int32_t values[4]) {
+        return (static_cast<uint32_t>(values[0]) & 0x3FFu) |
+               ((static_cast<uint32_t>(values[1]) & 0x3FFu) << 10) |
+               ((static_cast<uint32_t>(values[2]) & 0x3FFu) << 20) |
+               ((static_cast<uint32_t>(values[3]) & 0x3u) << 30);
+    }
+
+#ifdef GL_VERTEX_LAYOUT_SSE2
+    using GLFloat4 = __m128;
+
+    static GLFloat4 GL_FetchElement(const core::runtime::graphics::Vertex &vertex, GLVertexSemantic semantic) {
+        // the 16-byte loads stay inside the vertex: position is followed by uv, normal by color
+        const __m128 xyzMask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+
+        switch (semantic) {
+            case GLVertexSemantic::VERTEX_SEMANTIC_POSITION:
+                return _mm_and_ps(_mm_loadu_ps(&vertex.position.x), xyzMask);
+            case GLVertexSemantic::VERTEX_SEMANTIC_UV:
+                return _mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double *>(&vertex.uv.x)));
+            case GLVertexSemantic::VERTEX_SEMANTIC_NORMAL:
+                return _mm_and_ps(_mm_loadu_ps(&vertex.normal.x), xyzMask);
+            default: {
+                int32_t rgba;
+                std::memcpy(&rgba, &vertex.color, sizeof(rgba));
+
+                auto zero = _mm_setzero_si128();
+                auto bytes = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(rgba), zero), zero);
+                return _mm_mul_ps(_mm_cvtepi32_ps(bytes), _mm_set1_ps(1.0f / 255.0f));
+            }
+        }
+    }
+
+    static __m128i GL_FloatToHalf4(__m128 value) {
+        const __m128i signMask = _mm_set1_epi32(static_cast<int>(0x80000000u));
+        const __m128i halfMax = _mm_set1_epi32(0x47800000);
+        const __m128i nanBit = _mm_set1_epi32(0x200);
+        const __m128i infinity = _mm_set1_epi32(0x7C00);
+        const __m128i minNormal = _mm_set1_epi32(0x38800000);
+        const __m128i subnormalMagic = _mm_set1_epi32(0x3F000000);
+        const __m128i normalBias = _mm_set1_epi32(static_cast<int>(0xC8000FFFu));
+
+        auto sign = _mm_and_ps(_mm_castsi128_ps(signMask), value);
+        auto absolute = _mm_xor_ps(value, sign);
+        auto absoluteBits = _mm_castps_si128(absolute);
+
+        auto isNaN = _mm_castps_si128(_mm_cmpunord_ps(absolute, absolute));
+        auto isRegular = _mm_cmpgt_epi32(halfMax, absoluteBits);
+        auto special = _mm_or_si128(_mm_and_si128(isNaN, nanBit), infinity);
+
+        auto isSubnormal = _mm_cmpgt_epi32(minNormal, absoluteBits);
+        auto subnormal = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(absolute, _mm_castsi128_ps(subnormalMagic))),
+                                       subnormalMagic);
+
+        auto mantissaOdd = _mm_srai_epi32(_mm_slli_epi32(absoluteBits, 18), 31);
+        auto normal = _mm_srli_epi32(_mm_sub_epi32(_mm_add_epi32(absoluteBits, normalBias), mantissaOdd), 13);
+
+        auto finite = _mm_or_si128(_mm_and_si128(isSubnormal, subnormal), _mm_andnot_si128(isSubnormal, normal));
+        auto joined = _mm_or_si128(_mm_and_si128(isRegular, finite), _mm_andnot_si128(isRegular, special));
+
+        // the sign lands in bits 15-31, which keeps the signed saturating pack from clamping negative halves
+        return _mm_or_si128(joined, _mm_srai_epi32(_mm_castps_si128(sign), 16));
+    }
+
+    static void GL_StoreElement(GLVertexEncoding encoding, int components, GLFloat4 value, unsigned char *destination) {
+        switch (encoding) {
+            case GLVertexEncoding::VERTEX_ENCODING_FLOAT32: {
+                if (components == 4) {
+                    _mm_storeu_ps(reinterpret_cast<float *>(destination), value);
+                } else {
+                    alignas(16) float values[4];
+                    _mm_store_ps(values, value);
+                    std::memcpy(destination, values, components * sizeof(float));
+                }
+                break;
+            }
+            case GLVertexEncoding::VERTEX_ENCODING_HALF_FLOAT:
+            case GLVertexEncoding::VERTEX_ENCODING_SNORM16: {
+                __m128i words;
+
+                if (encoding == GLVertexEncoding::VERTEX_ENCODING_HALF_FLOAT) {
+                    words = GL_FloatToHalf4(value);
+                } else {
+                    auto clamped = _mm_max_ps(_mm_min_ps(value, _mm_set1_ps(1.0f)), _mm_set1_ps(-1.0f));
+                    words = _mm_cvtps_epi32(_mm_mul_ps(clamped, _mm_set1_ps(32767.0f)));
+                }
+
+                auto packed = _mm_packs_epi32(words, words);
+
+                if (components == 4) {
+                    _mm_storel_epi64(reinterpret_cast<__m128i *>(destination), packed);
+                } else {
+                    auto pair = _mm_cvtsi128_si32(packed);
+                    std::memcpy(destination, &pair, sizeof(pair));
+                }
+                break;
+            }
+            case GLVertexEncoding::VERTEX_ENCODING_UNORM8: {
+                auto clamped = _mm_max_ps(_mm_min_ps(value, _mm_set1_ps(1.0f)), _mm_setzero_ps());
+                auto words = _mm_cvtps_epi32(_mm_mul_ps(clamped, _mm_set1_ps(255.0f)));
+                auto bytes = _mm_cvtsi128_si32(_mm_packus_epi16(_mm_packs_epi32(words, words), _mm_setzero_si128()));
+                std::memcpy(destination, &bytes, sizeof(bytes));
+                break;
+            }
+            case GLVertexEncoding::VERTEX_ENCODING_INT_2_10_10_10_REV: {
+                auto clamped = _mm_max_ps(_mm_min_ps(value, _mm_set1_ps(1.0f)), _mm_set1_ps(-1.0f));
+
+                alignas(16) int32_t values[4];
+                _mm_store_si128(reinterpret_cast<__m128i *>(values),
+                                _mm_cvtps_epi32(_mm_mul_ps(clamped, _mm_setr_ps(511.0f, 511.0f, 511.0f, 1.0f))));
+
+                auto packed = GL_Pack2101010(values);
+                std::memcpy(destination, &packed, sizeof(packed));
+                break;
+            }
+        }
+    }
+
+    static GLFloat4 GL_ScaleElement(GLFloat4 value, float scale) {
+        return _mm_mul_ps(value, _mm_set1_ps(scale));
+    }
+#else
+    struct GLFloat4 {
+        float v[4];
+    };
+
+    static GLFloat4 GL_FetchElement(const core::runtime::graphics::Vertex &vertex, GLVertexSemantic semantic) {
+        switch (semantic) {
+            case GLVertexSemantic::VERTEX_SEMANTIC_POSITION:
+                return {{vertex.position.x, vertex.position.y, vertex.position.z, 0.0f}};
+            case GLVertexSemantic::VERTEX_SEMANTIC_UV:
+                return {{vertex.uv.x, vertex.uv.y, 0.0f, 0.0f}};
+            case GLVertexSemantic::VERTEX_SEMANTIC_NORMAL:
+                return {{vertex.normal.x, vertex.normal.y, vertex.normal.z, 0.0f}};
+            default:
+                return {{vertex.color.r / 255.0f, vertex.color.g / 255.0f, vertex.color.b / 255.0f, vertex.color.a / 255.0f}};
+        }
+    }
+
+    static void GL_StoreElement(GLVertexEncoding encoding, int components, GLFloat4 value, unsigned char *destination) {
+        switch (encoding) {
+            case GLVertexEncoding::VERTEX_ENCODING_FLOAT32:
+                std::memcpy(destination, value.v, components * sizeof(float));
+                break;
+            case GLVertexEncoding::VERTEX_ENCODING_HALF_FLOAT:
+            case GLVertexEncoding::VERTEX_ENCODING_SNORM16: {
+                uint16_t words[4];
+
+                for (int i = 0; i < components; i++) {
+                    words[i] = encoding == GLVertexEncoding::VERTEX_ENCODING_HALF_FLOAT
+                               ? GL_FloatToHalf(value.v[i])
+                               : static_cast<uint16_t>(std::lrint(std::clamp(value.v[i], -1.0f, 1.0f) * 32767.0f));
+                }
+
+                std::memcpy(destination, words, components * sizeof(uint16_t));
+                break;
+            }
+            case GLVertexEncoding::VERTEX_ENCODING_UNORM8:
+                for (int i = 0; i < 4; i++) {
+                    destination[i] = static_cast<unsigned char>(std::lrint(std::clamp(value.v[i], 0.0f, 1.0f) * 255.0f));
+                }
+                break;
+            case GLVertexEncoding::VERTEX_ENCODING_INT_2_10_10_10_REV: {
+                int32_t values[4];
+
+                for (int i = 0; i < 4; i++) {
+                    values[i] = static_cast<int32_t>(std::lrint(std::clamp(value.v[i], -1.0f, 1.0f) * (i < 3 ? 511.0f : 1.0f)));
+                }
+
+                auto packed = GL_Pack2101010(values);
+                std::memcpy(destination, &packed, sizeof(packed));
+                break;
+            }
+        }
+    }
+
+    static GLFloat4 GL_ScaleElement(GLFloat4 value, float scale) {
+        for (auto &component: value.v) {
+            component *= scale;
+        }
+
+        return value;
+    }
+#endif
+
+    void GL_EncodeVertices(const GLVertexLayout &layout, std::span<const core::runtime::graphics::Vertex> vertices,
+                           void *destination) {
+        auto output = static_cast<unsigned char *>(destination);
+
+        // element-major: every inner loop runs a single fetch/encode pair over all vertices
+        for (auto &element: layout.elements) {
+            int components = 0;
+            uint32_t size = 0;
+            GL_GetVertexElementFormat(element.semantic, element.encoding, components, size);
+
+            auto scale = element.semantic == GLVertexSemantic::VERTEX_SEMANTIC_POSITION &&
+                         element.encoding == GLVertexEncoding::VERTEX_ENCODING_SNORM16 && layout.positionScale != 0.0f
+                         ? 1.0f / layout.positionScale
+                         : 1.0f;
+
+            auto target = output + element.offset;
+
+            for (auto &vertex: vertices) {
+                auto value = GL_FetchElement(vertex, element.semantic);
+
+                if (scale != 1.0f) {
+                    value = GL_ScaleElement(value, scale);
+                }
+
+                GL_StoreElement(element.encoding, components, value, target);
+                target += layout.stride;
+            }
+        }
+    }
+
+    static void GL_DecodeElement(GLVertexEncoding encoding, int components, const unsigned char *source, float values[4]) {
+        switch (encoding) {
+            case GLVertexEncoding::VERTEX_ENCODING_FLOAT32:
+                std::memcpy(values, source, components * sizeof(float));
+                break;
+            case GLVertexEncoding::VERTEX_ENCODING_HALF_FLOAT:
+            case GLVertexEncoding::VERTEX_ENCODING_SNORM16:
+                for (int i = 0; i < components; i++) {
+                    uint16_t word;
+                    std::memcpy(&word, source + i * sizeof(word), sizeof(word));
+
+                    values[i] = encoding == GLVertexEncoding::VERTEX_ENCODING_HALF_FLOAT
+                                ? GL_HalfToFloat(word)
+                                : std::max(static_cast<int16_t>(word) / 32767.0f, -1.0f);
+                }
+                break;
+            case GLVertexEncoding::VERTEX_ENCODING_UNORM8:
+                for (int i = 0; i < 4; i++) {
+                    values[i] = source[i] / 255.0f;
+                }
+                break;
+            case GLVertexEncoding::VERTEX_ENCODING_INT_2_10_10_10_REV: {
+                uint32_t packed;
+                std::memcpy(&packed, source, sizeof(packed));
+
+                for (int i = 0; i < 3; i++) {
+                    // sign-extend the 10-bit field
+                    auto field = static_cast<int32_t>(packed << (22 - i * 10)) >> 22;
+                    values[i] = std::max(field / 511.0f, -1.0f);
+                }
+
+                values[3] = std::max(static_cast<float>(static_cast<int32_t>(packed) >> 30), -1.0f);
+                break;
+            }
+        }
+    }
+
+    void GL_DecodeVertices(const GLVertexLayout &layout, const void *source,
+                           std::span<core::runtime::graphics::Vertex> vertices) {
+        auto input = static_cast<const unsigned char *>(source);
+
+        for (auto &vertex: vertices) {
+            vertex = {};
+            vertex.color = {255, 255, 255, 255};
+        }
+
+        for (auto &element: layout.elements) {
+            int components = 0;
+            uint32_t size = 0;
+            GL_GetVertexElementFormat(element.semantic, element.encoding, components, size);
+
+            auto scale = element.semantic == GLVertexSemantic::VERTEX_SEMANTIC_POSITION &&
+                         element.encoding == GLVertexEncoding::VERTEX_ENCODING_SNORM16
+                         ? layout.positionScale
+                         : 1.0f;
+
+            auto current = input + element.offset;
+
+            for (auto &vertex: vertices) {
+                float values[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+                GL_DecodeElement(element.encoding, components, current, values);
+                current += layout.stride;
+
+                switch (element.semantic) {
+                    case GLVertexSemantic::VERTEX_SEMANTIC_POSITION:
+                        vertex.position = {values[0] * scale, values[1] * scale, values[2] * scale};
+                        break;
+                    case GLVertexSemantic::VERTEX_SEMANTIC_UV:
+                        vertex.uv = {values[0], values[1]};
+                        break;
+                    case GLVertexSemantic::VERTEX_SEMANTIC_NORMAL:
+                        vertex.normal = {values[0], values[1], values[2]};
+                        break;
+                    case GLVertexSemantic::VERTEX_SEMANTIC_COLOR: {
+                        auto toByte = [](float value) {
+                            return static_cast<uint8_t>(std::lrint(std::clamp(value, 0.0f, 1.0f) * 255.0f));
+                        };
+
+                        vertex.color = {toByte(values[0]), toByte(values[1]), toByte(values[2]), toByte(values[3])};
+                        break;
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,226 @@
+#include <algorithm>
+
+#include <Engine/GLHeader.hpp>
+
+#include <Engine/Backend/OpenGL/GL_Backend.hpp>
+#include <Engine/Backend/OpenGL/GL_WorkerPool.hpp>
+
+#include <Engine/Runtime/Logger.hpp>
+
+namespace engine::backend::ogl {
+    static runtime::Logger g_LoggerGLWorkerPool("GLWorkerPool");
+
+    GLWorkerPool::~GLWorkerPool() {
+        if (!m_Workers.empty()) {
+            g_LoggerGLWorkerPool.Log(runtime::LOG_LEVEL_WARNING, "Worker pool was not destroyed before being released!");
+        }
+    }
+
+    bool GLWorkerPool::Create(std::vector<GLWorkerContext> contexts) {
+        if (!m_Workers.empty()) {
+            return true;
+        }
+
+        if (contexts.empty()) {
+            return false;
+        }
+
+        {
+            std::lock_guard lock(m_Mutex);
+            m_Stopping = false;
+            m_LiveWorkers = static_cast<int>(contexts.size());
+        }
+
+        for (auto &context: contexts) {
+            m_Workers.emplace_back(&GLWorkerPool::WorkerMain, this, std::move(context));
+        }
+
+        g_LoggerGLWorkerPool.Log(runtime::LOG_LEVEL_DEBUG, "Started %zu shared-context workers.", m_Workers.size());
+        return true;
+    }
+
+    void GLWorkerPool::Destroy() {
+        {
+            std::lock_guard lock(m_Mutex);
+            m_Stopping = true;
+
+            for (auto &task: m_Queued) {
+                task->cancelled = true;
+                m_Finished.emplace_back(std::move(task));
+            }
+
+            m_Queued.clear();
+        }
+
+        m_Condition.notify_all();
+
+        for (auto &worker: m_Workers) {
+            worker.join();
+        }
+
+        m_Workers.clear();
+
+        std::deque<std::shared_ptr<Task>> finished;
+
+        {
+            std::lock_guard lock(m_Mutex);
+            finished.swap(m_Finished);
+            m_LiveWorkers = 0;
+        }
+
+        for (auto &task: finished) {
+            if (task->fence) {
+                glDeleteSync(static_cast<GLsync>(task->fence));
+            }
+
+            if (task->completion) {
+                task->completion(true);
+            }
+        }
+    }
+
+    bool GLWorkerPool::IsAvailable() const {
+        std::lock_guard lock(m_Mutex);
+        return m_LiveWorkers > 0 && !m_Stopping;
+    }
+
+    bool GLWorkerPool::Submit(const void *owner, GLWorkerJob job, GLWorkerCompletion completion) {
+        auto task = std::make_shared<Task>();
+        task->owner = owner;
+        task->job = std::move(job);
+        task->completion = std::move(completion);
+
+        {
+            std::lock_guard lock(m_Mutex);
+
+            if (m_LiveWorkers == 0 || m_Stopping) {
+                return false;
+            }
+
+            m_Queued.emplace_back(std::move(task));
+        }
+
+        m_Condition.notify_one();
+        return true;
+    }
+
+    void GLWorkerPool::Cancel(const void *owner) {
+        std::unique_lock lock(m_Mutex);
+
+        for (auto it = m_Queued.begin(); it != m_Queued.end();) {
+            if ((*it)->owner == owner) {
+                (*it)->cancelled = true;
+                m_Finished.emplace_back(std::move(*it));
+                it = m_Queued.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        for (auto &task: m_Finished) {
+            if (task->owner == owner) {
+                task->cancelled = true;
+            }
+        }
+
+        // running jobs may still be writing into the owner; wait for them so it can be destroyed safely
+        for (auto &task: m_Running) {
+            if (task->owner == owner) {
+                task->cancelled = true;
+            }
+        }
+
+        m_TaskFinished.wait(lock, [&]() {
+            return std::none_of(m_Running.begin(), m_Running.end(), [&](auto &task) { return task->owner == owner; });
+        });
+    }
+
+    void GLWorkerPool::Poll() {
+        while (true) {
+            std::shared_ptr<Task> task;
+            bool cancelled;
+
+            // one at a time, so a completion that cancels another owner still affects the tasks after it
+            {
+                std::lock_guard lock(m_Mutex);
+
+                if (m_Finished.empty()) {
+                    break;
+                }
+
+                task = std::move(m_Finished.front());
+                m_Finished.pop_front();
+                cancelled = task->cancelled;
+            }
+
+            if (task->fence) {
+                // the main context waits on the GPU; later commands see everything the worker submitted
+                auto fence = static_cast<GLsync>(task->fence);
+                glWaitSync(fence, 0, GL_TIMEOUT_IGNORED);
+                glDeleteSync(fence);
+            }
+
+            if (task->completion) {
+                task->completion(cancelled);
+            }
+        }
+    }
+
+    void GLWorkerPool::WorkerMain(GLWorkerContext context) {
+        if (!context.bind || !context.bind()) {
+            g_LoggerGLWorkerPool.Log(runtime::LOG_LEVEL_ERROR, "A worker failed to make its shared context current!");
+
+            std::lock_guard lock(m_Mutex);
+
+            // nobody would ever pick up the queue if this was the last worker
+            if (--m_LiveWorkers == 0) {
+                for (auto &task: m_Queued) {
+                    task->cancelled = true;
+                    m_Finished.emplace_back(std::move(task));
+                }
+
+                m_Queued.clear();
+            }
+
+            return;
+        }
+
+        while (true) {
+            std::shared_ptr<Task> task;
+
+            {
+                std::unique_lock lock(m_Mutex);
+                m_Condition.wait(lock, [this]() { return m_Stopping || !m_Queued.empty(); });
+
+                if (m_Stopping) {
+                    break;
+                }
+
+                task = std::move(m_Queued.front());
+                m_Queued.pop_front();
+
+                m_Running.emplace_back(task);
+            }
+
+            task->job();
+
+            // the flush makes sure the fence (and everything before it) actually reaches the GPU
+            auto fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            glFlush();
+
+            {
+                std::lock_guard lock(m_Mutex);
+                task->fence = fence;
+
+                m_Running.erase(std::find(m_Running.begin(), m_Running.end(), task));
+                m_Finished.emplace_back(std::move(task));
+            }
+
+            m_TaskFinished.notify_all();
+        }
+
+        if (context.release) {
+            context.release();
+        }
+    }
+}
@@ -1,12 +1,93 @@
+#include <cstring>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+
 #include <Engine/Platform/Universal/Graphics/U_EGL_Context.hpp>
 
 #include <Engine/Core/Runtime/IWindow.hpp>
 #include <Engine/Backend/OpenGL/GL_Backend.hpp>
 
+#ifndef EGL_PLATFORM_SURFACELESS_MESA
+#define EGL_PLATFORM_SURFACELESS_MESA 0x31DD
+#endif
+
 namespace engine::platform::universal {
-    UEGLContext::UEGLContext(core::runtime::IWindow *win) : m_Window{win}, m_EGLDisplay(EGL_NO_DISPLAY),
-                                                            m_EGLSurface(EGL_NO_SURFACE),
-                                                            m_EGLContext(EGL_NO_CONTEXT) {}
+    using UEGLGetPlatformDisplayProc = EGLDisplay (EGLAPIENTRY *)(EGLenum platform, void *nativeDisplay,
+                                                                  const EGLint *attribs);
+
+    // eglTerminate tears down every context on a display, so displays are reference counted across contexts.
+    // the mutex also serializes the (process-wide) EGL loader.
+    static std::mutex g_EGLDisplayMutex;
+    static std::unordered_map<EGLDisplay, int> g_EGLDisplayReferences;
+
+    static bool UEGL_InitializeDisplayLocked(EGLDisplay display, EGLint *major, EGLint *minor) {
+        if (!eglInitialize(display, major, minor)) {
+            return false;
+        }
+
+        g_EGLDisplayReferences[display]++;
+        return true;
+    }
+
+    static bool UEGL_InitializeDisplay(EGLDisplay display, EGLint *major, EGLint *minor) {
+        std::lock_guard lock(g_EGLDisplayMutex);
+        return UEGL_InitializeDisplayLocked(display, major, minor);
+    }
+
+    static void UEGL_TerminateDisplay(EGLDisplay display) {
+        std::lock_guard lock(g_EGLDisplayMutex);
+        auto it = g_EGLDisplayReferences.find(display);
+
+        if (it == g_EGLDisplayReferences.end()) {
+            return;
+        }
+
+        if (--it->second == 0) {
+            g_EGLDisplayReferences.erase(it);
+            eglTerminate(display);
+        }
+    }
+
+    static bool UEGL_HasExtension(const char *extensions, const char *name) {
+        if (!extensions) {
+            return false;
+        }
+
+        std::string_view list(extensions);
+        auto nameLength = std::strlen(name);
+
+        for (auto pos = list.find(name); pos != std::string_view::npos; pos = list.find(name, pos + 1)) {
+            auto end = pos + nameLength;
+
+            if ((pos == 0 || list[pos - 1] == ' ') && (end == list.size() || list[end] == ' ')) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    UEGLContext::UEGLContext(core::runtime::IWindow *win, int workerCount) : m_Window{win}, m_EGLDisplay(EGL_NO_DISPLAY),
+                                                                             m_EGLSurface(EGL_NO_SURFACE),
+                                                                             m_EGLContext(EGL_NO_CONTEXT),
+                                                                             m_WorkerCount(workerCount) {}
+
+    UEGLContext::UEGLContext(const UEGLHeadlessDesc &desc) : m_Window(nullptr), m_EGLDisplay(EGL_NO_DISPLAY),
+                                                             m_EGLSurface(EGL_NO_SURFACE),
+                                                             m_EGLContext(EGL_NO_CONTEXT),
+                                                             m_HeadlessDesc(desc),
+                                                             m_WorkerCount(desc.workerCount) {}
+
+    bool UEGLContext::SetWorkerCount(int count) {
+        if (m_EGLContext != EGL_NO_CONTEXT) {
+            printf("UEGLContext: The worker count must be set before Create()!\n");
+            return false;
+        }
+
+        m_WorkerCount = count;
+        return true;
+    }
 
 #define CASE_STR( value ) case value: return #value;
     const char* eglGetErrorString( EGLint error )
@@ -34,8 +115,13 @@ namespace engine::platform::universal {
 #undef CASE_STR
 
     bool UEGLContext::Create() {
-        const EGLint attribs[] = {
-                EGL_SURFACE_TYPE, EGL_WINDOW_BIT,
+        if (IsHeadless()) {
+            return CreateHeadless();
+        }
+
+        // worker contexts make pbuffers of this config current unless the display supports surfaceless contexts
+        EGLint attribs[] = {
+                EGL_SURFACE_TYPE, m_WorkerCount > 0 ? EGL_WINDOW_BIT | EGL_PBUFFER_BIT : EGL_WINDOW_BIT,
                 EGL_BLUE_SIZE, 8,
                 EGL_GREEN_SIZE, 8,
                 EGL_RED_SIZE, 8,
@@ -76,14 +162,22 @@ namespace engine::platform::universal {
 LBL_CONTINUE_EGL_INIT:
         EGLint eglMajor, eglMinor;
 
-        if (!eglInitialize(m_EGLDisplay, &eglMajor, &eglMinor)) {
+        if (!UEGL_InitializeDisplay(m_EGLDisplay, &eglMajor, &eglMinor)) {
             printf("UEGLContext: Failed to initialize EGL on default display!\n");
             return false;
         } else {
             printf("UEGLContext: Initialized EGL %i.%i on default display!\n", eglMajor, eglMinor);
         }
 
-        if (!eglChooseConfig(m_EGLDisplay, attribs, &config, 1, &numConfigs)) {
+        auto chosen = eglChooseConfig(m_EGLDisplay, attribs, &config, 1, &numConfigs) && numConfigs > 0;
+
+        // not every display offers a config for both; the workers then depend on surfaceless contexts
+        if (!chosen && m_WorkerCount > 0) {
+            attribs[1] = EGL_WINDOW_BIT;
+            chosen = eglChooseConfig(m_EGLDisplay, attribs, &config, 1, &numConfigs) && numConfigs > 0;
+        }
+
+        if (!chosen) {
             printf("UEGLContext: Failed to choose EGL config!\n");
             return false;
         } else {
@@ -127,10 +221,128 @@ LBL_CONTINUE_EGL_INIT:
             printf("UEGLContext: Successfully created EGL context!\n");
         }
 
+        m_EGLConfig = config;
+        m_API = eglQueryAPI();
+
+        return true;
+    }
+
+    bool UEGLContext::CreateHeadless() {
+        EGLint eglMajor, eglMinor;
+
+        {
+            std::lock_guard lock(g_EGLDisplayMutex);
+
+#ifdef GL_WITH_EGL_LOADER
+            if (!gladLoaderLoadEGL(nullptr)) {
+                printf("UEGLContext: Could not load EGL\n");
+                return false;
+            }
+#endif
+
+            // the surfaceless platform needs neither a display server nor a GPU device node (e.g. llvmpipe)
+            if (UEGL_HasExtension(eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS), "EGL_MESA_platform_surfaceless")) {
+                auto getPlatformDisplay = reinterpret_cast<UEGLGetPlatformDisplayProc>(
+                        eglGetProcAddress("eglGetPlatformDisplayEXT"));
+
+                if (getPlatformDisplay) {
+                    m_EGLDisplay = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, nullptr, nullptr);
+                }
+            }
+
+            if (m_EGLDisplay != EGL_NO_DISPLAY) {
+                printf("UEGLContext: Got surfaceless platform display!\n");
+            } else if ((m_EGLDisplay = eglGetDisplay(EGL_DEFAULT_DISPLAY)) == EGL_NO_DISPLAY) {
+                printf("UEGLContext: Failed to get a headless display!\n");
+                return false;
+            } else {
+                printf("UEGLContext: Got default display for headless rendering!\n");
+            }
+
+            if (!UEGL_InitializeDisplayLocked(m_EGLDisplay, &eglMajor, &eglMinor)) {
+                printf("UEGLContext: Failed to initialize EGL on the headless display!\n");
+                m_EGLDisplay = EGL_NO_DISPLAY;
+                return false;
+            }
+
+#ifdef GL_WITH_EGL_LOADER
+            // now that there is a display, the loader can resolve its extensions as well
+            gladLoaderLoadEGL(m_EGLDisplay);
+#endif
+        }
+
+        printf("UEGLContext: Initialized EGL %i.%i for headless rendering!\n", eglMajor, eglMinor);
+
+        auto surfaceless = m_HeadlessDesc.allowSurfaceless &&
+                           UEGL_HasExtension(eglQueryString(m_EGLDisplay, EGL_EXTENSIONS), "EGL_KHR_surfaceless_context");
+
+#if defined(GL_WITH_CORE) && (defined(GL_FORCE_API) || !defined(GL_WITH_GLES))
+        m_API = EGL_OPENGL_API;
+#else
+        m_API = EGL_OPENGL_ES_API;
+#endif
+
+        if (!eglBindAPI(m_API)) {
+            printf("UEGLContext: Failed to bind the client API!\n");
+            return false;
+        }
+
+        const EGLint attribs[] = {
+                EGL_SURFACE_TYPE, surfaceless ? 0 : EGL_PBUFFER_BIT,
+                EGL_RENDERABLE_TYPE, m_API == EGL_OPENGL_API ? EGL_OPENGL_BIT : EGL_OPENGL_ES3_BIT,
+                EGL_BLUE_SIZE, 8,
+                EGL_GREEN_SIZE, 8,
+                EGL_RED_SIZE, 8,
+                EGL_ALPHA_SIZE, 8,
+                EGL_NONE
+        };
+
+        EGLConfig config;
+        EGLint numConfigs = 0;
+
+        if (!eglChooseConfig(m_EGLDisplay, attribs, &config, 1, &numConfigs) || numConfigs == 0) {
+            printf("UEGLContext: Failed to choose a headless EGL config!\n");
+            return false;
+        }
+
+        // rendering goes to an FBO either way; the pbuffer only exists so the context can be made current
+        if (!surfaceless) {
+            const EGLint pbufferAttribs[] = {EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE};
+
+            if ((m_EGLSurface = eglCreatePbufferSurface(m_EGLDisplay, config, pbufferAttribs)) == EGL_NO_SURFACE) {
+                printf("error %s\n", eglGetErrorString(eglGetError()));
+                printf("UEGLContext: Failed to create a pbuffer surface!\n");
+                return false;
+            }
+
+            printf("UEGLContext: Using a pbuffer surface for headless rendering!\n");
+        } else {
+            printf("UEGLContext: Using a surfaceless context for headless rendering!\n");
+        }
+
+        // desktop GL gets the highest version the driver offers; GLES has to ask for 3.0
+        m_ClientVersion = m_API == EGL_OPENGL_API ? 0 : 3;
+        m_EGLConfig = config;
+
+        const EGLint esContextAttribs[] = {EGL_CONTEXT_CLIENT_VERSION, m_ClientVersion, EGL_NONE};
+        auto contextAttribs = m_ClientVersion ? esContextAttribs : nullptr;
+
+        if ((m_EGLContext = eglCreateContext(m_EGLDisplay, config, EGL_NO_CONTEXT, contextAttribs)) == EGL_NO_CONTEXT) {
+            printf("error %s\n", eglGetErrorString(eglGetError()));
+            printf("UEGLContext: Failed to create headless EGL context!\n");
+            return false;
+        }
+
+        printf("UEGLContext: Successfully created headless EGL context!\n");
         return true;
     }
 
     void UEGLContext::Bind() {
+        // the bound client API is per-thread state, and headless contexts are usually bound on worker threads
+        if (m_API != EGL_NONE) {
+            eglBindAPI(m_API);
+        }
+
         eglMakeCurrent(m_EGLDisplay, m_EGLSurface, m_EGLSurface, m_EGLContext);
     }
 
@@ -138,15 +350,125 @@ LBL_CONTINUE_EGL_INIT:
         eglMakeCurrent(m_EGLDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
     }
 
+    void UEGLContext::CreateWorkers() {
+        if (m_WorkerCount <= 0 || !m_EGLConfig) {
+            return;
+        }
+
+        auto surfaceless = UEGL_HasExtension(eglQueryString(m_EGLDisplay, EGL_EXTENSIONS),
+                                             "EGL_KHR_surfaceless_context");
+
+        EGLint surfaceType = 0;
+        eglGetConfigAttrib(m_EGLDisplay, m_EGLConfig, EGL_SURFACE_TYPE, &surfaceType);
+
+        if (!surfaceless && !(surfaceType & EGL_PBUFFER_BIT)) {
+            printf("UEGLContext: The EGL config has no pbuffer support, worker contexts are disabled!\n");
+            return;
+        }
+
+        const EGLint contextAttribs[] = {EGL_CONTEXT_CLIENT_VERSION, m_ClientVersion, EGL_NONE};
+        const EGLint pbufferAttribs[] = {EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE};
+
+        std::vector<backend::ogl::GLWorkerContext> contexts;
+
+        for (int i = 0; i < m_WorkerCount; i++) {
+            // sharing with the main context puts textures, buffers, programs and fences in one namespace
+            UEGLWorker worker{eglCreateContext(m_EGLDisplay, m_EGLConfig, m_EGLContext,
+                                               m_ClientVersion ? contextAttribs : nullptr), EGL_NO_SURFACE};
+
+            if (worker.context == EGL_NO_CONTEXT) {
+                printf("error %s\n", eglGetErrorString(eglGetError()));
+                printf("UEGLContext: Failed to create shared worker context %i!\n", i);
+                break;
+            }
+
+            if (!surfaceless &&
+                (worker.surface = eglCreatePbufferSurface(m_EGLDisplay, m_EGLConfig, pbufferAttribs)) == EGL_NO_SURFACE) {
+                printf("UEGLContext: Failed to create a pbuffer surface for worker context %i!\n", i);
+                eglDestroyContext(m_EGLDisplay, worker.context);
+                break;
+            }
+
+            m_Workers.push_back(worker);
+
+            auto display = m_EGLDisplay;
+            auto api = m_API;
+
+            contexts.push_back({
+                    [display, api, worker]() {
+                        // the client API is per-thread state as well
+                        return eglBindAPI(api) &&
+                               eglMakeCurrent(display, worker.surface, worker.surface, worker.context);
+                    },
+                    [display]() {
+                        eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+                    }
+            });
+        }
+
+        if (contexts.empty()) {
+            return;
+        }
+
+        static_cast<backend::ogl::GLBackend *>(m_Backend.get())->GetWorkerPool().Create(std::move(contexts));
+        printf("UEGLContext: Created %zu shared worker contexts!\n", m_Workers.size());
+    }
+
+    void UEGLContext::DestroyWorkers() {
+        if (m_Backend) {
+            static_cast<backend::ogl::GLBackend *>(m_Backend.get())->GetWorkerPool().Destroy();
+        }
+
+        // the threads are joined at this point, so none of the contexts is current anywhere
+        for (auto &worker: m_Workers) {
+            eglDestroyContext(m_EGLDisplay, worker.context);
+
+            if (worker.surface != EGL_NO_SURFACE) {
+                eglDestroySurface(m_EGLDisplay, worker.surface);
+            }
+        }
+
+        m_Workers.clear();
+    }
+
     void UEGLContext::Destroy() {
+        if (!m_Workers.empty()) {
+            // cancelled jobs release their objects in their completions, which need the main context
+            Bind();
+            DestroyWorkers();
+        }
+
+        if (m_RenderTarget) {
+            // GL objects can only be deleted while their context is current
+            Bind();
+            m_RenderTarget->Destroy();
+            m_RenderTarget.reset();
+            static_cast<backend::ogl::GLBackend *>(m_Backend.get())->SetDefaultFramebuffer(0);
+        }
+
         Discard();
         eglDestroyContext(m_EGLDisplay, m_EGLContext);
-        eglDestroySurface(m_EGLDisplay, m_EGLSurface);
-        eglTerminate(m_EGLDisplay);
+
+        if (m_EGLSurface != EGL_NO_SURFACE) {
+            eglDestroySurface(m_EGLDisplay, m_EGLSurface);
+        }
+
+        UEGL_TerminateDisplay(m_EGLDisplay);
+
+        m_EGLContext = EGL_NO_CONTEXT;
+        m_EGLSurface = EGL_NO_SURFACE;
+        m_EGLDisplay = EGL_NO_DISPLAY;
     }
 
     void UEGLContext::Present() {
-        eglSwapBuffers(m_EGLDisplay, m_EGLSurface);
+        if (m_Backend) {
+            static_cast<backend::ogl::GLBackend *>(m_Backend.get())->EndFrame();
+        }
+
+        // headless frames stay in the render target; read them back through the backend's GLReadback
+        if (!IsHeadless()) {
+            eglSwapBuffers(m_EGLDisplay, m_EGLSurface);
+        }
     }
 
     core::runtime::graphics::IGraphicsBackend *UEGLContext::GetBackend() {
@@ -158,6 +480,25 @@ LBL_CONTINUE_EGL_INIT:
                 printf("U_EGLContext: Failed to initialize the backend.\n");
                 return nullptr;
             }
+
+            // there is no window framebuffer; the render target stays bound and stands in for it
+            if (IsHeadless()) {
+                auto glBackend = static_cast<backend::ogl::GLBackend *>(m_Backend.get());
+                m_RenderTarget = std::make_unique<backend::ogl::GLRenderTarget>(glBackend, m_HeadlessDesc.width,
+                                                                               m_HeadlessDesc.height);
+
+                if (!m_RenderTarget->Create()) {
+                    printf("U_EGLContext: Failed to create the headless render target.\n");
+                    m_RenderTarget.reset();
+                    return nullptr;
+                }
+
+                m_RenderTarget->Bind();
+                glBackend->SetDefaultFramebuffer(m_RenderTarget->GetHandle());
+            }
+
+            CreateWorkers();
+
             Discard();
         }
 
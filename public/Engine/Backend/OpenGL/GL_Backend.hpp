@@ -1,6 +1,29 @@
 #pragma once
 
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string_view>
+
 #include <Engine/Core/Runtime/Graphics/IGraphicsBackend.hpp>
+#include <Engine/Backend/OpenGL/GL_BatchRenderer.hpp>
+#include <Engine/Backend/OpenGL/GL_Capabilities.hpp>
+#include <Engine/Backend/OpenGL/GL_CommandList.hpp>
+#include <Engine/Backend/OpenGL/GL_DeletionQueue.hpp>
+#include <Engine/Backend/OpenGL/GL_FrameStats.hpp>
+#include <Engine/Backend/OpenGL/GL_ProgramBinaryCache.hpp>
+#include <Engine/Backend/OpenGL/GL_Profiler.hpp>
+#include <Engine/Backend/OpenGL/GL_Readback.hpp>
+#include <Engine/Backend/OpenGL/GL_RenderQueue.hpp>
+#include <Engine/Backend/OpenGL/GL_ResourcePool.hpp>
+#include <Engine/Backend/OpenGL/GL_SamplerCache.hpp>
+#include <Engine/Backend/OpenGL/GL_SpriteBatcher.hpp>
+#include <Engine/Backend/OpenGL/GL_StateCache.hpp>
+#include <Engine/Backend/OpenGL/GL_StreamBuffer.hpp>
+#include <Engine/Backend/OpenGL/GL_TextureAtlas.hpp>
+#include <Engine/Backend/OpenGL/GL_TextureStreamer.hpp>
+#include <Engine/Backend/OpenGL/GL_Uniform.hpp>
+#include <Engine/Backend/OpenGL/GL_WorkerPool.hpp>
 
 namespace engine::backend::ogl {
     struct GLBackend : public core::runtime::graphics::IGraphicsBackend {
@@ -32,7 +55,144 @@ namespace engine::backend::ogl {
 
         std::unique_ptr<core::runtime::graphics::ITexture> CreateTexture() override;
 
+        // the renderer allocates its arenas lazily; call Destroy() on it before shutting the backend down
+        std::unique_ptr<GLBatchRenderer> CreateBatchRenderer(size_t verticesPerArena = 1024 * 1024);
+
+        // sprite vertices go through the shared vertex stream; call Destroy() on the batcher before shutdown
+        std::unique_ptr<GLSpriteBatcher> CreateSpriteBatcher(int layersPerArray = 64);
+
+        // pages are allocated as images are added; call Destroy() on the atlas before shutdown
+        std::unique_ptr<GLTextureAtlas> CreateTextureAtlas(int pageSize = 2048);
+
+        // holds no GL objects; fill it with Add, then Submit and Clear once per frame
+        std::unique_ptr<GLRenderQueue> CreateRenderQueue();
+
+        // replays command lists recorded on other threads, in the given order
+        void ExecuteCommandLists(std::span<const GLCommandList *const> lists);
+
+        // marks the end of a frame; the current counters become the ones reported by GetFrameStats
+        void EndFrame();
+
+        // number of frames completed so far
+        uint64_t GetFrameIndex() const {
+            return m_FrameIndex;
+        }
+
+        const GLFrameStats &GetFrameStats() const {
+            return m_LastFrameStats;
+        }
+
+        GLFrameStats &GetCurrentFrameStats() {
+            return m_FrameStats;
+        }
+
+        const GLCapabilities &GetCapabilities() const {
+            return m_Capabilities;
+        }
+
+        // number of driver threads used for background shader compilation; 0xFFFFFFFF lets the driver decide.
+        // no-op without GL_KHR_parallel_shader_compile.
+        void SetShaderCompilerThreads(unsigned int count);
+
+        GLStateCache &GetStateCache() {
+            return m_StateCache;
+        }
+
+        GLProgramBinaryCache &GetProgramBinaryCache() {
+            return m_ProgramBinaryCache;
+        }
+
+        GLSamplerCache &GetSamplerCache() {
+            return m_SamplerCache;
+        }
+
+        // batched object names and recycled buffer / texture storage
+        GLResourcePool &GetResourcePool() {
+            return m_ResourcePool;
+        }
+
+        // fenced deletion of released objects; flushed once per frame by EndFrame. releasing is thread-safe
+        GLDeletionQueue &GetDeletionQueue() {
+            return m_DeletionQueue;
+        }
+
+        // framebuffer that plays the role of the window framebuffer, e.g. a headless context's render target
+        void SetDefaultFramebuffer(unsigned int framebuffer) {
+            m_DefaultFramebuffer = framebuffer;
+        }
+
+        unsigned int GetDefaultFramebuffer() const {
+            return m_DefaultFramebuffer;
+        }
+
+        // shared ring used by vertex buffers uploaded with BUFFER_USAGE_HINT_STREAM; created on first use
+        GLStreamBuffer &GetVertexStream();
+
+        // per-frame ring for uniform block data; created on first use
+        GLStreamBuffer &GetUniformStream();
+
+        // reserves uniform block memory in the current frame, aligned for glBindBufferRange. write it through
+        // GLStd140Writer, then bind it with BindUniformRange; the memory is only valid for this frame. bind each
+        // allocation before making the next one, contexts without persistent mapping keep one open at a time.
+        GLStreamAllocation AllocateUniforms(size_t size);
+
+        // commits the allocation and binds it to the uniform buffer binding point
+        void BindUniformRange(unsigned int binding, const GLStreamAllocation &allocation);
+
+        // copies data into the uniform ring and binds it; returns false if it does not fit in a frame's region
+        bool BindUniformData(unsigned int binding, const void *data, size_t size);
+
+        // binding point shared by every uniform block with this name; assigned in order of first use from
+        // GetFirstNamedUniformBlockBinding() upwards. thread-safe, programs linked on workers reflect their
+        // blocks there.
+        unsigned int GetUniformBlockBinding(std::string_view name);
+
+        // like GetUniformBlockBinding, but never assigns one; false if the name has no binding yet
+        bool FindUniformBlockBinding(std::string_view name, unsigned int &binding);
+
+        // bindings below this one are left to explicit layout(binding) qualifiers in shaders
+        unsigned int GetFirstNamedUniformBlockBinding() const;
+
+        // fenced GPU -> CPU image copies; created on first use and polled once per frame by EndFrame
+        GLReadback &GetReadback();
+
+        // background texture uploads; created on first use and advanced once per frame by EndFrame
+        GLTextureStreamer &GetTextureStreamer();
+
+        // the streamer if it exists; for code that only cancels work and must not start it, e.g. after Shutdown
+        GLTextureStreamer *FindTextureStreamer() {
+            return m_TextureStreamer.get();
+        }
+
+        // CPU/GPU scope timing; created on first use. EndFrame hands it each frame's stats and resolves old frames
+        GLProfiler &GetProfiler();
+
+        // shared-context workers started by the platform context; unavailable unless it was asked for them.
+        // finished jobs are handed over once per frame by EndFrame
+        GLWorkerPool &GetWorkerPool() {
+            return m_WorkerPool;
+        }
+
     protected:
         uint32_t m_ActiveFeatures = 0;
+        GLCapabilities m_Capabilities;
+        uint64_t m_FrameIndex = 0;
+        unsigned int m_DefaultFramebuffer = 0;
+        bool m_LoaderAcquired = false;
+        GLFrameStats m_FrameStats;
+        GLFrameStats m_LastFrameStats;
+        GLStateCache m_StateCache{this};
+        GLProgramBinaryCache m_ProgramBinaryCache;
+        GLSamplerCache m_SamplerCache{this};
+        GLResourcePool m_ResourcePool{this};
+        GLDeletionQueue m_DeletionQueue{this};
+        GLWorkerPool m_WorkerPool{this};
+        std::unique_ptr<GLStreamBuffer> m_VertexStream;
+        std::unique_ptr<GLStreamBuffer> m_UniformStream;
+        std::unique_ptr<GLTextureStreamer> m_TextureStreamer;
+        std::unique_ptr<GLReadback> m_Readback;
+        std::unique_ptr<GLProfiler> m_Profiler;
+        std::mutex m_UniformBlockMutex;
+        GLUniformNameMap m_UniformBlockBindings;
     };
 }
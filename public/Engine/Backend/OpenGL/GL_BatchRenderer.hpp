@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include <Engine/Core/Runtime/Graphics/IVertexBuffer.hpp>
+#include <Engine/Backend/OpenGL/GL_RangeAllocator.hpp>
+#include <Engine/Backend/OpenGL/GL_StreamBuffer.hpp>
+
+namespace engine::backend::ogl {
+    struct GLBackend;
+
+    // slots are reused after RemoveMesh; the generation tells a stale handle apart from the slot's new mesh
+    struct GLMeshHandle {
+        uint32_t index = UINT32_MAX;
+        uint32_t generation = 0;
+
+        bool IsValid() const {
+            return index != UINT32_MAX;
+        }
+    };
+
+    // layout mandated by glMultiDrawArraysIndirect
+    struct GLDrawArraysIndirectCommand {
+        uint32_t count;
+        uint32_t instanceCount;
+        uint32_t first;
+        uint32_t baseInstance;
+    };
+
+    // static geometry suballocated out of a few large shared vertex arenas. queued draws of every arena are
+    // submitted with one glMultiDrawArraysIndirect per arena and primitive type (a loop of glDrawArrays where
+    // indirect draws are unavailable, e.g. GLES). bind the material, queue its meshes, then Flush().
+    struct GLBatchRenderer {
+        GLBatchRenderer(GLBackend *backend, size_t verticesPerArena);
+
+        ~GLBatchRenderer();
+
+        void Destroy();
+
+        GLMeshHandle AddMesh(std::span<const core::runtime::graphics::Vertex> vertices,
+                             core::runtime::graphics::PrimitiveType type);
+
+        void RemoveMesh(GLMeshHandle handle);
+
+        void Queue(GLMeshHandle handle);
+
+        // submits and clears every queued draw
+        void Flush();
+
+        size_t GetQueuedDrawCount() const;
+
+    protected:
+        struct Arena {
+            unsigned int vao = 0;
+            unsigned int vbo = 0;
+            GLRangeAllocator allocator;
+            // one queue per primitive type, since a multi-draw call has a single mode
+            std::vector<GLDrawArraysIndirectCommand> queues[3];
+        };
+
+        struct Mesh {
+            uint32_t arena;
+            uint32_t first;
+            uint32_t count;
+            core::runtime::graphics::PrimitiveType type;
+            bool alive;
+            uint32_t generation = 0;
+        };
+
+        Arena *CreateArena();
+
+        // nullptr for removed meshes and stale handles
+        Mesh *FindMesh(GLMeshHandle handle);
+
+        GLBackend *m_Backend;
+        size_t m_VerticesPerArena;
+        std::vector<std::unique_ptr<Arena>> m_Arenas;
+        std::vector<Mesh> m_Meshes;
+        std::vector<uint32_t> m_FreeMeshSlots;
+        std::unique_ptr<GLStreamBuffer> m_IndirectStream;
+    };
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <unordered_set>
+
+namespace engine::backend::ogl {
+    // what the current context supports; filled once by GLBackend::Initialize
+    struct GLCapabilities {
+        // must be called with a current context
+        void Detect();
+
+        bool HasExtension(std::string_view name) const;
+
+        // whether textures can be created with the given compressed internal format
+        bool SupportsCompressedFormat(unsigned int internalFormat) const;
+
+        // true if the context is at least the given desktop GL (es == false) or GLES (es == true) version
+        bool IsAtLeast(int major, int minor, bool es) const {
+            return isES == es && (majorVersion > major || (majorVersion == major && minorVersion >= minor));
+        }
+
+        int majorVersion = 0;
+        int minorVersion = 0;
+        bool isES = false;
+
+        // GL_KHR_parallel_shader_compile / GL_ARB_parallel_shader_compile
+        bool parallelShaderCompile = false;
+
+        // immutable, persistently mappable buffers (desktop GL 4.4 / GL_ARB_buffer_storage)
+        bool bufferStorage = false;
+
+        // glFenceSync / glClientWaitSync (GL 3.2 / GLES 3.0 / GL_ARB_sync)
+        bool syncObjects = false;
+
+        // glDrawElementsBaseVertex (GL 3.2 / GLES 3.2 / GL_*_draw_elements_base_vertex)
+        bool drawElementsBaseVertex = false;
+
+        // glDraw*InstancedBaseInstance (GL 4.2 / GL_ARB_base_instance)
+        bool baseInstance = false;
+
+        // glMultiDrawArraysIndirect (GL 4.3 / GL_ARB_multi_draw_indirect)
+        bool multiDrawIndirect = false;
+
+        // glTexStorage* immutable textures (GL 4.2 / GLES 3.0 / GL_ARB_texture_storage)
+        bool textureStorage = false;
+
+        // glCopyImageSubData (GL 4.3 / GL_ARB_copy_image)
+        bool copyImage = false;
+
+        // glGenSamplers (GL 3.3 / GLES 3.0 / GL_ARB_sampler_objects)
+        bool samplerObjects = false;
+
+        // GL_TIME_ELAPSED queries (GL 3.3 / GL_ARB_timer_query / GL_EXT_disjoint_timer_query)
+        bool timerQuery = false;
+
+        // glQueryCounter(GL_TIMESTAMP); optional on GLES, where the counter may have zero bits
+        bool timestampQuery = false;
+
+        // GLES timer results can be invalidated by GL_GPU_DISJOINT_EXT (power or clock changes)
+        bool disjointTimerQuery = false;
+
+        // uniform buffer limits; glBindBufferRange offsets must be multiples of uniformBufferOffsetAlignment
+        int uniformBufferOffsetAlignment = 256;
+        int maxUniformBufferBindings = 0;
+        int maxUniformBlockSize = 0;
+
+        // GL_TEXTURE_MAX_ANISOTROPY (GL 4.6 / GL_*_texture_filter_anisotropic); 1 if unsupported
+        float maxAnisotropy = 1.f;
+
+        // block-compressed texture families, see GLCompressionFamily
+        bool compressionS3TC = false;
+        bool compressionRGTC = false;
+        bool compressionBPTC = false;
+        bool compressionETC2 = false;
+        bool compressionASTC = false;
+
+    protected:
+        std::unordered_set<std::string> m_Extensions;
+    };
+}
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <Engine/Core/Runtime/Graphics/IGraphicsBackend.hpp>
+#include <Engine/Core/Runtime/Graphics/ITexture.hpp>
+#include <Engine/Backend/OpenGL/GL_InstanceData.hpp>
+#include <Engine/Backend/OpenGL/GL_Uniform.hpp>
+
+namespace engine::backend::ogl {
+    struct GLBackend;
+    struct GLShaderProgram;
+    struct GLVertexBuffer;
+
+    enum class GLCommandType : uint32_t {
+        COMMAND_BIND_PROGRAM,
+        COMMAND_BIND_TEXTURE,
+        COMMAND_SET_UNIFORM_INT,
+        COMMAND_SET_UNIFORM_FLOAT,
+        COMMAND_SET_UNIFORM_VEC2,
+        COMMAND_SET_UNIFORM_VEC3,
+        COMMAND_SET_UNIFORM_VEC4,
+        COMMAND_SET_UNIFORM_MAT3,
+        COMMAND_SET_UNIFORM_MAT4,
+        COMMAND_SET_VIEWPORT,
+        COMMAND_SET_SCISSOR,
+        COMMAND_ENABLE_FEATURES,
+        COMMAND_DISABLE_FEATURES,
+        COMMAND_CLEAR,
+        COMMAND_DRAW,
+        COMMAND_DRAW_INDEXED_RANGE,
+        COMMAND_DRAW_INSTANCED,
+        COMMAND_UPDATE_VERTICES,
+        COMMAND_UPLOAD_INSTANCES,
+        COMMAND_BEGIN_SCOPE,
+        COMMAND_END_SCOPE
+    };
+
+    // deferred GL work that can be recorded on any thread without a context. commands are packed into a byte
+    // stream of arena blocks that are kept across Reset(), so a list that is re-recorded every frame stops
+    // allocating once it has grown to its working size. data passed in (vertices, instances, uniform values)
+    // is copied; objects are referenced and have to outlive the replay.
+    // a list is recorded by one thread at a time and replayed on the GL thread with Execute, which goes through
+    // the regular GLBackend / GLShaderProgram / GLVertexBuffer calls and therefore through the state cache.
+    struct GLCommandList {
+        explicit GLCommandList(size_t blockSize = 64 * 1024);
+
+        // drops the recorded commands but keeps the blocks for the next recording
+        void Reset();
+
+        // releases the blocks as well
+        void Release();
+
+        bool IsEmpty() const {
+            return m_CommandCount == 0;
+        }
+
+        size_t GetCommandCount() const {
+            return m_CommandCount;
+        }
+
+        // bytes used by the recorded commands
+        size_t GetSize() const;
+
+        void BindProgram(GLShaderProgram *program);
+
+        void BindTexture(core::runtime::graphics::ITexture *texture, int samplerSlot);
+
+        // handles have to be resolved beforehand; GLShaderProgram::GetUniformHandle only reads the table built
+        // at link time, so recording threads may call it on linked programs
+        void SetUniform(GLShaderProgram *program, GLUniformHandle handle, int val);
+
+        void SetUniform(GLShaderProgram *program, GLUniformHandle handle, float val);
+
+        void SetUniform(GLShaderProgram *program, GLUniformHandle handle, const glm::vec2 &val);
+
+        void SetUniform(GLShaderProgram *program, GLUniformHandle handle, const glm::vec3 &val);
+
+        void SetUniform(GLShaderProgram *program, GLUniformHandle handle, const glm::vec4 &val);
+
+        void SetUniform(GLShaderProgram *program, GLUniformHandle handle, const glm::mat3 &val);
+
+        void SetUniform(GLShaderProgram *program, GLUniformHandle handle, const glm::mat4 &val);
+
+        void SetViewport(core::math::Vector2 pos, core::math::Vector2 size);
+
+        void SetScissor(core::math::Vector2 start, core::math::Vector2 size);
+
+        void EnableFeatures(core::runtime::graphics::BackendFeature featuresMask);
+
+        void DisableFeatures(core::runtime::graphics::BackendFeature featuresMask);
+
+        void Clear(core::runtime::graphics::Color color);
+
+        void Draw(GLVertexBuffer *buffer);
+
+        void DrawIndexedRange(GLVertexBuffer *buffer, size_t firstIndex, size_t indexCount, int baseVertex);
+
+        void DrawInstanced(GLVertexBuffer *buffer);
+
+        // GLVertexBuffer::UpdateRange with a copy of the vertices
+        void UpdateVertices(GLVertexBuffer *buffer, size_t firstVertex,
+                            std::span<const core::runtime::graphics::Vertex> vertices);
+
+        // GLVertexBuffer::UploadInstances with a copy of the instances
+        void UploadInstances(GLVertexBuffer *buffer, std::span<const GLInstanceData> instances);
+
+        // GLProfiler scopes around the replayed commands; name must outlive the profiler history
+        void BeginScope(const char *name);
+
+        void EndScope();
+
+        // GL thread: replays every command in recording order. the list is left untouched
+        void Execute(GLBackend &backend) const;
+
+    protected:
+        struct Block {
+            std::unique_ptr<unsigned char[]> data;
+            size_t capacity;
+            size_t used;
+        };
+
+        // returns storage for a command with payloadSize bytes of payload, header included; commands never
+        // straddle blocks
+        void *Allocate(GLCommandType type, size_t payloadSize);
+
+        template<typename T>
+        T *Record(GLCommandType type, const T &payload, size_t extraSize = 0);
+
+        size_t m_BlockSize;
+        std::vector<Block> m_Blocks;
+        size_t m_CurrentBlock = 0;
+        size_t m_CommandCount = 0;
+    };
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <Engine/Core/Runtime/Graphics/IShaderProgram.hpp>
+#include <Engine/Core/Runtime/Graphics/ITexture.hpp>
+#include <Engine/Core/Runtime/Graphics/IVertexBuffer.hpp>
+
+namespace engine::backend::ogl {
+    struct GLBackend;
+
+    enum class GLReleaseType : uint8_t {
+        RELEASE_BUFFER,
+        RELEASE_TEXTURE,
+        RELEASE_VERTEX_ARRAY,
+        RELEASE_PROGRAM
+    };
+
+    // a GL object waiting for the GPU to stop using it. buffers with a usage and capacity, and textures with an
+    // internal format, go back to the GLResourcePool; everything else is deleted.
+    struct GLReleasedObject {
+        GLReleaseType type;
+        unsigned int handle;
+        // buffers: glBufferData usage; textures: internal format of glTexStorage2D storage
+        unsigned int format = 0;
+        // buffers: capacity in bytes
+        size_t size = 0;
+        int width = 0;
+        int height = 0;
+        int levels = 0;
+    };
+
+    // deferred destruction: objects released during a frame are tagged with a fence inserted at the end of that
+    // frame and only deleted, or handed to the resource pool, once the fence has signaled. deleting an object
+    // the GPU still reads from makes tiled drivers wait for it or keep a hidden copy.
+    // Release* and the Release overloads taking objects may be called from any thread; everything else belongs
+    // to the GL thread. Flush runs from GLBackend::EndFrame.
+    struct GLDeletionQueue {
+        // frames to wait when the context has no fences
+        static constexpr uint64_t FALLBACK_LATENCY = 3;
+
+        explicit GLDeletionQueue(GLBackend *backend) : m_Backend(backend) {}
+
+        ~GLDeletionQueue();
+
+        // deletes everything that is still queued without waiting for the GPU; for shutdown
+        void Destroy();
+
+        void Release(const GLReleasedObject &object);
+
+        // buffer storage of a glBufferData usage; capacity 0 deletes the buffer
+        void ReleaseBuffer(unsigned int buffer, size_t capacity = 0, unsigned int usage = 0);
+
+        // internalFormat 0 deletes the texture, anything else recycles its immutable storage
+        void ReleaseTexture(unsigned int texture, unsigned int internalFormat = 0, int width = 0, int height = 0,
+                            int levels = 0);
+
+        void ReleaseVertexArray(unsigned int vertexArray);
+
+        void ReleaseProgram(unsigned int program);
+
+        // hands a whole object over; Destroy() runs on the GL thread on the next Flush, so threads without the
+        // context can drop resources. objects from other backends are not allowed.
+        void Release(std::unique_ptr<core::runtime::graphics::IVertexBuffer> buffer);
+
+        void Release(std::unique_ptr<core::runtime::graphics::ITexture> texture);
+
+        void Release(std::unique_ptr<core::runtime::graphics::IShaderProgram> program);
+
+        // destroys handed-over objects, fences what was released this frame and retires every batch whose fence
+        // has signaled. non-blocking
+        void Flush();
+
+        // objects released but not yet retired
+        size_t GetPendingCount() const;
+
+    protected:
+        struct Batch {
+            void *fence;
+            uint64_t frame;
+            std::vector<GLReleasedObject> objects;
+        };
+
+        bool IsSignaled(const Batch &batch) const;
+
+        // recycle == false deletes even what the resource pool could take
+        void Retire(const GLReleasedObject &object, bool recycle);
+
+        void RetireBatch(Batch &batch, bool recycle);
+
+        GLBackend *m_Backend;
+
+        // filled from any thread
+        mutable std::mutex m_Mutex;
+        std::vector<GLReleasedObject> m_Released;
+        std::vector<std::unique_ptr<core::runtime::graphics::IVertexBuffer>> m_VertexBuffers;
+        std::vector<std::unique_ptr<core::runtime::graphics::ITexture>> m_Textures;
+        std::vector<std::unique_ptr<core::runtime::graphics::IShaderProgram>> m_Programs;
+
+        // GL thread only, oldest first
+        std::deque<Batch> m_Batches;
+    };
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+
+namespace engine::backend::ogl {
+    // counters collected by the backend during a single frame; reset on GLBackend::EndFrame
+    struct GLFrameStats {
+        // one glDraw* / glMultiDraw* call submitting vertexCount vertices per instance
+        void CountDraw(uint64_t vertexCount, uint64_t instanceCount = 1) {
+            drawCalls++;
+            vertices += vertexCount * instanceCount;
+        }
+
+        uint64_t drawCalls = 0;
+        uint64_t vertices = 0;
+        uint64_t programBinds = 0;
+        uint64_t uniformUploads = 0;
+        uint64_t uniformUploadsSkipped = 0;
+        uint64_t stateChanges = 0;
+        uint64_t stateChangesSkipped = 0;
+        // bytes handed to glBufferData / glBufferSubData or written into mapped ranges, excluding the stream ring's
+        uint64_t bufferUploadBytes = 0;
+        // bytes handed to glTex(Sub)Image / glCompressedTex(Sub)Image, excluding the streamer's
+        uint64_t textureUploadBytes = 0;
+        // buffers and textures handed out by GLResourcePool instead of being allocated by the driver
+        uint64_t objectsRecycled = 0;
+        uint64_t streamBytes = 0;
+        uint64_t streamFenceWaitNs = 0;
+        uint64_t textureStreamBytes = 0;
+    };
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <Engine/Core/Runtime/Graphics/IVertexBuffer.hpp>
+
+namespace engine::backend::ogl {
+    // first attribute location available to per-instance data; 0-3 are taken by the Vertex layout
+    static constexpr unsigned int GL_INSTANCE_ATTRIBUTE_BASE = 4;
+
+    // describes one per-instance attribute; matrices take one entry per column
+    struct GLInstanceAttribute {
+        unsigned int location;
+        int components;
+        unsigned int type;
+        bool normalized;
+        // integer attributes go through glVertexAttribIPointer and arrive as ivec/uvec in the shader
+        bool integer;
+        size_t offset;
+    };
+
+    // default per-instance record: a transform (locations 4-7) and a tint color (location 8)
+    struct GLInstanceData {
+        glm::mat4 transform;
+        core::runtime::graphics::Color color;
+    };
+
+    std::vector<GLInstanceAttribute> GL_GetDefaultInstanceLayout();
+}
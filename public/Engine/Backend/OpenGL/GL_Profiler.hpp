@@ -0,0 +1,152 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <Engine/Backend/OpenGL/GL_FrameStats.hpp>
+
+namespace engine::backend::ogl {
+    struct GLBackend;
+
+    // one named scope of a frame. times are steady_clock nanoseconds; GPU timestamps are translated into the
+    // same clock, so CPU and GPU work line up.
+    struct GLProfileSample {
+        const char *name;
+        int depth;
+        uint64_t cpuBeginNs = 0;
+        uint64_t cpuEndNs = 0;
+        // only meaningful when hasGpuTime is set. without GL_TIMESTAMP support only the duration is known and
+        // the span is anchored at cpuBeginNs
+        uint64_t gpuBeginNs = 0;
+        uint64_t gpuEndNs = 0;
+        bool hasGpuTime = false;
+    };
+
+    struct GLProfileFrame {
+        uint64_t frameIndex = 0;
+        uint64_t cpuBeginNs = 0;
+        uint64_t cpuEndNs = 0;
+        // false when the GPU results were lost (disjoint operation or too many frames in flight)
+        bool gpuValid = true;
+        GLFrameStats stats;
+        // in begin order; a sample's children directly follow it with a greater depth
+        std::vector<GLProfileSample> samples;
+    };
+
+    // nested CPU/GPU scope timing. GPU times come from timer queries that are read back several frames later,
+    // only once their results are available, so profiling never stalls the pipeline. with GL_TIMESTAMP
+    // support every scope gets a GPU time; without it (some GLES drivers) only outermost scopes are measured
+    // with GL_TIME_ELAPSED, which cannot nest. frames are completed by GLBackend::EndFrame.
+    struct GLProfiler {
+        explicit GLProfiler(GLBackend *backend, size_t historySize = 240);
+
+        ~GLProfiler();
+
+        // releases every query; frames still in flight are dropped
+        void Destroy();
+
+        void SetEnabled(bool enabled);
+
+        bool IsEnabled() const {
+            return m_Enabled;
+        }
+
+        // GL thread. name must stay valid while the frame is kept in the history, e.g. a string literal
+        void BeginScope(const char *name);
+
+        void EndScope();
+
+        // closes the current frame with its counters and resolves older frames whose queries are available
+        void EndFrame(uint64_t frameIndex, const GLFrameStats &stats);
+
+        // resolved frames, oldest first; the newest one is usually a few frames behind the current frame
+        const std::deque<GLProfileFrame> &GetHistory() const {
+            return m_History;
+        }
+
+        // the most recently resolved frame, or null if none has been resolved yet
+        const GLProfileFrame *GetLatestFrame() const {
+            return m_History.empty() ? nullptr : &m_History.back();
+        }
+
+        // the history in the Chrome trace event format (chrome://tracing, Perfetto)
+        std::string ToChromeTrace() const;
+
+        bool WriteChromeTrace(const std::filesystem::path &path) const;
+
+    protected:
+        // frames whose queries have not been read back yet; older ones lose their GPU times
+        static constexpr size_t MAX_FRAMES_IN_FLIGHT = 4;
+
+        struct PendingQueries {
+            int sample;
+            unsigned int begin;
+            unsigned int end;
+            // GL_TIME_ELAPSED query in end; begin is unused
+            bool elapsed;
+        };
+
+        struct PendingFrame {
+            GLProfileFrame frame;
+            std::vector<PendingQueries> queries;
+            // the frame's last issued query; queries are stored in begin order, so with nested scopes the last
+            // entry of queries is an inner scope whose end precedes the outer ends
+            unsigned int lastQuery = 0;
+        };
+
+        unsigned int AcquireQuery();
+
+        void ReleaseQueries(PendingFrame &pending);
+
+        // non-blocking; false if the frame's results are not available yet
+        bool Resolve(PendingFrame &pending);
+
+        // measures the offset between the GPU timestamp clock and steady_clock
+        void Calibrate();
+
+        void PushHistory(GLProfileFrame &&frame);
+
+        GLBackend *m_Backend;
+        bool m_Enabled = true;
+        size_t m_HistorySize;
+
+        PendingFrame m_Current;
+        // indices into m_Current.frame.samples / m_Current.queries of the open scopes
+        std::vector<int> m_OpenSamples;
+        std::vector<int> m_OpenQueries;
+        // open scope measured with GL_TIME_ELAPSED, -1 if none
+        int m_ElapsedScope = -1;
+
+        std::deque<PendingFrame> m_InFlight;
+        std::deque<GLProfileFrame> m_History;
+
+        std::vector<unsigned int> m_FreeQueries;
+        std::vector<unsigned int> m_AllQueries;
+
+        int64_t m_GpuClockOffset = 0;
+        uint64_t m_FramesSinceCalibration = 0;
+        bool m_Calibrated = false;
+    };
+
+    // RAII helper for GLProfiler::BeginScope / EndScope
+    struct GLProfileScope {
+        GLProfileScope(GLProfiler &profiler, const char *name) : m_Profiler(profiler) {
+            m_Profiler.BeginScope(name);
+        }
+
+        ~GLProfileScope() {
+            m_Profiler.EndScope();
+        }
+
+        GLProfileScope(const GLProfileScope &) = delete;
+
+        GLProfileScope &operator=(const GLProfileScope &) = delete;
+
+    protected:
+        GLProfiler &m_Profiler;
+    };
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace engine::backend::ogl {
+    // one shader of a program as far as the cache key is concerned; stage is the ShaderType it was compiled as
+    struct GLProgramSource {
+        unsigned int stage;
+        std::string_view source;
+    };
+
+    // persistent cache of linked program binaries (glGetProgramBinary / glProgramBinary).
+    // entries are keyed by the program sources and the identity of the driver that produced them,
+    // and live in a versioned sub-directory so format changes never read stale data.
+    struct GLProgramBinaryCache {
+        static constexpr uint32_t CACHE_VERSION = 1;
+
+        // must be called with a current context; disables itself if the driver exposes no binary formats
+        bool Initialize();
+
+        // where the binaries are stored, normally a cache directory private to the application. nothing is
+        // written to or read from disk until one is set; may be called before or after Initialize.
+        bool SetDirectory(std::filesystem::path directory);
+
+        const std::filesystem::path &GetDirectory() const {
+            return m_Directory;
+        }
+
+        // whether the driver can hand out and take back program binaries, with or without a directory
+        bool IsSupported() const {
+            return m_Supported;
+        }
+
+        uint64_t ComputeKey(std::span<const GLProgramSource> sources) const;
+
+        // loads the cached binary into the program; returns false on a miss, without a directory or if the
+        // driver rejected it
+        bool Load(uint64_t key, unsigned int program);
+
+        // no-op without a directory
+        void Store(uint64_t key, unsigned int program);
+
+        // serialized form of a linked program: a small header followed by the driver blob.
+        // the same layout is used for the files on disk and for GLShader::UseCompiledShader.
+        std::vector<unsigned char> Capture(uint64_t key, unsigned int program) const;
+
+        // key == 0 skips the source check (used for binaries handed in by the caller)
+        bool Apply(std::span<const unsigned char> blob, uint64_t key, unsigned int program) const;
+
+    protected:
+        std::filesystem::path GetEntryPath(uint64_t key) const;
+
+        bool OpenDirectory();
+
+        bool m_Supported = false;
+        // the directory exists and Load / Store may use it
+        bool m_DirectoryOpen = false;
+        uint64_t m_DriverHash = 0;
+        std::filesystem::path m_Directory;
+    };
+}
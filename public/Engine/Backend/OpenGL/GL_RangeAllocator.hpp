@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+
+namespace engine::backend::ogl {
+    // first-fit offset allocator over an abstract range (bytes, vertices, ...); freed ranges are coalesced
+    // with their neighbours. holds no GL state, it only hands out offsets.
+    struct GLRangeAllocator {
+        static constexpr size_t INVALID_OFFSET = SIZE_MAX;
+
+        explicit GLRangeAllocator(size_t capacity = 0);
+
+        void Reset(size_t capacity);
+
+        // returns INVALID_OFFSET if no free block is large enough
+        size_t Allocate(size_t size, size_t alignment = 1);
+
+        void Free(size_t offset, size_t size);
+
+        size_t GetCapacity() const {
+            return m_Capacity;
+        }
+
+        size_t GetFreeSpace() const {
+            return m_FreeSpace;
+        }
+
+        size_t GetLargestFreeBlock() const;
+
+    protected:
+        size_t m_Capacity = 0;
+        size_t m_FreeSpace = 0;
+        // offset -> size
+        std::map<size_t, size_t> m_FreeBlocks;
+    };
+}
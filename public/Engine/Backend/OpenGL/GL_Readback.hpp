@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <span>
+#include <vector>
+
+#include <Engine/Core/Runtime/Graphics/ITexture.hpp>
+
+namespace engine::backend::ogl {
+    struct GLBackend;
+    struct GLTexture;
+
+    // receives the copied bytes on the GL thread; the span is empty if the readback failed and is only
+    // valid for the duration of the call. must not start new readbacks.
+    using GLReadbackCallback = std::function<void(std::span<const unsigned char> data)>;
+
+    // GPU -> CPU image readback without stalling: the copy is issued with glReadPixels into a
+    // GL_PIXEL_PACK_BUFFER and fenced, and the returned future is fulfilled by Poll() once the fence has
+    // signaled. Poll runs from GLBackend::EndFrame, so results normally arrive a frame or two later.
+    // futures are only fulfilled on the GL thread; never block on one there without calling WaitAll() first.
+    struct GLReadback {
+        explicit GLReadback(GLBackend *backend, int stagingBufferCount = 2);
+
+        ~GLReadback();
+
+        // waits for every pending readback and releases the staging buffers
+        void Destroy();
+
+        // reads a mip level of an RGBA8 texture; rows are in upload order
+        std::future<core::runtime::graphics::Bitmap> ReadTexture(GLTexture &texture, int level = 0);
+
+        // reads a region of the backend's default framebuffer; rows are returned top to bottom
+        std::future<core::runtime::graphics::Bitmap> ReadFramebuffer(int x, int y, int width, int height);
+
+        // copies a range of any buffer object on the GPU and hands it to the callback once the copy has landed.
+        // results written by shaders (SSBO / image stores) need a glMemoryBarrier before this call.
+        void ReadBuffer(unsigned int buffer, size_t offset, size_t size, GLReadbackCallback callback);
+
+        // fulfils every readback whose fence has signaled; non-blocking
+        void Poll();
+
+        // blocks until every pending readback is fulfilled
+        void WaitAll();
+
+        size_t GetPendingCount() const {
+            return m_Pending.size();
+        }
+
+    protected:
+        struct StagingBuffer {
+            unsigned int handle = 0;
+            size_t capacity = 0;
+            bool busy = false;
+        };
+
+        struct Pending {
+            void *fence;
+            int staging;
+            size_t size;
+            GLReadbackCallback callback;
+        };
+
+        // a free staging buffer of at least size bytes; grows the pool instead of waiting for the GPU
+        int AcquireStagingBuffer(size_t size);
+
+        // issues the read from the bound read framebuffer
+        std::future<core::runtime::graphics::Bitmap> ReadPixels(int x, int y, int width, int height, bool flipRows);
+
+        // fences the copy just issued into the staging buffer
+        void Track(int staging, size_t size, GLReadbackCallback callback);
+
+        void Resolve(Pending &pending);
+
+        GLBackend *m_Backend;
+        unsigned int m_Framebuffer = 0;
+        std::vector<StagingBuffer> m_StagingBuffers;
+        std::vector<Pending> m_Pending;
+    };
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace engine::backend::ogl {
+    struct GLRect {
+        int x = 0;
+        int y = 0;
+        int width = 0;
+        int height = 0;
+
+        bool IsValid() const {
+            return width > 0 && height > 0;
+        }
+    };
+
+    // guillotine packer over a 2D area: each allocation is cut out of the best-fitting free rectangle and the
+    // remainder is split into two free rectangles. freed rectangles are merged back with neighbours sharing a
+    // full edge. holds no GL state, it only hands out rectangles.
+    struct GLRectAllocator {
+        GLRectAllocator(int width = 0, int height = 0);
+
+        void Reset(int width, int height);
+
+        // returns an invalid rect if nothing fits
+        GLRect Allocate(int width, int height);
+
+        void Free(const GLRect &rect);
+
+        int GetWidth() const {
+            return m_Width;
+        }
+
+        int GetHeight() const {
+            return m_Height;
+        }
+
+        // in texels
+        int64_t GetFreeArea() const {
+            return m_FreeArea;
+        }
+
+        bool IsEmpty() const {
+            return m_FreeArea == static_cast<int64_t>(m_Width) * m_Height;
+        }
+
+    protected:
+        // merges pairs of free rectangles that together form a rectangle until no more pairs exist
+        void MergeFreeRects();
+
+        int m_Width = 0;
+        int m_Height = 0;
+        int64_t m_FreeArea = 0;
+        std::vector<GLRect> m_FreeRects;
+    };
+}
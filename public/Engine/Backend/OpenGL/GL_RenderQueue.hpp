@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <Engine/Core/Runtime/Graphics/ITexture.hpp>
+#include <Engine/Backend/OpenGL/GL_Uniform.hpp>
+
+namespace engine::backend::ogl {
+    struct GLBackend;
+    struct GLShaderProgram;
+    struct GLVertexBuffer;
+
+    // one draw of a GLRenderQueue. indexCount == 0 draws the whole buffer (Draw / DrawInstanced)
+    struct GLDrawItem {
+        GLShaderProgram *program = nullptr;
+        core::runtime::graphics::ITexture *texture = nullptr;
+        int textureSlot = 0;
+        GLVertexBuffer *buffer = nullptr;
+
+        // layers are submitted in increasing order; everything else only matters within a layer
+        uint8_t layer = 0;
+        // blended draws go after the opaque ones of their layer, sorted back to front
+        bool translucent = false;
+        // view-space distance to the camera; opaque draws are sorted front to back by it
+        float depth = 0.f;
+
+        bool instanced = false;
+        size_t firstIndex = 0;
+        size_t indexCount = 0;
+        int baseVertex = 0;
+
+        // optional per-draw transform, uploaded when the handle is valid
+        GLUniformHandle transformUniform;
+        glm::mat4 transform{1.f};
+    };
+
+    // program / texture / buffer switches of one submission, and what the same draws would have caused in
+    // the order they were added
+    struct GLRenderQueueStats {
+        size_t draws = 0;
+        size_t programSwitches = 0;
+        size_t textureSwitches = 0;
+        size_t bufferSwitches = 0;
+        size_t unsortedProgramSwitches = 0;
+        size_t unsortedTextureSwitches = 0;
+        size_t unsortedBufferSwitches = 0;
+
+        size_t GetSavedSwitches() const {
+            auto unsorted = unsortedProgramSwitches + unsortedTextureSwitches + unsortedBufferSwitches;
+            auto sorted = programSwitches + textureSwitches + bufferSwitches;
+            return unsorted > sorted ? unsorted - sorted : 0;
+        }
+    };
+
+    // stable LSD radix sort of the indices 0..keys.size()-1 by key, 8 bits per pass. passes in which every key
+    // has the same digit are skipped, so keys with unused high bits sort in fewer passes.
+    void GL_RadixSort(const std::vector<uint64_t> &keys, std::vector<uint32_t> &order, std::vector<uint32_t> &scratch);
+
+    // collects a frame's draws and submits them ordered by a 64-bit key, so draws sharing a program, texture
+    // and vertex buffer end up next to each other:
+    //   opaque:      layer(8) | 0 | program(14) | texture(14) | buffer(11) | depth(16, front to back)
+    //   translucent: layer(8) | 1 | depth(16, back to front) | program(14) | texture(14) | buffer(11)
+    // programs, textures and buffers get dense ids in order of first use each frame; past the field width they
+    // share the last id, which only costs sorting quality. depth keeps the top 16 bits of the float (exponent
+    // and 7 mantissa bits), which preserve the order of non-negative values.
+    struct GLRenderQueue {
+        explicit GLRenderQueue(GLBackend *backend) : m_Backend(backend) {}
+
+        void Add(const GLDrawItem &item);
+
+        size_t GetSize() const {
+            return m_Items.size();
+        }
+
+        // sorts and issues every draw. opaque draws are issued with alpha blending disabled and translucent ones
+        // with it enabled; the previous blending state is restored afterwards. the queue keeps its draws.
+        void Submit();
+
+        // drops the queued draws; storage is kept for the next frame
+        void Clear();
+
+        const GLRenderQueueStats &GetLastStats() const {
+            return m_LastStats;
+        }
+
+    protected:
+        uint32_t GetId(std::unordered_map<const void *, uint32_t> &ids, const void *object, uint32_t bits);
+
+        GLBackend *m_Backend;
+        std::vector<GLDrawItem> m_Items;
+        std::vector<uint64_t> m_Keys;
+        std::vector<uint32_t> m_Order;
+        std::vector<uint32_t> m_Scratch;
+        std::unordered_map<const void *, uint32_t> m_ProgramIds;
+        std::unordered_map<const void *, uint32_t> m_TextureIds;
+        std::unordered_map<const void *, uint32_t> m_BufferIds;
+        GLRenderQueueStats m_LastStats;
+    };
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+namespace engine::backend::ogl {
+    struct GLBackend;
+
+    // off-screen framebuffer with an RGBA8 color texture and a depth/stencil renderbuffer; stands in for the
+    // window framebuffer of headless contexts
+    struct GLRenderTarget {
+        GLRenderTarget(GLBackend *backend, int width, int height);
+
+        ~GLRenderTarget();
+
+        bool Create();
+
+        void Destroy();
+
+        // binds the framebuffer for drawing and reading and sets the viewport to cover it
+        void Bind();
+
+        int GetWidth() const {
+            return m_Width;
+        }
+
+        int GetHeight() const {
+            return m_Height;
+        }
+
+        unsigned int GetHandle() const {
+            return m_FboHandle;
+        }
+
+        // the color attachment; can be sampled once rendering into it has finished
+        unsigned int GetColorTexture() const {
+            return m_ColorHandle;
+        }
+
+    protected:
+        GLBackend *m_Backend;
+        unsigned int m_FboHandle = 0;
+        unsigned int m_ColorHandle = 0;
+        unsigned int m_DepthHandle = 0;
+        int m_Width;
+        int m_Height;
+    };
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <tuple>
+#include <vector>
+
+namespace engine::backend::ogl {
+    struct GLBackend;
+
+    enum class GLNameType {
+        NAME_BUFFER,
+        NAME_VERTEX_ARRAY,
+        NAME_TEXTURE
+    };
+
+    // GL thread only. hands out object names reserved in batches (one glGen* call per NAME_BATCH names) and
+    // keeps released buffers and immutable textures around so a later request with the same size / format gets
+    // the existing storage back instead of the driver allocating it again. recycled objects that are not asked
+    // for within MAX_IDLE_FRAMES, or that do not fit in the byte budget, are deleted. released objects reach
+    // the pool through GLDeletionQueue once the GPU has stopped using them.
+    struct GLResourcePool {
+        static constexpr int NAME_BATCH = 32;
+        static constexpr uint64_t MAX_IDLE_FRAMES = 120;
+
+        explicit GLResourcePool(GLBackend *backend) : m_Backend(backend) {}
+
+        ~GLResourcePool();
+
+        void Destroy();
+
+        // a fresh name without storage
+        unsigned int GenName(GLNameType type);
+
+        // gives back a name whose object never received storage
+        void ReleaseName(GLNameType type, unsigned int name);
+
+        // a recycled buffer of the given glBufferData usage holding at least size bytes, but no more than a
+        // quarter above it; 0 if there is none. capacity receives the real size of its storage.
+        unsigned int AcquireBuffer(size_t size, unsigned int usage, size_t &capacity);
+
+        // takes over a buffer the GPU is done with; deleted instead if it has no storage or the pool is full
+        void RecycleBuffer(unsigned int buffer, size_t capacity, unsigned int usage);
+
+        // a recycled glTexStorage2D texture with exactly this format, size and level count; 0 if there is none
+        unsigned int AcquireTexture(unsigned int internalFormat, int width, int height, int levels);
+
+        // takes over immutable texture storage the GPU is done with; deleted instead if the pool is full
+        void RecycleTexture(unsigned int texture, unsigned int internalFormat, int width, int height, int levels);
+
+        // deletes recycled objects that have been idle for too long; called by GLBackend::EndFrame
+        void Update();
+
+        // caps the memory held by recycled objects; shrinking it deletes objects on the next Update
+        void SetBudget(size_t bytes) {
+            m_Budget = bytes;
+        }
+
+        size_t GetPooledBytes() const {
+            return m_PooledBytes;
+        }
+
+    protected:
+        struct PooledBuffer {
+            unsigned int handle;
+            unsigned int usage;
+            uint64_t frame;
+        };
+
+        struct PooledTexture {
+            unsigned int handle;
+            size_t bytes;
+            uint64_t frame;
+        };
+
+        // internal format, width, height, levels
+        using TextureKey = std::tuple<unsigned int, int, int, int>;
+
+        void DeleteBuffer(unsigned int buffer);
+
+        void DeleteTexture(unsigned int texture);
+
+        GLBackend *m_Backend;
+        std::array<std::vector<unsigned int>, 3> m_Names;
+        // capacity -> buffer
+        std::multimap<size_t, PooledBuffer> m_Buffers;
+        std::multimap<TextureKey, PooledTexture> m_Textures;
+        size_t m_PooledBytes = 0;
+        size_t m_Budget = 64 * 1024 * 1024;
+    };
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+
+namespace engine::backend::ogl {
+    struct GLBackend;
+
+    enum class GLTextureFilter : uint8_t {
+        FILTER_NEAREST,
+        FILTER_LINEAR,
+        // linear within and between mip levels
+        FILTER_TRILINEAR
+    };
+
+    enum class GLTextureWrap : uint8_t {
+        WRAP_CLAMP,
+        WRAP_REPEAT,
+        WRAP_MIRROR
+    };
+
+    struct GLSamplerDesc {
+        GLTextureFilter filter = GLTextureFilter::FILTER_LINEAR;
+        GLTextureWrap wrapS = GLTextureWrap::WRAP_CLAMP;
+        GLTextureWrap wrapT = GLTextureWrap::WRAP_CLAMP;
+        // 1 disables anisotropic filtering; clamped to what the driver supports
+        float anisotropy = 1.f;
+    };
+
+    // deduplicated sampler objects keyed by their description; samplers live until Destroy(), so handles
+    // can be stored freely. requires sampler objects (GL 3.3 / GLES 3.0).
+    struct GLSamplerCache {
+        explicit GLSamplerCache(GLBackend *backend) : m_Backend(backend) {}
+
+        unsigned int Get(const GLSamplerDesc &desc);
+
+        void Destroy();
+
+        size_t GetSamplerCount() const {
+            return m_Samplers.size();
+        }
+
+        // applies a description directly as texture parameters of the texture bound to target
+        static void ApplyToTexture(unsigned int target, const GLSamplerDesc &desc, float maxAnisotropy);
+
+    protected:
+        GLBackend *m_Backend;
+        std::unordered_map<uint32_t, unsigned int> m_Samplers;
+    };
+}
@@ -1,10 +1,15 @@
 #pragma once
 
+#include <vector>
+
 #include <Engine/Core/Runtime/Graphics/IShader.hpp>
 
 namespace engine::backend::ogl {
+    struct GLBackend;
+
     struct GLShader : public core::runtime::graphics::IShader {
-        GLShader() : m_ShaderHandle(-1) {}
+        explicit GLShader(GLBackend *backend) : m_Backend(backend), m_ShaderHandle(-1),
+                                                m_Type(core::runtime::graphics::ShaderType::SHADER_TYPE_VERTEX) {}
 
         bool Compile() override;
 
@@ -18,22 +23,35 @@ namespace engine::backend::ogl {
 
         bool IsCompiled() override;
 
-        bool UseCompiledShader(const std::span<unsigned char>& data, core::runtime::graphics::ShaderType type) override {
-            return false;
-        }
+        // issues the compile without waiting for its result; lets the driver compile in the background
+        void SubmitCompile();
 
-        std::span<unsigned char> GetCompiledShader() override {
-            return {};
-        }
+        // GL has no portable per-stage binaries; the data is a linked program binary as produced by
+        // GLShaderProgram::GetProgramBinary, which the owning program tries before compiling from source.
+        bool UseCompiledShader(const std::span<unsigned char>& data, core::runtime::graphics::ShaderType type) override;
 
-        core::runtime::graphics::ShaderCapsFlags GetImplCapabilities() const override {
-            return core::runtime::graphics::ShaderCapsFlags::SHADER_CAPS_NONE;
-        }
+        std::span<unsigned char> GetCompiledShader() override;
+
+        core::runtime::graphics::ShaderCapsFlags GetImplCapabilities() const override;
 
         unsigned int GetHandle() const {
             return m_ShaderHandle;
         };
+
+        // the source as last passed to SetSource; used to key the program binary cache without a driver round trip
+        std::string_view GetCachedSource() const {
+            return m_Source;
+        }
+
+        core::runtime::graphics::ShaderType GetType() const {
+            return m_Type;
+        }
     protected:
+        GLBackend *m_Backend;
         unsigned int m_ShaderHandle;
+        core::runtime::graphics::ShaderType m_Type;
+        std::string m_Source;
+        bool m_CompileSubmitted = false;
+        std::vector<unsigned char> m_CompiledBinary;
     };
 }
\ No newline at end of file
@@ -1,15 +1,50 @@
 #pragma once
 
+#include <span>
 #include <vector>
 
 #include <Engine/Core/Runtime/Graphics/IShaderProgram.hpp>
+#include <Engine/Backend/OpenGL/GL_SlabPool.hpp>
+#include <Engine/Backend/OpenGL/GL_Uniform.hpp>
 
 namespace engine::backend::ogl {
-    struct GLShaderProgram : public core::runtime::graphics::IShaderProgram {
-        GLShaderProgram() : m_ProgramHandle(-1) {}
+    struct GLBackend;
 
+    enum class GLLinkState {
+        LINK_STATE_NONE,
+        LINK_STATE_PENDING,
+        LINK_STATE_READY,
+        LINK_STATE_FAILED
+    };
+
+    struct GLShaderProgram : public core::runtime::graphics::IShaderProgram, public GLPooled<GLShaderProgram, 16> {
+        explicit GLShaderProgram(GLBackend *backend) : m_Backend(backend), m_ProgramHandle(-1) {}
+
+        // blocking; equivalent to LinkAsync() followed by FinishLink()
         bool Link() override;
 
+        // submits compilation and linking without waiting for the driver. returns false only on immediate
+        // failures; poll with PollLink() and keep rendering with a fallback program until it is ready.
+        bool LinkAsync();
+
+        // compiles and links on one of the backend's shared-context workers (LinkAsync without workers).
+        // the program must not be bound, changed or queried for uniforms until GetLinkState() leaves PENDING.
+        bool LinkOnWorker();
+
+        // non-blocking when GL_KHR_parallel_shader_compile is available, otherwise it finishes the link
+        GLLinkState PollLink();
+
+        // waits for a pending link and finalizes it; returns whether the program is usable
+        bool FinishLink();
+
+        GLLinkState GetLinkState() const {
+            return m_WorkerLinkPending ? GLLinkState::LINK_STATE_PENDING : m_LinkState;
+        }
+
+        bool IsReady() {
+            return PollLink() == GLLinkState::LINK_STATE_READY;
+        }
+
         void Destroy() override;
 
         void Bind() override;
@@ -26,8 +61,85 @@ namespace engine::backend::ogl {
 
         bool IsLinked() override;
 
+        // resolves a uniform from the table built at link time; returns an invalid handle if the
+        // uniform does not exist or was optimized out by the driver.
+        GLUniformHandle GetUniformHandle(std::string_view name) const;
+
+        const GLUniformInfo *GetUniformInfo(GLUniformHandle handle) const;
+
+        // uniform blocks reflected at link time; returns nullptr if the block does not exist
+        const GLUniformBlockInfo *GetUniformBlock(std::string_view name) const;
+
+        const std::vector<GLUniformBlockInfo> &GetUniformBlocks() const {
+            return m_UniformBlocks;
+        }
+
+        // typed setters; values equal to the last uploaded one are not re-sent to the driver.
+        void SetUniform(GLUniformHandle handle, int val);
+
+        void SetUniform(GLUniformHandle handle, float val);
+
+        void SetUniform(GLUniformHandle handle, const glm::vec2 &val);
+
+        void SetUniform(GLUniformHandle handle, const glm::vec3 &val);
+
+        void SetUniform(GLUniformHandle handle, const glm::vec4 &val);
+
+        void SetUniform(GLUniformHandle handle, const glm::mat3 &val);
+
+        void SetUniform(GLUniformHandle handle, const glm::mat4 &val);
+
+        // array setters; values beyond the reflected array size are ignored.
+        void SetUniformArray(GLUniformHandle handle, std::span<const int> values);
+
+        void SetUniformArray(GLUniformHandle handle, std::span<const float> values);
+
+        void SetUniformArray(GLUniformHandle handle, std::span<const glm::vec2> values);
+
+        void SetUniformArray(GLUniformHandle handle, std::span<const glm::vec3> values);
+
+        void SetUniformArray(GLUniformHandle handle, std::span<const glm::vec4> values);
+
+        void SetUniformArray(GLUniformHandle handle, std::span<const glm::mat4> values);
+
+        unsigned int GetHandle() const {
+            return m_ProgramHandle;
+        };
+
+        // serialized binary of the linked program; can be fed back through GLShader::UseCompiledShader.
+        // empty if the context has no program binary support.
+        std::vector<unsigned char> GetProgramBinary() const;
+
     protected:
+        // tries a caller-provided binary, then the on-disk cache; returns true if the program is linked
+        bool LinkFromBinary();
+
+        void ReleaseShaders();
+
+        void ReflectUniforms();
+
+        // blocks without an explicit layout(binding) get the backend-wide binding registered for their name,
+        // so every program reads a block of the same name from the same binding point. GL reports the binding
+        // of such blocks as 0, like an explicit binding = 0, so the shader sources decide which ones they are;
+        // has to run before ReleaseShaders drops them.
+        void ReflectUniformBlocks();
+
+        // checks that a value of the given GL type may set the uniform and compares it against the shadow copy;
+        // returns the number of elements that have to be uploaded (0 if the value is unchanged or rejected) and
+        // makes sure the program is bound.
+        int PrepareUniformUpload(GLUniformHandle handle, const void *data, unsigned int valueType, size_t count);
+
+        GLBackend *m_Backend;
         unsigned int m_ProgramHandle;
         std::vector<std::shared_ptr<core::runtime::graphics::IShader>> m_Shaders;
+        uint64_t m_BinaryKey = 0;
+        GLLinkState m_LinkState = GLLinkState::LINK_STATE_NONE;
+        // set while a worker owns the program; cleared on the GL thread once its link has been handed over
+        bool m_WorkerLinkPending = false;
+
+        std::vector<GLUniformInfo> m_Uniforms;
+        GLUniformNameMap m_UniformLookup;
+        std::vector<unsigned char> m_UniformShadow;
+        std::vector<GLUniformBlockInfo> m_UniformBlocks;
     };
-}
\ No newline at end of file
+}
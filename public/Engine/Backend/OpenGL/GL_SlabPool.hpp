@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace engine::backend::ogl {
+    // fixed-size object allocator: slots are carved out of slabs of slotsPerSlab and recycled through an
+    // intrusive free list, so creating and destroying objects of one type stops hitting the heap once the pool
+    // has grown to the working set. slabs are kept until the pool is destroyed. holds no GL state; thread-safe,
+    // objects may be freed on any thread.
+    struct GLSlabPool {
+        GLSlabPool(size_t slotSize, size_t slotAlignment, size_t slotsPerSlab = 64);
+
+        ~GLSlabPool();
+
+        GLSlabPool(const GLSlabPool &) = delete;
+
+        GLSlabPool &operator=(const GLSlabPool &) = delete;
+
+        void *Allocate();
+
+        // pointer must come from Allocate of this pool
+        void Free(void *slot);
+
+        size_t GetSlotSize() const {
+            return m_SlotSize;
+        }
+
+        size_t GetLiveCount() const;
+
+        size_t GetCapacity() const;
+
+    protected:
+        struct FreeSlot {
+            FreeSlot *next;
+        };
+
+        size_t m_SlotSize;
+        size_t m_SlotsPerSlab;
+        mutable std::mutex m_Mutex;
+        std::vector<void *> m_Slabs;
+        FreeSlot *m_FreeList = nullptr;
+        size_t m_LiveCount = 0;
+    };
+
+    // base that allocates instances of T from a process-wide slab pool instead of the general heap. the pool
+    // is never destroyed, since objects owned by statics may be released after it would have been; types
+    // derived from T do not fit in its slots and go to the heap.
+    template<typename T, size_t SlotsPerSlab = 64>
+    struct GLPooled {
+        static void *operator new(size_t size) {
+            return size == sizeof(T) ? GetPool().Allocate() : ::operator new(size);
+        }
+
+        static void operator delete(void *pointer, size_t size) {
+            if (size == sizeof(T)) {
+                GetPool().Free(pointer);
+            } else {
+                ::operator delete(pointer);
+            }
+        }
+
+        static GLSlabPool &GetPool() {
+            static auto *pool = new GLSlabPool(sizeof(T), alignof(T), SlotsPerSlab);
+            return *pool;
+        }
+    };
+}
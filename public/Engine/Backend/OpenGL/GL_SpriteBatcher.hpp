@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <Engine/Core/Runtime/Graphics/ITexture.hpp>
+#include <Engine/Backend/OpenGL/GL_ShaderProgram.hpp>
+#include <Engine/Backend/OpenGL/GL_TextureArray.hpp>
+
+namespace engine::backend::ogl {
+    struct GLBackend;
+
+    enum class GLSpriteBlend : uint8_t {
+        SPRITE_BLEND_ALPHA,
+        SPRITE_BLEND_ADDITIVE,
+        SPRITE_BLEND_OPAQUE
+    };
+
+    // an image registered with the batcher: a layer of one of its texture arrays
+    struct GLSpriteImage {
+        int array = -1;
+        int layer = 0;
+        glm::vec2 size{0.f, 0.f};
+
+        bool IsValid() const {
+            return array >= 0;
+        }
+    };
+
+    // accumulates textured quads and flushes them with as few draws as possible. images of the same size
+    // share a GL_TEXTURE_2D_ARRAY, so consecutive sprites only break a batch when their size class or blend
+    // mode changes. sprites are ordered by their sort layer first; within a layer the order is not preserved,
+    // so overlapping sprites that must draw in a fixed order need distinct layers.
+    struct GLSpriteBatcher {
+        static constexpr size_t MAX_SPRITES_PER_DRAW = 16384;
+
+        explicit GLSpriteBatcher(GLBackend *backend, int layersPerArray = 64);
+
+        ~GLSpriteBatcher();
+
+        bool Create();
+
+        void Destroy();
+
+        GLSpriteImage AddImage(const core::runtime::graphics::Bitmap &bitmap);
+
+        void Begin(const glm::mat4 &projection);
+
+        // uvRect is (u0, v0, u1, v1) within the image
+        void Draw(const GLSpriteImage &image, glm::vec2 position, glm::vec2 size,
+                  core::runtime::graphics::Color color = {255, 255, 255, 255},
+                  int sortLayer = 0,
+                  GLSpriteBlend blend = GLSpriteBlend::SPRITE_BLEND_ALPHA,
+                  glm::vec4 uvRect = {0.f, 0.f, 1.f, 1.f});
+
+        // sorts and submits everything queued since Begin
+        void End();
+
+        // draw calls issued by the last End()
+        size_t GetLastDrawCount() const {
+            return m_LastDrawCount;
+        }
+
+    protected:
+        struct SpriteVertex {
+            float x, y;
+            float u, v, layer;
+            core::runtime::graphics::Color color;
+        };
+
+        struct Sprite {
+            uint64_t key;
+            int array;
+            GLSpriteBlend blend;
+            SpriteVertex vertices[4];
+        };
+
+        void ApplyBlend(GLSpriteBlend blend);
+
+        // points the vertex attributes at the given buffer range; skipped if they already do
+        void ConfigureAttributes(unsigned int sourceBuffer, size_t byteOffset);
+
+        // draws sprites [first, first + count) of m_Order, which all share an array and blend mode
+        void SubmitRun(size_t first, size_t count);
+
+        GLBackend *m_Backend;
+        int m_LayersPerArray;
+
+        std::unique_ptr<GLShaderProgram> m_Program;
+        GLUniformHandle m_ProjectionUniform;
+        GLUniformHandle m_TextureUniform;
+
+        unsigned int m_VaoHandle = 0;
+        unsigned int m_EboHandle = 0;
+        unsigned int m_AttributeSource = 0;
+        size_t m_AttributeOffset = 0;
+
+        std::vector<std::unique_ptr<GLTextureArray>> m_Arrays;
+
+        glm::mat4 m_Projection{};
+        std::vector<Sprite> m_Sprites;
+        std::vector<uint32_t> m_Order;
+        size_t m_LastDrawCount = 0;
+    };
+}
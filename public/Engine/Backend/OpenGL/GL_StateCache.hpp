@@ -0,0 +1,117 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace engine::backend::ogl {
+    struct GLBackend;
+
+    // shadows the GL state of a single context so redundant binds and enables never reach the driver.
+    // every GL object owned by a GLBackend must change the tracked state through this cache, otherwise
+    // the shadow copy goes out of sync; call Invalidate() after touching GL state behind its back.
+    struct GLStateCache {
+        static constexpr unsigned int UNKNOWN = ~0u;
+        static constexpr int MAX_TEXTURE_UNITS = 32;
+        static constexpr int MAX_TEXTURE_TARGETS = 2;
+        static constexpr int MAX_UNIFORM_BINDINGS = 36;
+
+        explicit GLStateCache(GLBackend *backend) : m_Backend(backend) {
+            Invalidate();
+        }
+
+        // forget everything; the next call of each kind always reaches the driver
+        void Invalidate();
+
+        void UseProgram(unsigned int program);
+
+        void ActiveTexture(int unit);
+
+        void BindTexture(int unit, unsigned int target, unsigned int texture);
+
+        // binds on whatever unit is currently active; meant for create/update paths
+        void BindTexture(unsigned int target, unsigned int texture);
+
+        // glBindSampler; sampler bindings do not depend on the active unit
+        void BindSampler(int unit, unsigned int sampler);
+
+        void BindVertexArray(unsigned int vao);
+
+        // only non-VAO targets are tracked; GL_ELEMENT_ARRAY_BUFFER is forwarded as VAO state
+        void BindBuffer(unsigned int target, unsigned int buffer);
+
+        // glBindBufferRange on GL_UNIFORM_BUFFER; also changes the generic GL_UNIFORM_BUFFER binding
+        void BindUniformBufferRange(unsigned int index, unsigned int buffer, size_t offset, size_t size);
+
+        void SetCapability(unsigned int cap, bool enabled);
+
+        void SetBlendEquation(unsigned int mode);
+
+        void SetBlendFuncSeparate(unsigned int srcRgb, unsigned int dstRgb, unsigned int srcAlpha, unsigned int dstAlpha);
+
+        void SetViewport(int x, int y, int width, int height);
+
+        void SetScissor(int x, int y, int width, int height);
+
+        void SetClearColor(float r, float g, float b, float a);
+
+        // GL implicitly unbinds deleted objects; names may be recycled afterwards, so drop them from the shadow state
+        void OnProgramDeleted(unsigned int program);
+
+        void OnTextureDeleted(unsigned int texture);
+
+        void OnSamplerDeleted(unsigned int sampler);
+
+        void OnVertexArrayDeleted(unsigned int vao);
+
+        void OnBufferDeleted(unsigned int buffer);
+
+        unsigned int GetProgram() const {
+            return m_Program;
+        }
+
+        unsigned int GetVertexArray() const {
+            return m_VertexArray;
+        }
+
+        // queried from GL while unknown, e.g. right after Invalidate()
+        const std::array<int, 4> &GetViewport();
+
+    protected:
+        struct BufferBinding {
+            unsigned int target;
+            unsigned int buffer;
+        };
+
+        struct BufferRangeBinding {
+            unsigned int buffer;
+            size_t offset;
+            size_t size;
+        };
+
+        static int GetTextureTargetIndex(unsigned int target);
+
+        BufferBinding *FindBufferBinding(unsigned int target);
+
+        void CountChange(bool issued);
+
+        GLBackend *m_Backend;
+
+        unsigned int m_Program;
+        int m_ActiveTextureUnit;
+        std::array<std::array<unsigned int, MAX_TEXTURE_TARGETS>, MAX_TEXTURE_UNITS> m_Textures;
+        std::array<unsigned int, MAX_TEXTURE_UNITS> m_Samplers;
+        unsigned int m_VertexArray;
+        std::array<BufferBinding, 6> m_Buffers;
+        std::array<BufferRangeBinding, MAX_UNIFORM_BINDINGS> m_UniformRanges;
+
+        int m_Blend;
+        int m_ScissorTest;
+        unsigned int m_BlendEquation;
+        std::array<unsigned int, 4> m_BlendFunc;
+
+        std::array<int, 4> m_Viewport;
+        std::array<int, 4> m_Scissor;
+        std::array<float, 4> m_ClearColor;
+    };
+}
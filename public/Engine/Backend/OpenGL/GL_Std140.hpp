@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+
+#include <glm/glm.hpp>
+
+namespace engine::backend::ogl {
+    enum class GLStd140Type {
+        STD140_FLOAT,
+        STD140_INT,
+        STD140_UINT,
+        STD140_VEC2,
+        STD140_VEC3,
+        STD140_VEC4,
+        STD140_IVEC2,
+        STD140_IVEC3,
+        STD140_IVEC4,
+        STD140_MAT3,
+        STD140_MAT4
+    };
+
+    // base alignment and size of a single, non-array member
+    size_t GL_GetStd140Alignment(GLStd140Type type);
+
+    size_t GL_GetStd140Size(GLStd140Type type);
+
+    // computes member offsets of a layout(std140) uniform block in declaration order:
+    //   scalars align to 4, vec2 to 8, vec3 / vec4 to 16 (a vec3 leaves 4 bytes a following scalar can use)
+    //   array elements and matrix columns take 16 bytes each, whatever their type
+    //   structs align to 16 and are padded to a multiple of 16
+    // the result should match GLUniformBlockInfo::dataSize of the reflected block.
+    struct GLStd140Layout {
+        // returns the member's offset; arrayCount 0 adds a plain member, anything else an array of that size
+        size_t Add(GLStd140Type type, size_t arrayCount = 0);
+
+        // returns the struct's offset; members added until EndStruct belong to it. arrays of structs are one
+        // BeginStruct / EndStruct pair per element
+        size_t BeginStruct();
+
+        void EndStruct();
+
+        // size of the whole block, padded to 16 bytes
+        size_t GetSize() const;
+
+    protected:
+        size_t m_Offset = 0;
+        int m_StructDepth = 0;
+    };
+
+    // writes values at GLStd140Layout offsets. only writes, so it can target mapped, write-only memory such as
+    // GLBackend::AllocateUniforms. writes that do not fit in the destination are dropped.
+    struct GLStd140Writer {
+        GLStd140Writer(void *data, size_t size) : m_Data(static_cast<unsigned char *>(data)), m_Size(size) {}
+
+        void Set(size_t offset, float val);
+
+        void Set(size_t offset, int val);
+
+        void Set(size_t offset, unsigned int val);
+
+        void Set(size_t offset, const glm::vec2 &val);
+
+        void Set(size_t offset, const glm::vec3 &val);
+
+        void Set(size_t offset, const glm::vec4 &val);
+
+        void Set(size_t offset, const glm::ivec2 &val);
+
+        void Set(size_t offset, const glm::ivec3 &val);
+
+        void Set(size_t offset, const glm::ivec4 &val);
+
+        // columns are padded to vec4
+        void Set(size_t offset, const glm::mat3 &val);
+
+        void Set(size_t offset, const glm::mat4 &val);
+
+        // elements are written with a 16-byte stride
+        void SetArray(size_t offset, std::span<const float> values);
+
+        void SetArray(size_t offset, std::span<const int> values);
+
+        void SetArray(size_t offset, std::span<const glm::vec2> values);
+
+        void SetArray(size_t offset, std::span<const glm::vec3> values);
+
+        void SetArray(size_t offset, std::span<const glm::vec4> values);
+
+        void SetArray(size_t offset, std::span<const glm::mat4> values);
+
+    protected:
+        void Write(size_t offset, const void *data, size_t size);
+
+        template<typename T>
+        void WriteStrided(size_t offset, std::span<const T> values, size_t stride);
+
+        unsigned char *m_Data;
+        size_t m_Size;
+    };
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace engine::backend::ogl {
+    struct GLBackend;
+
+    struct GLStreamAllocation {
+        void *data = nullptr;
+        size_t offset = 0;
+        size_t size = 0;
+
+        bool IsValid() const {
+            return data != nullptr;
+        }
+    };
+
+    // ring of frame-sized regions for per-frame data. each region is guarded by a fence, so the CPU writes
+    // straight into mapped memory that the GPU is guaranteed to be done with.
+    // uses a persistent, coherent mapping (glBufferStorage) when available and falls back to unsynchronized
+    // glMapBufferRange calls per allocation otherwise (GLES).
+    struct GLStreamBuffer {
+        static constexpr int MAX_REGIONS = 4;
+        // longest AdvanceRegion waits for a region fence before reusing the region anyway
+        static constexpr uint64_t MAX_FENCE_WAIT_NS = 2000000000;
+
+        GLStreamBuffer(GLBackend *backend, unsigned int target, size_t regionSize, int regionCount = 3);
+
+        ~GLStreamBuffer();
+
+        bool Create();
+
+        void Destroy();
+
+        // reserves bytes in the current frame's region; the returned memory is write-only.
+        // returns an invalid allocation if the request does not fit in a single region. without a persistent
+        // mapping the allocation stays mapped until Commit and the buffer cannot be mapped twice, so only one
+        // allocation may be open at a time; Allocate fails while another one is not committed yet.
+        GLStreamAllocation Allocate(size_t size, size_t alignment);
+
+        // must be called once the allocation has been written and before anything draws from it
+        void Commit(const GLStreamAllocation &allocation);
+
+        // counts the switches from one region to the next
+        uint64_t GetEpoch() const {
+            return m_Epoch;
+        }
+
+        // whether data allocated at the given epoch has not been handed out again yet
+        bool IsIntact(uint64_t epoch) const {
+            return m_Epoch - epoch < static_cast<uint64_t>(m_RegionCount);
+        }
+
+        // fences the region holding offset again, so commands issued after it was left (e.g. a copy out of it)
+        // complete before the region is handed out again
+        void Refence(size_t offset);
+
+        unsigned int GetHandle() const {
+            return m_Handle;
+        }
+
+        size_t GetRegionSize() const {
+            return m_RegionSize;
+        }
+
+        bool IsPersistent() const {
+            return m_Persistent;
+        }
+
+    protected:
+        // fences the current region and moves to the next one, waiting for the GPU if it still reads from it
+        void AdvanceRegion();
+
+        GLBackend *m_Backend;
+        unsigned int m_Target;
+        unsigned int m_Handle = 0;
+        size_t m_RegionSize;
+        int m_RegionCount;
+
+        bool m_Persistent = false;
+        unsigned char *m_Mapped = nullptr;
+        // an uncommitted allocation holds the mapping; non-persistent path only
+        bool m_MappingOpen = false;
+
+        int m_Region = 0;
+        size_t m_RegionOffset = 0;
+        uint64_t m_FrameIndex = 0;
+        uint64_t m_Epoch = 0;
+        std::array<void *, MAX_REGIONS> m_Fences{};
+    };
+}
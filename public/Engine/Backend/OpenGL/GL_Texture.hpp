@@ -1,27 +1,99 @@
 #pragma once
 
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <span>
+
 #include <Engine/Core/Runtime/Graphics/ITexture.hpp>
+#include <Engine/Backend/OpenGL/GL_SamplerCache.hpp>
+#include <Engine/Backend/OpenGL/GL_SlabPool.hpp>
+#include <Engine/Backend/OpenGL/GL_TextureFormat.hpp>
 
 namespace engine::backend::ogl {
-    struct GLTexture : public core::runtime::graphics::ITexture {
-        GLTexture() : m_TexHandle(-1) {}
+    struct GLBackend;
+
+    enum class GLTextureResidency {
+        RESIDENCY_NONE,
+        // storage exists, contents are still being streamed
+        RESIDENCY_STREAMING,
+        RESIDENCY_RESIDENT
+    };
+
+    struct GLTexture : public core::runtime::graphics::ITexture, public GLPooled<GLTexture> {
+        explicit GLTexture(GLBackend *backend) : m_Backend(backend), m_TexHandle(-1), m_Size{0, 0} {}
 
         bool Create(const core::runtime::graphics::Bitmap &bitmap) override;
 
+        // mipLevels == 0 allocates the full chain; levels below the base are generated with glGenerateMipmap
+        bool Create(const core::runtime::graphics::Bitmap &bitmap, int mipLevels);
+
+        // allocates storage and streams the contents through the backend's GLTextureStreamer instead of
+        // uploading on the calling frame; the texture samples undefined contents until it is resident
+        bool CreateAsync(std::shared_ptr<const core::runtime::graphics::Bitmap> bitmap, int mipLevels = 1);
+
+        // creates and fills the texture on one of the backend's shared-context workers (CreateAsync without
+        // workers); it has no handle and binds nothing until it is resident
+        bool CreateOnWorker(std::shared_ptr<const core::runtime::graphics::Bitmap> bitmap, int mipLevels = 1);
+
+        // uploads pre-compressed mip levels (largest first) as-is; fails if the context lacks the format
+        bool CreateCompressed(unsigned int internalFormat, std::span<const GLTextureLevel> levels);
+
+        // memory-maps a KTX2 or DDS file and hands its levels straight to the driver
+        bool CreateFromFile(const std::filesystem::path &path);
+
+        // allocates RGBA8 storage with undefined contents; immutable where glTexStorage2D is available
+        bool Allocate(core::math::Vector2 size, int mipLevels = 1);
+
+        // fills every level below the base from the base level
+        void GenerateMipmaps();
+
+        // sampling state; shared sampler objects from the backend's cache where supported, otherwise
+        // applied as texture parameters. kept across re-creation.
+        void SetSampler(const GLSamplerDesc &desc);
+
+        const GLSamplerDesc &GetSampler() const {
+            return m_SamplerDesc;
+        }
+
+        int GetMipLevels() const {
+            return m_MipLevels;
+        }
+
         void Destroy() override;
 
         core::runtime::graphics::Bitmap Download() override;
 
+        // non-blocking readback of an RGBA8 level; fulfilled by the backend a frame or two later
+        std::future<core::runtime::graphics::Bitmap> DownloadAsync(int level = 0);
+
         core::math::Vector2 GetSize() override;
 
         void Bind(int samplerSlot) override;
 
         void Unbind() override;
 
+        GLTextureResidency GetResidency() const {
+            return m_Residency;
+        }
+
+        bool IsResident() const {
+            return m_Residency == GLTextureResidency::RESIDENCY_RESIDENT;
+        }
+
         unsigned int GetHandle() const {
             return m_TexHandle;
         };
     protected:
+        friend struct GLTextureStreamer;
+
+        GLBackend *m_Backend;
         unsigned int m_TexHandle;
+        core::math::Vector2 m_Size;
+        unsigned int m_InternalFormat = 0;
+        int m_MipLevels = 1;
+        GLSamplerDesc m_SamplerDesc;
+        unsigned int m_Sampler = 0;
+        GLTextureResidency m_Residency = GLTextureResidency::RESIDENCY_NONE;
     };
-}
\ No newline at end of file
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+
+#include <Engine/Core/Runtime/Graphics/ITexture.hpp>
+
+namespace engine::backend::ogl {
+    struct GLBackend;
+
+    // GL_TEXTURE_2D_ARRAY of equally sized RGBA8 layers, filled one image at a time. storage starts with a few
+    // layers and doubles as they fill up, and the capacity is capped by MAX_BYTES, so large layer sizes get
+    // few layers instead of committing the whole capacity up front.
+    struct GLTextureArray {
+        static constexpr int INITIAL_LAYERS = 4;
+        static constexpr size_t MAX_BYTES = 64 * 1024 * 1024;
+
+        GLTextureArray(GLBackend *backend, int width, int height, int layerCapacity);
+
+        ~GLTextureArray();
+
+        bool Create();
+
+        void Destroy();
+
+        // returns the layer the image landed in, or -1 if the array is full or the size does not match
+        int AddLayer(const core::runtime::graphics::Bitmap &bitmap);
+
+        void Bind(int samplerSlot);
+
+        bool IsFull() const {
+            return m_LayerCount >= m_LayerCapacity;
+        }
+
+        int GetWidth() const {
+            return m_Width;
+        }
+
+        int GetHeight() const {
+            return m_Height;
+        }
+
+        int GetLayerCount() const {
+            return m_LayerCount;
+        }
+
+        unsigned int GetHandle() const {
+            return m_TexHandle;
+        }
+
+    protected:
+        // a new texture with storage for the given number of layers, bound to GL_TEXTURE_2D_ARRAY
+        unsigned int CreateStorage(int layers);
+
+        // moves the filled layers into larger storage; the old texture goes through the deletion queue
+        bool Grow(int layers);
+
+        GLBackend *m_Backend;
+        unsigned int m_TexHandle = 0;
+        // read framebuffer for copying layers without glCopyImageSubData
+        unsigned int m_CopyFramebuffer = 0;
+        int m_Width;
+        int m_Height;
+        int m_LayerCapacity;
+        int m_AllocatedLayers = 0;
+        int m_LayerCount = 0;
+    };
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <Engine/Core/Runtime/Graphics/ITexture.hpp>
+#include <Engine/Backend/OpenGL/GL_RectAllocator.hpp>
+
+namespace engine::backend::ogl {
+    struct GLBackend;
+
+    struct GLAtlasHandle {
+        uint32_t index = UINT32_MAX;
+
+        bool IsValid() const {
+            return index != UINT32_MAX;
+        }
+    };
+
+    // where an atlas entry currently lives; only valid until the next Defragment()
+    struct GLSubTexture {
+        unsigned int texture = 0;
+        int page = -1;
+        // texel rectangle of the image inside the page, without padding
+        GLRect rect;
+        // (u0, v0, u1, v1)
+        glm::vec4 uvRect{0.f, 0.f, 0.f, 0.f};
+
+        bool IsValid() const {
+            return page >= 0;
+        }
+    };
+
+    // packs many small RGBA8 bitmaps (icons, glyphs, ...) into a few large GL_TEXTURE_2D pages, so they can be
+    // drawn without rebinding textures. each image gets a border of extruded edge texels so linear filtering
+    // never samples a neighbour.
+    struct GLTextureAtlas {
+        static constexpr int PADDING = 1;
+
+        explicit GLTextureAtlas(GLBackend *backend, int pageSize = 2048);
+
+        ~GLTextureAtlas();
+
+        void Destroy();
+
+        // returns an invalid handle if the bitmap is empty or larger than a page
+        GLAtlasHandle Add(const core::runtime::graphics::Bitmap &bitmap);
+
+        // the region becomes available to later Add calls; pages are only released by Defragment()
+        void Remove(GLAtlasHandle handle);
+
+        GLSubTexture Get(GLAtlasHandle handle) const;
+
+        // repacks every live image into as few pages as possible with GPU-side copies. handles stay valid, but
+        // sub-textures fetched earlier are stale; GetGeneration() changes whenever that happens.
+        bool Defragment();
+
+        uint32_t GetGeneration() const {
+            return m_Generation;
+        }
+
+        size_t GetPageCount() const {
+            return m_Pages.size();
+        }
+
+        void BindPage(int page, int samplerSlot);
+
+    protected:
+        struct Page {
+            unsigned int texture = 0;
+            GLRectAllocator allocator;
+        };
+
+        struct Entry {
+            int page;
+            // includes the padding border
+            GLRect rect;
+            bool alive;
+        };
+
+        int CreatePage();
+
+        void DestroyPage(Page &page);
+
+        // copies a padded region between pages on the GPU
+        void CopyRegion(const Page &source, const GLRect &sourceRect, const Page &destination, const GLRect &destinationRect);
+
+        GLBackend *m_Backend;
+        int m_PageSize;
+        uint32_t m_Generation = 0;
+        unsigned int m_CopyFramebuffer = 0;
+        std::vector<Page> m_Pages;
+        std::vector<Entry> m_Entries;
+        std::vector<uint32_t> m_FreeEntrySlots;
+        std::vector<core::runtime::graphics::Color> m_UploadScratch;
+    };
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include <Engine/Backend/OpenGL/GL_TextureFormat.hpp>
+
+namespace engine::backend::ogl {
+    // a parsed texture file; the levels point into the memory passed to the parser
+    struct GLTextureContainer {
+        unsigned int internalFormat = 0;
+        int width = 0;
+        int height = 0;
+        // largest first
+        std::vector<GLTextureLevel> levels;
+    };
+
+    // KTX2 without supercompression; only the first layer / face of 2D textures is used
+    bool GL_ParseKTX2(std::span<const unsigned char> data, GLTextureContainer &container);
+
+    // legacy FourCC (DXT1/3/5, ATI1/2, BC4U/BC5U) and DX10-extended headers
+    bool GL_ParseDDS(std::span<const unsigned char> data, GLTextureContainer &container);
+
+    // picks the parser from the file magic
+    bool GL_ParseTextureContainer(std::span<const unsigned char> data, GLTextureContainer &container);
+}
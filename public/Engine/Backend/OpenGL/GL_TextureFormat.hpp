@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+
+namespace engine::backend::ogl {
+    enum class GLCompressionFamily {
+        COMPRESSION_NONE,
+        // BC1-BC3
+        COMPRESSION_S3TC,
+        // BC4-BC5
+        COMPRESSION_RGTC,
+        // BC6H-BC7
+        COMPRESSION_BPTC,
+        // ETC2 / EAC
+        COMPRESSION_ETC2,
+        // ASTC LDR
+        COMPRESSION_ASTC
+    };
+
+    struct GLCompressedFormatInfo {
+        GLCompressionFamily family = GLCompressionFamily::COMPRESSION_NONE;
+        int blockWidth = 0;
+        int blockHeight = 0;
+        int blockBytes = 0;
+
+        bool IsValid() const {
+            return family != GLCompressionFamily::COMPRESSION_NONE;
+        }
+    };
+
+    // one mip level of a texture; data is not owned
+    struct GLTextureLevel {
+        const void *data = nullptr;
+        size_t size = 0;
+        int width = 0;
+        int height = 0;
+    };
+
+    // block layout of a compressed GL internal format; invalid for formats this backend does not know
+    GLCompressedFormatInfo GL_GetCompressedFormatInfo(unsigned int internalFormat);
+
+    // bytes occupied by a width x height image in the given compressed format, 0 if the format is unknown
+    size_t GL_GetCompressedImageSize(unsigned int internalFormat, int width, int height);
+
+    // levels of a complete mip chain for a width x height image
+    int GL_GetFullMipCount(int width, int height);
+}
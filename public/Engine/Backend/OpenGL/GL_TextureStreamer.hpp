@@ -0,0 +1,123 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <Engine/Core/Runtime/Graphics/ITexture.hpp>
+
+namespace engine::backend::ogl {
+    struct GLBackend;
+    struct GLTexture;
+
+    // produces rows [firstRow, firstRow + rowCount) of an RGBA8 image into destination (tightly packed).
+    // runs on a worker thread, so it must not touch GL or anything owned by the render thread.
+    using GLTextureSource = std::function<bool(int firstRow, int rowCount, core::runtime::graphics::Color *destination)>;
+
+    // streams texture contents through a pool of GL_PIXEL_UNPACK_BUFFER staging buffers. worker threads fill
+    // mapped staging memory while the GL thread only issues glTexSubImage2D from the buffers and fences them.
+    // textures are uploaded in row bands, at most GetFrameBudget() bytes being staged per frame, and become
+    // resident once the GPU has consumed the last band.
+    struct GLTextureStreamer {
+        GLTextureStreamer(GLBackend *backend, size_t stagingBufferSize = 4 * 1024 * 1024, int stagingBufferCount = 4,
+                          int workerCount = 2);
+
+        ~GLTextureStreamer();
+
+        bool Create();
+
+        // stops the workers and releases every staging buffer; pending uploads are dropped
+        void Destroy();
+
+        // the texture must have storage (GLTexture::Allocate) of the given size and stay alive until it is
+        // resident or cancelled
+        bool Enqueue(GLTexture *texture, GLTextureSource source);
+
+        bool Enqueue(GLTexture *texture, std::shared_ptr<const core::runtime::graphics::Bitmap> bitmap);
+
+        // drops every pending upload into the texture; bands already on a worker finish into their staging buffer
+        void Cancel(GLTexture *texture);
+
+        // GL thread: submits finished bands, recycles staging buffers, marks textures resident and hands new
+        // bands to the workers. called by GLBackend::EndFrame.
+        void Update();
+
+        void SetFrameBudget(size_t bytes) {
+            m_FrameBudget = bytes;
+        }
+
+        size_t GetFrameBudget() const {
+            return m_FrameBudget;
+        }
+
+        // uploads that are not resident yet
+        size_t GetPendingCount() const {
+            return m_Requests.size();
+        }
+
+    protected:
+        struct Request {
+            // GLTexture::Destroy cancels the request while the texture is streaming, which clears this
+            GLTexture *texture;
+            GLTextureSource source;
+            int width;
+            int height;
+            int rowsPerBand;
+            int nextRow = 0;
+            int bandsInFlight = 0;
+            bool cancelled = false;
+            // set once every band has been submitted; the texture is resident when it signals
+            void *fence = nullptr;
+        };
+
+        struct StagingBuffer {
+            unsigned int handle = 0;
+            void *mapped = nullptr;
+            // guards the GPU read of the last band uploaded from this buffer
+            void *fence = nullptr;
+            bool busy = false;
+        };
+
+        struct Band {
+            Request *request;
+            int staging;
+            void *destination;
+            int firstRow;
+            int rowCount;
+            bool succeeded;
+        };
+
+        void WorkerMain();
+
+        // non-blocking; true once the fence has signaled (or if there is none)
+        static bool IsSignaled(void *fence);
+
+        int AcquireStagingBuffer();
+
+        void SubmitBand(const Band &band);
+
+        GLBackend *m_Backend;
+        size_t m_StagingBufferSize;
+        int m_StagingBufferCount;
+        int m_WorkerCount;
+        size_t m_FrameBudget = 8 * 1024 * 1024;
+        bool m_Persistent = false;
+
+        std::vector<StagingBuffer> m_StagingBuffers;
+        std::vector<std::unique_ptr<Request>> m_Requests;
+
+        // shared with the workers
+        std::mutex m_Mutex;
+        std::condition_variable m_Condition;
+        std::deque<Band> m_PendingBands;
+        std::vector<Band> m_FinishedBands;
+        bool m_Stopping = false;
+        std::vector<std::thread> m_Workers;
+    };
+}
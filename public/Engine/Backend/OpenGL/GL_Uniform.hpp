@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace engine::backend::ogl {
+    // lightweight reference to an entry of a program's reflected uniform table.
+    // handles are invalidated when the owning program is re-linked or destroyed.
+    struct GLUniformHandle {
+        int index = -1;
+
+        bool IsValid() const {
+            return index >= 0;
+        }
+    };
+
+    struct GLUniformInfo {
+        std::string name;
+        int location = -1;
+        unsigned int type = 0;
+        int arraySize = 1;
+        size_t elementSize = 0;
+
+        // where the last uploaded value lives inside the program's shadow storage
+        size_t shadowOffset = 0;
+        bool shadowValid = false;
+    };
+
+    // a uniform block of a linked program; binding is the uniform buffer binding point it reads from
+    struct GLUniformBlockInfo {
+        std::string name;
+        unsigned int index = 0;
+        unsigned int binding = 0;
+        size_t dataSize = 0;
+    };
+
+    // allows lookups with std::string_view keys without allocating a temporary std::string
+    struct GLUniformNameHash {
+        using is_transparent = void;
+
+        size_t operator()(std::string_view name) const {
+            return std::hash<std::string_view>{}(name);
+        }
+    };
+
+    using GLUniformNameMap = std::unordered_map<std::string, int, GLUniformNameHash, std::equal_to<>>;
+}
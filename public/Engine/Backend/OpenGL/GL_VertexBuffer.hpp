@@ -1,9 +1,49 @@
 #pragma once
 
+#include <cstdint>
+#include <future>
+#include <span>
+
 #include <Engine/Core/Runtime/Graphics/IVertexBuffer.hpp>
+#include <Engine/Backend/OpenGL/GL_InstanceData.hpp>
+#include <Engine/Backend/OpenGL/GL_SlabPool.hpp>
+#include <Engine/Backend/OpenGL/GL_StreamBuffer.hpp>
+#include <Engine/Backend/OpenGL/GL_VertexLayout.hpp>
 
 namespace engine::backend::ogl {
-    struct GLVertexBuffer : public core::runtime::graphics::IVertexBuffer {
+    struct GLBackend;
+
+    // read-only mapping of a vertex buffer's contents; the buffer must not be drawn from or updated until the
+    // view is released
+    struct GLVertexReadView {
+        GLVertexReadView() = default;
+
+        GLVertexReadView(GLVertexReadView &&other) noexcept;
+
+        GLVertexReadView &operator=(GLVertexReadView &&other) noexcept;
+
+        ~GLVertexReadView();
+
+        std::span<const core::runtime::graphics::Vertex> GetVertices() const {
+            return m_Vertices;
+        }
+
+        bool IsValid() const {
+            return m_Buffer != 0;
+        }
+
+        void Release();
+
+    protected:
+        friend struct GLVertexBuffer;
+
+        unsigned int m_Buffer = 0;
+        std::span<const core::runtime::graphics::Vertex> m_Vertices;
+    };
+
+    struct GLVertexBuffer : public core::runtime::graphics::IVertexBuffer, public GLPooled<GLVertexBuffer> {
+        explicit GLVertexBuffer(GLBackend *backend) : m_Backend(backend) {}
+
         bool Create() override;
 
         void Destroy() override;
@@ -20,16 +60,154 @@ namespace engine::backend::ogl {
                 core::runtime::graphics::BufferUsageHint usage
         ) override;
 
+        // encodes and uploads the vertices into a fresh buffer on one of the backend's shared-context workers;
+        // the buffer keeps drawing its previous contents until the new ones land. falls back to a static
+        // Upload without workers. a newer call supersedes a pending one.
+        bool UploadOnWorker(std::vector<core::runtime::graphics::Vertex> data, core::runtime::graphics::PrimitiveType type);
+
         size_t Size() override;
 
         core::runtime::graphics::PrimitiveType GetPrimitiveType() override;
 
+        // blocking copy of the current vertices (glGetBufferSubData on desktop GL, a read mapping on GLES)
         std::vector<core::runtime::graphics::Vertex> Download() override;
+
+        // maps the current vertices for reading without copying them; invalid for packed layouts and for vertices
+        // streamed this frame, which still live in the backend's stream ring (streamed on an earlier frame, they
+        // are moved into the buffer's own storage first)
+        GLVertexReadView MapRead();
+
+        // copies the vertices on the GPU and fulfils the future from GLBackend::EndFrame once the copy has landed;
+        // meant for results produced by transform feedback or compute shaders without stalling the pipeline
+        std::future<std::vector<core::runtime::graphics::Vertex>> DownloadAsync();
+
+        // streaming path: reserves room for the given number of vertices in the backend's stream ring and
+        // returns write-only memory to fill in place. call CommitStream before the next Draw, and before
+        // mapping another buffer: without persistent mapping the ring holds one open mapping at a time.
+        // returns nullptr if the request does not fit in a frame region, or if a packed layout is set.
+        // the ring is reused a few frames later; a buffer still drawn after the frame it was streamed in moves
+        // its vertices into its own storage on that draw.
+        core::runtime::graphics::Vertex *MapStream(size_t vertexCount, core::runtime::graphics::PrimitiveType type);
+
+        // publishes up to the mapped number of vertices
+        void CommitStream(size_t vertexCount);
+
+        // overwrites part of the uploaded vertices in place, growing the vertex count if the range ends past it.
+        // storage is only reallocated (geometrically) when the range exceeds the current capacity.
+        // not available while the buffer streams through the backend's ring.
+        bool UpdateRange(size_t firstVertex, std::span<const core::runtime::graphics::Vertex> data);
+
+        // index data lives in an element buffer attached to the VAO; once set, Draw() uses glDrawElements.
+        // indices are relative to the first vertex of the last vertex upload.
+        void UploadIndices(std::span<const uint16_t> indices, core::runtime::graphics::BufferUsageHint usage);
+
+        void UploadIndices(std::span<const uint32_t> indices, core::runtime::graphics::BufferUsageHint usage);
+
+        void ClearIndices();
+
+        // collapses identical vertices and uploads the unique ones together with a matching index list
+        // (16-bit when the unique vertex count allows it).
+        void UploadDeduplicated(
+                const std::vector<core::runtime::graphics::Vertex> &data,
+                core::runtime::graphics::PrimitiveType type,
+                core::runtime::graphics::BufferUsageHint usage
+        );
+
+        // draws a sub-range of the index buffer, offsetting every index by baseVertex
+        void DrawIndexedRange(size_t firstIndex, size_t indexCount, int baseVertex);
+
+        // selects how vertices are stored; uploads encode from Vertex and Download decodes back. the current
+        // contents are dropped when the layout changes. shaders read snorm16 positions in [-1, 1] and have
+        // to multiply them by the layout's positionScale.
+        void SetLayout(const GLVertexLayout &layout);
+
+        const GLVertexLayout &GetLayout() const {
+            return m_Layout;
+        }
+
+        // declares the per-instance attributes (glVertexAttribDivisor 1) read from instance data uploads
+        void SetInstanceLayout(std::span<const GLInstanceAttribute> attributes, size_t stride);
+
+        // streams this frame's instance records through the backend's ring; the data must match the layout
+        bool UploadInstances(const void *data, size_t instanceCount);
+
+        bool UploadInstances(std::span<const GLInstanceData> instances);
+
+        // draws every vertex (or index) once per uploaded instance
+        void DrawInstanced();
+
+        size_t GetIndexCount() const {
+            return m_IndexCount;
+        }
+
+        // builds an index list referencing the unique vertices of the input
+        static void BuildIndexList(
+                const std::vector<core::runtime::graphics::Vertex> &data,
+                std::vector<core::runtime::graphics::Vertex> &uniqueVertices,
+                std::vector<uint32_t> &indices
+        );
     protected:
-        unsigned int m_VaoHandle;
-        unsigned int m_VboHandle;
-        size_t m_VertexCount;
-        core::runtime::graphics::BufferUsageHint m_UsageHint;
-        core::runtime::graphics::PrimitiveType m_PrimType;
+        // points the instance attributes at byteOffset inside the stream ring
+        void ConfigureInstanceAttributes(unsigned int sourceBuffer, size_t byteOffset);
+
+        void UploadIndexData(const void *data, size_t count, unsigned int indexType,
+                             core::runtime::graphics::BufferUsageHint usage);
+
+        // points the vertex attributes at the given buffer; no-op if they already do
+        void ConfigureAttributes(unsigned int sourceBuffer);
+
+        // byte offset of the first current vertex inside m_AttributeSource
+        size_t GetSourceOffset() const {
+            return static_cast<size_t>(m_FirstVertex) * m_Layout.stride;
+        }
+
+        // reserves vertexCount vertices of the current layout in the stream ring
+        void *MapStreamBytes(size_t vertexCount, core::runtime::graphics::PrimitiveType type);
+
+        // copies or encodes the vertices into destination according to the layout
+        void WriteVertices(std::span<const core::runtime::graphics::Vertex> data, void *destination) const;
+
+        // returns the vertices in buffer format; packed layouts are encoded into m_EncodeScratch
+        const void *PrepareVertices(std::span<const core::runtime::graphics::Vertex> data);
+
+        // makes sure the VBO can hold at least the given number of bytes, keeping the first preserveBytes
+        void ReserveStorage(size_t bytes, size_t preserveBytes);
+
+        // called before vertices are read; copies vertices streamed on an earlier frame out of the ring into
+        // the VBO. returns false if the ring has already overwritten them.
+        bool ResolveStreamedVertices();
+
+        GLBackend *m_Backend;
+        unsigned int m_VaoHandle = 0;
+        unsigned int m_VboHandle = 0;
+        size_t m_VertexCount = 0;
+        core::runtime::graphics::BufferUsageHint m_UsageHint = core::runtime::graphics::BufferUsageHint::BUFFER_USAGE_HINT_STATIC;
+        core::runtime::graphics::PrimitiveType m_PrimType = core::runtime::graphics::PrimitiveType::PRIMITIVE_TYPE_TRIANGLES;
+
+        size_t m_Capacity = 0;
+
+        GLVertexLayout m_Layout = GLVertexLayout::Standard();
+        bool m_PackedLayout = false;
+        std::vector<unsigned char> m_EncodeScratch;
+
+        // buffer the VAO attributes currently point at; either our VBO or the backend's stream ring,
+        // in which case the vertices start at m_FirstVertex
+        unsigned int m_AttributeSource = 0;
+        int m_FirstVertex = 0;
+        GLStreamAllocation m_StreamAllocation;
+        // frame and ring epoch the streamed vertices were written in
+        uint64_t m_StreamFrame = 0;
+        uint64_t m_StreamEpoch = 0;
+
+        std::vector<GLInstanceAttribute> m_InstanceLayout;
+        size_t m_InstanceStride = 0;
+        size_t m_InstanceCount = 0;
+        int m_BaseInstance = 0;
+        unsigned int m_InstanceSource = 0;
+        size_t m_InstanceSourceOffset = 0;
+
+        unsigned int m_EboHandle = 0;
+        size_t m_IndexCount = 0;
+        unsigned int m_IndexType = 0;
     };
 }
\ No newline at end of file
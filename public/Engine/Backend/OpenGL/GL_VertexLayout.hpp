@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <Engine/Core/Runtime/Graphics/IVertexBuffer.hpp>
+
+namespace engine::backend::ogl {
+    // which Vertex member an element is taken from; also selects the attribute location (0-3), so shaders
+    // written against the standard layout keep working with packed ones
+    enum class GLVertexSemantic : uint8_t {
+        VERTEX_SEMANTIC_POSITION,
+        VERTEX_SEMANTIC_UV,
+        VERTEX_SEMANTIC_NORMAL,
+        VERTEX_SEMANTIC_COLOR
+    };
+
+    enum class GLVertexEncoding : uint8_t {
+        VERTEX_ENCODING_FLOAT32,
+        // GL_HALF_FLOAT; 3-component semantics are padded to 4 to keep elements 4-byte aligned
+        VERTEX_ENCODING_HALF_FLOAT,
+        // normalized GL_SHORT; positions are divided by the layout's positionScale first
+        VERTEX_ENCODING_SNORM16,
+        // normalized GL_UNSIGNED_BYTE, always 4 components
+        VERTEX_ENCODING_UNORM8,
+        // normalized GL_INT_2_10_10_10_REV; meant for normals and tangents
+        VERTEX_ENCODING_INT_2_10_10_10_REV
+    };
+
+    struct GLVertexElement {
+        GLVertexSemantic semantic;
+        GLVertexEncoding encoding;
+        uint32_t offset;
+    };
+
+    // describes how vertices are laid out in a buffer. semantics that are left out are disabled on the VAO,
+    // so the shader reads the current generic attribute value instead (0, 0, 0, 1 unless changed).
+    struct GLVertexLayout {
+        // the layout of core::runtime::graphics::Vertex itself (36 bytes)
+        static GLVertexLayout Standard();
+
+        // snorm16 position, half-float uv, 2_10_10_10 normal and unorm8 color (20 bytes)
+        static GLVertexLayout CompactMesh(float positionScale);
+
+        // float3 position, half-float uv and unorm8 color, no normal (20 bytes)
+        static GLVertexLayout CompactUI();
+
+        // appends an element after the previous one; a semantic may only appear once
+        GLVertexLayout &Add(GLVertexSemantic semantic, GLVertexEncoding encoding);
+
+        const GLVertexElement *Find(GLVertexSemantic semantic) const;
+
+        // true if vertices can be copied as-is instead of being encoded
+        bool IsStandard() const;
+
+        bool operator==(const GLVertexLayout &other) const;
+
+        std::vector<GLVertexElement> elements;
+        uint32_t stride = 0;
+
+        // snorm16 positions cover [-positionScale, positionScale]; the vertex shader multiplies the attribute by it
+        float positionScale = 1.0f;
+    };
+
+    // number of components and byte size of an element as stored in the buffer
+    void GL_GetVertexElementFormat(GLVertexSemantic semantic, GLVertexEncoding encoding, int &components, uint32_t &size);
+
+    // sets up the attribute pointers for the bound VAO, reading from the bound GL_ARRAY_BUFFER at byteOffset
+    void GL_ConfigureVertexLayout(const GLVertexLayout &layout, size_t byteOffset = 0);
+
+    // packs vertices into layout.stride * vertices.size() bytes at destination (SSE2 when available)
+    void GL_EncodeVertices(const GLVertexLayout &layout, std::span<const core::runtime::graphics::Vertex> vertices,
+                           void *destination);
+
+    // the inverse of GL_EncodeVertices; members without an element are zeroed (color becomes opaque white)
+    void GL_DecodeVertices(const GLVertexLayout &layout, const void *source,
+                           std::span<core::runtime::graphics::Vertex> vertices);
+
+    uint16_t GL_FloatToHalf(float value);
+
+    float GL_HalfToFloat(uint16_t value);
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace engine::backend::ogl {
+    struct GLBackend;
+
+    // a context in the backend context's share group, provided by the platform layer. bind() is called on the
+    // worker thread that owns the context and returns whether it became current there.
+    struct GLWorkerContext {
+        std::function<bool()> bind;
+        std::function<void()> release;
+    };
+
+    // runs on a worker thread with a shared context current. may only use raw GL calls, never the state cache.
+    using GLWorkerJob = std::function<void()>;
+
+    // runs on the GL thread once the job's commands are visible to the main context. when cancelled is set,
+    // the owner may already be gone: only release what the job created.
+    using GLWorkerCompletion = std::function<void(bool cancelled)>;
+
+    // threads with shared contexts that create and fill GL objects off the render thread. every finished job
+    // is fenced; Poll() makes the main context wait for the fence on the GPU (glWaitSync) and then runs the
+    // completion, so objects can be used right away without stalling the CPU.
+    struct GLWorkerPool {
+        explicit GLWorkerPool(GLBackend *backend) : m_Backend(backend) {}
+
+        ~GLWorkerPool();
+
+        // starts one thread per context
+        bool Create(std::vector<GLWorkerContext> contexts);
+
+        // GL thread: stops the workers; queued jobs are dropped and their completions run as cancelled
+        void Destroy();
+
+        // false until Create succeeded, or once every worker failed to bind its context
+        bool IsAvailable() const;
+
+        size_t GetWorkerCount() const {
+            return m_Workers.size();
+        }
+
+        // thread-safe; owner identifies the jobs for Cancel. fails if there are no workers.
+        bool Submit(const void *owner, GLWorkerJob job, GLWorkerCompletion completion = {});
+
+        // drops the owner's queued jobs and waits for the running ones; their completions run as cancelled
+        void Cancel(const void *owner);
+
+        // GL thread: hands finished jobs over to the main context. called by GLBackend::EndFrame.
+        void Poll();
+
+    protected:
+        struct Task {
+            const void *owner;
+            GLWorkerJob job;
+            GLWorkerCompletion completion;
+            void *fence = nullptr;
+            bool cancelled = false;
+        };
+
+        void WorkerMain(GLWorkerContext context);
+
+        GLBackend *m_Backend;
+
+        mutable std::mutex m_Mutex;
+        std::condition_variable m_Condition;
+        // signaled whenever a job finishes, for Cancel
+        std::condition_variable m_TaskFinished;
+        std::deque<std::shared_ptr<Task>> m_Queued;
+        std::vector<std::shared_ptr<Task>> m_Running;
+        std::deque<std::shared_ptr<Task>> m_Finished;
+        bool m_Stopping = false;
+        int m_LiveWorkers = 0;
+        std::vector<std::thread> m_Workers;
+    };
+}
@@ -1,11 +1,29 @@
 #pragma once
 
+#include <vector>
+
 #include <Engine/Core/Runtime/Graphics/IGraphicsContext.hpp>
+#include <Engine/Backend/OpenGL/GL_RenderTarget.hpp>
 #include <Engine/EGLHeader.hpp>
 
 namespace engine::platform::universal {
+    struct UEGLHeadlessDesc {
+        int width = 1024;
+        int height = 1024;
+        // use EGL_KHR_surfaceless_context when available instead of a pbuffer surface
+        bool allowSurfaceless = true;
+        // shared contexts handed to the backend's GLWorkerPool
+        int workerCount = 0;
+    };
+
+    // headless contexts are independent of each other: every one may be bound on its own thread at the same
+    // time (a context is only ever current on one thread). they render into an off-screen render target.
     struct UEGLContext : public core::runtime::graphics::IGraphicsContext {
-        UEGLContext(core::runtime::IWindow *win);
+        // workerCount shared contexts are handed to the backend's GLWorkerPool
+        UEGLContext(core::runtime::IWindow *win, int workerCount = 0);
+
+        // headless mode; prefers the Mesa surfaceless platform, so no display server is required
+        explicit UEGLContext(const UEGLHeadlessDesc &desc);
 
         virtual ~UEGLContext() = default;
 
@@ -23,11 +41,45 @@ namespace engine::platform::universal {
 
         core::runtime::IWindow *GetOwnerWindow() override;
 
+        bool IsHeadless() const {
+            return m_Window == nullptr;
+        }
+
+        // framebuffer of a headless context; null for windowed ones or before GetBackend()
+        backend::ogl::GLRenderTarget *GetRenderTarget() {
+            return m_RenderTarget.get();
+        }
+
+        // number of shared contexts handed to the backend's GLWorkerPool. Create() picks an EGL config that can
+        // back their surfaces, so this is refused once the context exists; prefer the constructor argument.
+        bool SetWorkerCount(int count);
+
     protected:
+        struct UEGLWorker {
+            EGLContext context;
+            EGLSurface surface;
+        };
+
+        bool CreateHeadless();
+
+        void CreateWorkers();
+
+        void DestroyWorkers();
+
         std::unique_ptr<core::runtime::graphics::IGraphicsBackend> m_Backend;
         core::runtime::IWindow *m_Window;
         EGLDisplay m_EGLDisplay;
         EGLSurface m_EGLSurface;
         EGLContext m_EGLContext;
+
+        UEGLHeadlessDesc m_HeadlessDesc;
+        EGLenum m_API = EGL_NONE;
+        EGLConfig m_EGLConfig = nullptr;
+        // EGL_CONTEXT_CLIENT_VERSION the context was created with, 0 for the driver default
+        EGLint m_ClientVersion = 0;
+
+        int m_WorkerCount = 0;
+        std::vector<UEGLWorker> m_Workers;
+        std::unique_ptr<backend::ogl::GLRenderTarget> m_RenderTarget;
     };
 }
\ No newline at end of file